@@ -0,0 +1,527 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+    #define _POSIX_C_SOURCE     199309L
+#endif
+
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <time.h>
+#endif
+
+#include "Codec.hpp"
+#include "CodecScan.h"
+
+#define PRINTF                  printf
+#define PUTS                    puts
+
+/**
+ * @brief biggest payload of benchmarks
+ */
+#define FRAME_MAX_PAYLOAD       (64UL * 1024UL)
+/**
+ * @brief size of stream that benchmarks use, fit biggest frame with noise
+ */
+#define FRAME_STREAM_SIZE       (2 * FRAME_MAX_PAYLOAD + 1024)
+/**
+ * @brief total bytes that each benchmark process
+ */
+#define FRAME_TOTAL_BYTES       (32UL * 1024UL * 1024UL)
+/**
+ * @brief limit number of frames for tiny payloads
+ */
+#define FRAME_MAX_FRAMES        (1024UL * 1024UL)
+/**
+ * @brief minimum number of frames for huge payloads
+ */
+#define FRAME_MIN_FRAMES        16
+/**
+ * @brief quick mode divide totals by this value
+ */
+#define QUICK_DIV               16
+
+/**
+ * @brief parameters of a benchmark
+ */
+struct Bench_Case {
+    uint32_t                Payload;
+    uint32_t                FrameLen;
+    uint32_t                Noise;          /**< noise bytes before each frame */
+    uint32_t                Frames;         /**< number of frames to process */
+};
+
+/**
+ * @brief Packet frame, C layers and C++ pipeline
+ */
+struct Bench_Packet {
+    using Frame = Packet;
+    using Pipeline = codec::packet::Codec;
+
+    static constexpr const char* Name = "Packet";
+    static constexpr const char* NameCpp = "Packet++";
+
+    static Codec_LayerImpl* baseLayer(void) {
+        return Packet_baseLayer();
+    }
+    static Codec_SyncFn sync(void) {
+        return Packet_sync;
+    }
+    static void init(Frame& frame, uint8_t* data, uint32_t size) {
+        Packet_init(&frame, data, size);
+    }
+    static uint32_t len(Frame& frame) {
+        return Packet_len(&frame);
+    }
+    static const uint8_t* data(const Frame& frame) {
+        return frame.Data;
+    }
+};
+/**
+ * @brief BasicFrame, C layers and C++ pipeline
+ */
+struct Bench_BasicFrame {
+    using Frame = BasicFrame;
+    using Pipeline = codec::basic_frame::Codec;
+
+    static constexpr const char* Name = "BasicFrame";
+    static constexpr const char* NameCpp = "BasicFrame++";
+
+    static Codec_LayerImpl* baseLayer(void) {
+        return BasicFrame_baseLayer();
+    }
+    static Codec_SyncFn sync(void) {
+        return NULL;
+    }
+    static void init(Frame& frame, uint8_t* data, uint32_t size) {
+        BasicFrame_init(&frame, data, size);
+    }
+    static uint32_t len(Frame& frame) {
+        return BasicFrame_len(&frame);
+    }
+    static const uint8_t* data(const Frame& frame) {
+        return frame.Data.Data;
+    }
+};
+
+static const uint32_t PAYLOADS[] = {
+    0, 16, 64, 256, 1024, 4096, FRAME_MAX_PAYLOAD,
+};
+static const uint32_t PAYLOADS_LEN = sizeof(PAYLOADS) / sizeof(PAYLOADS[0]);
+
+static uint8_t payloadBuff[FRAME_MAX_PAYLOAD];
+static uint8_t rxPayloadBuff[FRAME_MAX_PAYLOAD];
+static uint8_t streamBuff[FRAME_STREAM_SIZE];
+static uint8_t sampleBuff[FRAME_STREAM_SIZE];
+static uint8_t wireBuff[2][FRAME_MAX_PAYLOAD + 64];
+static uint32_t sampleLen;
+static uint32_t sampleFrames;
+
+static uint8_t csv = 0;
+static uint32_t quick = 1;
+static uint32_t failed = 0;
+
+double Bench_now(void);
+void Bench_report(const char* codec, const char* mode, uint32_t payload, uint32_t noise,
+                  uint64_t frames, uint64_t bytes, double elapsed);
+void Bench_fail(const char* codec, const char* mode, uint32_t payload, const char* reason);
+
+template <typename T>
+void Bench_run(uint32_t payload, uint32_t noise);
+
+int main(int argc, char* argv[])
+{
+    uint32_t p;
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0) {
+            // machine readable output
+            csv = 1;
+        }
+        else if (strcmp(argv[i], "--quick") == 0) {
+            quick = QUICK_DIV;
+        }
+        else {
+            PRINTF("usage: %s [--csv] [--quick]\n", argv[0]);
+            return 1;
+        }
+    }
+    for (p = 0; p < FRAME_MAX_PAYLOAD; p++) {
+        payloadBuff[p] = (uint8_t) (p * 7 + 1);
+    }
+
+    if (csv) {
+        PRINTF("# codec %s, scanner %s\n", CODEC_VER_STR, Codec_scanImpl());
+        PUTS("codec,mode,payload,noise,frames,bytes,seconds,mb_s,frames_s,ns_frame");
+    }
+    else {
+        PUTS("------- Start Codec C/C++ Benchmarks -------");
+        PRINTF("Codec: %s, Scanner: %s\n", CODEC_VER_STR, Codec_scanImpl());
+        PUTS("---- Packet ----");
+    }
+    for (p = 0; p < PAYLOADS_LEN; p++) {
+        Bench_run<Bench_Packet>(PAYLOADS[p], 0);
+    }
+    if (!csv) {
+        PUTS("---- BasicFrame ----");
+    }
+    for (p = 0; p < PAYLOADS_LEN; p++) {
+        Bench_run<Bench_BasicFrame>(PAYLOADS[p], 0);
+    }
+#if CODEC_DECODE_SYNC
+    if (!csv) {
+        PUTS("---- Packet, 64 B payload, 25% noise ----");
+    }
+    // noise bytes per frame for 25% of input
+    Bench_run<Bench_Packet>(64, (PACKET_HEADER_SIZE + PACKET_FOOTER_SIZE + 64) * 25 / 75);
+#endif
+
+    if (!csv) {
+        PRINTF("\nBenchmarks Ended, %u Failed\n", failed);
+    }
+    return failed != 0;
+}
+/**
+ * @brief print result of a benchmark, in human readable or csv format
+ *
+ * @param codec name of frame type
+ * @param mode name of benchmark
+ * @param payload payload size of frames
+ * @param noise noise bytes before each frame
+ * @param frames number of processed frames
+ * @param bytes number of processed bytes
+ * @param elapsed seconds
+ */
+void Bench_report(const char* codec, const char* mode, uint32_t payload, uint32_t noise,
+                  uint64_t frames, uint64_t bytes, double elapsed) {
+    double mbs = (double) bytes / elapsed / 1e6;
+    double fps = (double) frames / elapsed;
+    double ns = frames > 0 ? elapsed * 1e9 / (double) frames : 0;
+
+    if (csv) {
+        PRINTF("%s,%s,%u,%u,%llu,%llu,%.6f,%.3f,%.0f,%.1f\n", codec, mode, payload, noise,
+               (unsigned long long) frames, (unsigned long long) bytes, elapsed, mbs, fps, ns);
+    }
+    else {
+        PRINTF("%-12s %-14s %8u B noise %5u B: %10.2f MB/s %12.0f frames/s %10.1f ns/frame\n",
+               codec, mode, payload, noise, mbs, fps, ns);
+    }
+}
+/**
+ * @brief report a failed benchmark
+ */
+void Bench_fail(const char* codec, const char* mode, uint32_t payload, const char* reason) {
+    failed++;
+    if (csv) {
+        PRINTF("# %s,%s,%u failed: %s\n", codec, mode, payload, reason);
+    }
+    else {
+        PRINTF("%-12s %-14s %8u B: failed, %s\n", codec, mode, payload, reason);
+    }
+}
+/**
+ * @brief check C layers and C++ pipeline produce same bytes and decode each other frames
+ *
+ * @tparam T frame type
+ * @param bc
+ * @return uint8_t 0 if both paths are wire compatible
+ */
+template <typename T>
+static uint8_t Bench_wire(const Bench_Case& bc) {
+    typename T::Frame frame;
+    typename T::Frame rx;
+    Codec codec;
+
+    Codec_init(&codec, T::baseLayer());
+    T::init(frame, payloadBuff, bc.Payload);
+    if (T::Pipeline::frameSize(frame) != (Stream_LenType) bc.FrameLen) {
+        return 1;
+    }
+    memset(wireBuff, 0, sizeof(wireBuff));
+    if (Codec_encodeBuffer(&codec, &frame, wireBuff[0], bc.FrameLen) != Codec_Status_Done ||
+        T::Pipeline::encode(frame, wireBuff[1], bc.FrameLen) != Codec_Status_Done ||
+        memcmp(wireBuff[0], wireBuff[1], bc.FrameLen) != 0) {
+        return 2;
+    }
+    // C++ decode C bytes
+    T::init(rx, rxPayloadBuff, sizeof(rxPayloadBuff));
+    memset(rxPayloadBuff, 0, bc.Payload);
+    if (T::Pipeline::decode(rx, wireBuff[0], bc.FrameLen) != Codec_Status_Done ||
+        T::len(rx) != bc.FrameLen || memcmp(T::data(rx), payloadBuff, bc.Payload) != 0) {
+        return 3;
+    }
+    // C decode C++ bytes
+    T::init(rx, rxPayloadBuff, sizeof(rxPayloadBuff));
+    memset(rxPayloadBuff, 0, bc.Payload);
+    if (Codec_decodeBuffer(&codec, &rx, wireBuff[1], bc.FrameLen) != Codec_Status_Done ||
+        T::len(rx) != bc.FrameLen || memcmp(T::data(rx), payloadBuff, bc.Payload) != 0) {
+        return 4;
+    }
+    return 0;
+}
+/**
+ * @brief prepare sample of encoded frames with noise, as many frames that fit in stream
+ *
+ * @tparam T frame type
+ * @param bc
+ * @return uint8_t 0 if sample prepared
+ */
+template <typename T>
+static uint8_t Bench_sample(const Bench_Case& bc) {
+    typename T::Frame frame;
+    uint32_t unit = bc.FrameLen + bc.Noise;
+    uint32_t i;
+
+    sampleFrames = (uint32_t) (FRAME_STREAM_SIZE / unit);
+    if (sampleFrames > bc.Frames) {
+        sampleFrames = bc.Frames;
+    }
+    T::init(frame, payloadBuff, bc.Payload);
+    sampleLen = 0;
+    for (i = 0; i < sampleFrames; i++) {
+        memset(&sampleBuff[sampleLen], 0xFF, bc.Noise);
+        sampleLen += bc.Noise;
+        if (T::Pipeline::encode(frame, &sampleBuff[sampleLen], bc.FrameLen) != Codec_Status_Done) {
+            return 1;
+        }
+        sampleLen += bc.FrameLen;
+    }
+    return 0;
+}
+/**
+ * @brief encode frames into a stream, with C layers or C++ pipeline
+ *
+ * @tparam T frame type
+ * @tparam Cpp use C++ pipeline
+ */
+template <typename T, bool Cpp>
+static uint32_t Bench_encodeFrame(Codec* codec, const Bench_Case& bc) {
+    typename T::Frame frame;
+    StreamOut stream;
+    uint32_t count = 0;
+    uint32_t i;
+    Codec_Status status;
+
+    OStream_init(&stream, NULL, streamBuff, sizeof(streamBuff));
+    T::init(frame, payloadBuff, bc.Payload);
+    for (i = 0; i < bc.Frames; i++) {
+        if (OStream_space(&stream) < (Stream_LenType) bc.FrameLen) {
+            // consume transmitted bytes
+            Stream_moveReadPos(&stream.Buffer, OStream_pendingBytes(&stream));
+        }
+        if constexpr (Cpp) {
+            status = T::Pipeline::encode(frame, &stream);
+        }
+        else {
+            status = Codec_encodeFrame(codec, &frame, &stream, Codec_EncodeMode_Normal);
+        }
+        count += status == Codec_Status_Done;
+    }
+    return count;
+}
+/**
+ * @brief decode frames from a stream, stream refilled with sample when it's empty
+ *
+ * @tparam T frame type
+ * @tparam Cpp use C++ pipeline
+ */
+template <typename T, bool Cpp>
+static uint32_t Bench_decodeFrame(Codec* codec, const Bench_Case& bc) {
+    typename T::Frame frame;
+    StreamIn stream;
+    uint32_t count = 0;
+    uint32_t i;
+    Codec_Status status;
+
+    IStream_init(&stream, NULL, streamBuff, sizeof(streamBuff));
+    T::init(frame, rxPayloadBuff, sizeof(rxPayloadBuff));
+    while (count < bc.Frames) {
+        Stream_writeBytes(&stream.Buffer, sampleBuff, sampleLen);
+        for (i = 0; i < sampleFrames && count < bc.Frames; i++) {
+            if constexpr (Cpp) {
+                status = T::Pipeline::decode(frame, &stream);
+            }
+            else {
+                status = Codec_decodeFrame(codec, &frame, &stream);
+            }
+            if (status != Codec_Status_Done) {
+                return count;
+            }
+            count++;
+        }
+        Stream_moveReadPos(&stream.Buffer, IStream_available(&stream));
+    }
+    return count;
+}
+/**
+ * @brief encode frames into a raw buffer
+ *
+ * @tparam T frame type
+ * @tparam Cpp use C++ pipeline
+ */
+template <typename T, bool Cpp>
+static uint32_t Bench_encodeBuffer(Codec* codec, const Bench_Case& bc) {
+    typename T::Frame frame;
+    uint32_t count = 0;
+    uint32_t i;
+    Codec_Status status;
+
+    T::init(frame, payloadBuff, bc.Payload);
+    for (i = 0; i < bc.Frames; i++) {
+        if constexpr (Cpp) {
+            status = T::Pipeline::encode(frame, streamBuff, bc.FrameLen);
+        }
+        else {
+            status = Codec_encodeBuffer(codec, &frame, streamBuff, bc.FrameLen);
+        }
+        count += status == Codec_Status_Done;
+    }
+    return count;
+}
+/**
+ * @brief decode frames from a raw buffer, noise is skipped
+ *
+ * @tparam T frame type
+ * @tparam Cpp use C++ pipeline
+ */
+template <typename T, bool Cpp>
+static uint32_t Bench_decodeBuffer(Codec* codec, const Bench_Case& bc) {
+    typename T::Frame frame;
+    uint32_t count = 0;
+    uint32_t i;
+    Codec_Status status;
+
+    T::init(frame, rxPayloadBuff, sizeof(rxPayloadBuff));
+    for (i = 0; i < bc.Frames; i++) {
+        if constexpr (Cpp) {
+            status = T::Pipeline::decode(frame, &sampleBuff[bc.Noise], bc.FrameLen);
+        }
+        else {
+            status = Codec_decodeBuffer(codec, &frame, &sampleBuff[bc.Noise], bc.FrameLen);
+        }
+        count += status == Codec_Status_Done;
+    }
+    return count;
+}
+/**
+ * @brief run a benchmark on C layers and C++ pipeline and report both
+ *
+ * @tparam T frame type
+ * @param fnC benchmark on C layers
+ * @param fnCpp benchmark on C++ pipeline
+ */
+template <typename T>
+static void Bench_pair(const char* mode, uint32_t (*fnC)(Codec*, const Bench_Case&),
+                       uint32_t (*fnCpp)(Codec*, const Bench_Case&), const Bench_Case& bc) {
+    Codec codec;
+#if CODEC_COMPILE
+    Codec_CompiledLayer chain[8];
+#endif
+    uint32_t done;
+    double start;
+    double elapsed;
+
+    // C path with its fastest options
+    Codec_init(&codec, T::baseLayer());
+#if CODEC_DECODE_SYNC
+    if (T::sync()) {
+        Codec_setDecodeSync(&codec, T::sync());
+    }
+#endif
+#if CODEC_COMPILE
+    Codec_compile(&codec, chain, sizeof(chain) / sizeof(chain[0]));
+#endif
+
+    start = Bench_now();
+    done = fnC(&codec, bc);
+    elapsed = Bench_now() - start;
+    if (done != bc.Frames) {
+        Bench_fail(T::Name, mode, bc.Payload, "wrong frame count");
+    }
+    else {
+        Bench_report(T::Name, mode, bc.Payload, bc.Noise, bc.Frames,
+                     (uint64_t) bc.Frames * (bc.FrameLen + bc.Noise), elapsed);
+    }
+
+    start = Bench_now();
+    done = fnCpp(&codec, bc);
+    elapsed = Bench_now() - start;
+    if (done != bc.Frames) {
+        Bench_fail(T::NameCpp, mode, bc.Payload, "wrong frame count");
+    }
+    else {
+        Bench_report(T::NameCpp, mode, bc.Payload, bc.Noise, bc.Frames,
+                     (uint64_t) bc.Frames * (bc.FrameLen + bc.Noise), elapsed);
+    }
+}
+/**
+ * @brief check wire compatibility and run all benchmarks of a frame type and payload
+ *
+ * @tparam T frame type
+ * @param payload payload size
+ * @param noise noise bytes before each frame, only decode benchmarks run with noise
+ */
+template <typename T>
+void Bench_run(uint32_t payload, uint32_t noise) {
+    typename T::Frame frame;
+    Bench_Case bc;
+    uint64_t frames;
+    uint8_t err;
+
+    if (sizeof(Stream_LenType) < 4 && payload > 16384) {
+        // stream can't hold big frames
+        return;
+    }
+
+    T::init(frame, payloadBuff, payload);
+    bc.Payload = payload;
+    bc.FrameLen = T::len(frame);
+    bc.Noise = noise;
+    frames = FRAME_TOTAL_BYTES / quick / (bc.FrameLen + noise);
+    if (frames > FRAME_MAX_FRAMES / quick) {
+        frames = FRAME_MAX_FRAMES / quick;
+    }
+    if (frames < FRAME_MIN_FRAMES) {
+        frames = FRAME_MIN_FRAMES;
+    }
+    bc.Frames = (uint32_t) frames;
+
+    if ((err = Bench_wire<T>(bc)) != 0) {
+        static const char* const REASONS[] = {
+            "", "frame size", "encoded bytes differ", "C++ decode C bytes", "C decode C++ bytes",
+        };
+        Bench_fail(T::Name, "wire", payload, REASONS[err]);
+        return;
+    }
+    if (Bench_sample<T>(bc) != 0) {
+        Bench_fail(T::Name, "sample", payload, "encode sample");
+        return;
+    }
+
+    if (noise == 0) {
+        Bench_pair<T>("encodeFrame",  Bench_encodeFrame<T, false>,  Bench_encodeFrame<T, true>,  bc);
+        Bench_pair<T>("encodeBuffer", Bench_encodeBuffer<T, false>, Bench_encodeBuffer<T, true>, bc);
+        Bench_pair<T>("decodeBuffer", Bench_decodeBuffer<T, false>, Bench_decodeBuffer<T, true>, bc);
+    }
+    Bench_pair<T>("decodeFrame",  Bench_decodeFrame<T, false>,  Bench_decodeFrame<T, true>,  bc);
+}
+/**
+ * @brief return monotonic time in seconds
+ *
+ * @return double
+ */
+double Bench_now(void) {
+#if defined(_WIN32)
+    LARGE_INTEGER freq, now;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (double) now.QuadPart / (double) freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+#endif
+}
@@ -0,0 +1,955 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+    #define _POSIX_C_SOURCE     199309L
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <time.h>
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+    #define BENCH_THREADS       1
+    #include <pthread.h>
+    #include <sched.h>
+#else
+    #define BENCH_THREADS       0
+#endif
+
+#include "Codec.h"
+#include "CodecScan.h"
+#include "StreamBuffer.h"
+#include "InputStream.h"
+#include "OutputStream.h"
+
+#include "Frame/BasicFrame.h"
+#include "Frame/Packet.h"
+#include "Frame/PacketCrc.h"
+
+#define PRINTF                  printf
+#define PUTS                    puts
+
+/**
+ * @brief size of scan buffer, it must fit into Stream_LenType
+ */
+#define SCAN_BUFF_SIZE          16000
+/**
+ * @brief total bytes that each scan benchmark process
+ */
+#define SCAN_TOTAL_BYTES        (1024UL * 1024UL * 1024UL)
+/**
+ * @brief number of frames that each encode queue benchmark process
+ */
+#define ENCODE_TOTAL_FRAMES     (4UL * 1024UL * 1024UL)
+/**
+ * @brief number of frames that each layer walk benchmark measure
+ */
+#define WALK_TOTAL_FRAMES       (16UL * 1024UL * 1024UL)
+/**
+ * @brief number of slots in encode queue
+ */
+#define ENCODE_QUEUE_SIZE       64
+/**
+ * @brief size of encode output buffer
+ */
+#define ENCODE_BUFF_SIZE        4096
+/**
+ * @brief biggest payload of frame benchmarks
+ */
+#define FRAME_MAX_PAYLOAD       (1024UL * 1024UL)
+/**
+ * @brief size of stream that frame benchmarks use, fit biggest frame with noise
+ */
+#define FRAME_STREAM_SIZE       (2 * FRAME_MAX_PAYLOAD + 1024)
+/**
+ * @brief total bytes that each frame benchmark process
+ */
+#define FRAME_TOTAL_BYTES       (32UL * 1024UL * 1024UL)
+/**
+ * @brief limit number of frames for tiny payloads
+ */
+#define FRAME_MAX_FRAMES        (1024UL * 1024UL)
+/**
+ * @brief minimum number of frames for huge payloads
+ */
+#define FRAME_MIN_FRAMES        16
+/**
+ * @brief number of frame slots of batch decode benchmark
+ */
+#define FRAME_BATCH_SIZE        16
+/**
+ * @brief quick mode divide totals by this value
+ */
+#define QUICK_DIV               16
+
+typedef Stream_LenType (*Bench_ScanFn)(StreamIn* stream);
+typedef uint32_t (*Bench_EncodeFn)(Codec* codec, Packet* frames, uint32_t num, StreamOut* stream);
+
+/**
+ * @brief frame types that benchmarks run on
+ */
+typedef struct {
+    const char*             Name;
+    Codec_LayerImpl*        (*baseLayer)(void);
+    void                    (*init)(Codec_Frame* frame, uint8_t* data, uint32_t size);
+    uint32_t                (*len)(Codec_Frame* frame);
+    Codec_SyncFn            sync;
+    uint8_t                 Compile;        /**< compile layer chain before benchmark */
+} Bench_Codec;
+/**
+ * @brief parameters of a frame benchmark
+ */
+typedef struct {
+    const Bench_Codec*      Codec;
+    uint32_t                Payload;
+    uint32_t                FrameLen;
+    uint32_t                Noise;          /**< noise bytes before each frame */
+    uint32_t                Frames;         /**< number of frames to process */
+} Bench_Case;
+
+typedef uint32_t (*Bench_FrameFn)(Codec* codec, const Bench_Case* bc);
+
+/**
+ * @brief custom frame, same as Codec-Test CFrame
+ */
+typedef struct {
+    uint32_t                PacketSize;
+    uint8_t*                Data;
+} CFrame;
+
+typedef union {
+    Packet                  Packet;
+#if CODEC_CRC
+    PacketCrc               PacketCrc;
+#endif
+    BasicFrame              BasicFrame;
+    CFrame                  CFrame;
+} Bench_Frame;
+
+double Bench_now(void);
+void Bench_report(const char* codec, const char* mode, uint32_t payload, uint32_t noise,
+                  uint64_t frames, uint64_t bytes, double elapsed);
+
+void Bench_scan(const char* name, Bench_ScanFn fn, uint8_t noise);
+Stream_LenType Bench_scanFind(StreamIn* stream);
+Stream_LenType Bench_scanSync(StreamIn* stream);
+
+void Bench_encode(const char* name, Bench_EncodeFn fn);
+uint32_t Bench_encodeBegin(Codec* codec, Packet* frames, uint32_t num, StreamOut* stream);
+#if CODEC_ENCODE_QUEUE
+uint32_t Bench_encodeQueue(Codec* codec, Packet* frames, uint32_t num, StreamOut* stream);
+#endif
+
+void Bench_walk(const Bench_Codec* codec, uint32_t payload);
+void Bench_frame(const char* mode, Bench_FrameFn fn, const Bench_Codec* codec, uint32_t payload, uint32_t noise);
+uint32_t Bench_encodeFrame(Codec* codec, const Bench_Case* bc);
+uint32_t Bench_decodeFrame(Codec* codec, const Bench_Case* bc);
+uint32_t Bench_encodeBuffer(Codec* codec, const Bench_Case* bc);
+uint32_t Bench_decodeBuffer(Codec* codec, const Bench_Case* bc);
+uint32_t Bench_encodeAsync(Codec* codec, const Bench_Case* bc);
+uint32_t Bench_decodeAsync(Codec* codec, const Bench_Case* bc);
+#if CODEC_DECODE_BATCH
+uint32_t Bench_decodeBatch(Codec* codec, const Bench_Case* bc);
+#endif
+
+Codec_LayerImpl* CFrame_baseLayer(void);
+void Bench_Packet_init(Codec_Frame* frame, uint8_t* data, uint32_t size);
+uint32_t Bench_Packet_len(Codec_Frame* frame);
+#if CODEC_CRC
+void Bench_PacketCrc_init(Codec_Frame* frame, uint8_t* data, uint32_t size);
+uint32_t Bench_PacketCrc_len(Codec_Frame* frame);
+#endif
+void Bench_BasicFrame_init(Codec_Frame* frame, uint8_t* data, uint32_t size);
+uint32_t Bench_BasicFrame_len(Codec_Frame* frame);
+void Bench_CFrame_init(Codec_Frame* frame, uint8_t* data, uint32_t size);
+uint32_t Bench_CFrame_len(Codec_Frame* frame);
+
+static const Bench_Codec CODECS[] = {
+    { "Packet",     Packet_baseLayer,       Bench_Packet_init,      Bench_Packet_len,       Packet_sync,    0 },
+#if CODEC_COMPILE
+    { "Packet-C",   Packet_baseLayer,       Bench_Packet_init,      Bench_Packet_len,       Packet_sync,    1 },
+#endif
+#if CODEC_CRC
+    { "PacketCrc",  PacketCrc_baseLayer,    Bench_PacketCrc_init,   Bench_PacketCrc_len,    PacketCrc_sync, 0 },
+#endif
+    { "BasicFrame", BasicFrame_baseLayer,   Bench_BasicFrame_init,  Bench_BasicFrame_len,   NULL,           0 },
+#if CODEC_COMPILE
+    { "BasicFrame-C", BasicFrame_baseLayer, Bench_BasicFrame_init,  Bench_BasicFrame_len,   NULL,           1 },
+#endif
+    { "CFrame",     CFrame_baseLayer,       Bench_CFrame_init,      Bench_CFrame_len,       NULL,           0 },
+};
+static const uint32_t CODECS_LEN = sizeof(CODECS) / sizeof(CODECS[0]);
+
+static const uint32_t PAYLOADS[] = {
+    0, 16, 64, 256, 1024, 4096, 65536, FRAME_MAX_PAYLOAD,
+};
+static const uint32_t PAYLOADS_LEN = sizeof(PAYLOADS) / sizeof(PAYLOADS[0]);
+/**
+ * @brief noise ratio of noise sweep in percent of input bytes
+ */
+static const uint32_t NOISE_RATIOS[] = {
+    0, 10, 25, 50, 75, 90,
+};
+static const uint32_t NOISE_RATIOS_LEN = sizeof(NOISE_RATIOS) / sizeof(NOISE_RATIOS[0]);
+
+static uint8_t scanBuff[SCAN_BUFF_SIZE];
+static uint8_t encodeBuff[ENCODE_BUFF_SIZE];
+static uint32_t encodeCount;
+
+static uint8_t payloadBuff[FRAME_MAX_PAYLOAD];
+static uint8_t rxPayloadBuff[FRAME_MAX_PAYLOAD];
+static uint8_t streamBuff[FRAME_STREAM_SIZE];
+static uint8_t sampleBuff[FRAME_STREAM_SIZE];
+static uint32_t sampleLen;
+static uint32_t sampleFrames;
+static uint32_t decodeCount;
+
+static uint8_t csv = 0;
+static uint32_t quick = 1;
+
+int main(int argc, char* argv[])
+{
+    uint32_t c;
+    uint32_t p;
+    uint32_t n;
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0) {
+            // machine readable output
+            csv = 1;
+        }
+        else if (strcmp(argv[i], "--quick") == 0) {
+            quick = QUICK_DIV;
+        }
+        else {
+            PRINTF("usage: %s [--csv] [--quick]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (csv) {
+        PRINTF("# codec %s, scanner %s\n", CODEC_VER_STR, Codec_scanImpl());
+        PUTS("codec,mode,payload,noise,frames,bytes,seconds,mb_s,frames_s,ns_frame");
+    }
+    else {
+        PUTS("------- Start Codec Benchmarks -------");
+        PRINTF("Codec: %s, Scanner: %s\n", CODEC_VER_STR, Codec_scanImpl());
+        PUTS("---- Packet Sync Scan ----");
+    }
+    Bench_scan("scan-find-0xFF", Bench_scanFind, 0xFF);
+    Bench_scan("scan-sync-0xFF", Bench_scanSync, 0xFF);
+    // noise that match first byte of sign, worst case of candidate filter
+    Bench_scan("scan-find-0x33", Bench_scanFind, 0x33);
+    Bench_scan("scan-sync-0x33", Bench_scanSync, 0x33);
+
+    if (!csv) {
+        PUTS("---- Async Encode Queue ----");
+    }
+    Bench_encode("encode-begin-loop", Bench_encodeBegin);
+#if CODEC_ENCODE_QUEUE
+    Bench_encode("encode-queue", Bench_encodeQueue);
+#endif
+
+    if (!csv) {
+        PUTS("---- Layer Walk ----");
+    }
+    for (c = 0; c < CODECS_LEN; c++) {
+        Bench_walk(&CODECS[c], 16);
+    }
+
+    for (c = 0; c < CODECS_LEN; c++) {
+        if (!csv) {
+            PRINTF("---- %s ----\n", CODECS[c].Name);
+        }
+        for (p = 0; p < PAYLOADS_LEN; p++) {
+            Bench_frame("encodeFrame",  Bench_encodeFrame,  &CODECS[c], PAYLOADS[p], 0);
+            Bench_frame("decodeFrame",  Bench_decodeFrame,  &CODECS[c], PAYLOADS[p], 0);
+        #if CODEC_DECODE_BATCH
+            Bench_frame("decodeBatch",  Bench_decodeBatch,  &CODECS[c], PAYLOADS[p], 0);
+        #endif
+            Bench_frame("encodeBuffer", Bench_encodeBuffer, &CODECS[c], PAYLOADS[p], 0);
+            Bench_frame("decodeBuffer", Bench_decodeBuffer, &CODECS[c], PAYLOADS[p], 0);
+            Bench_frame("encode",       Bench_encodeAsync,  &CODECS[c], PAYLOADS[p], 0);
+            Bench_frame("decode",       Bench_decodeAsync,  &CODECS[c], PAYLOADS[p], 0);
+        }
+    }
+
+    if (!csv) {
+        PUTS("---- Noise Sweep (Packet, 64 B payload) ----");
+    }
+    for (n = 0; n < NOISE_RATIOS_LEN; n++) {
+        // noise bytes per frame for requested ratio of input
+        uint32_t frameLen = Bench_Packet_len(NULL) + 64;
+        uint32_t noise = frameLen * NOISE_RATIOS[n] / (100 - NOISE_RATIOS[n]);
+        Bench_frame("decodeFrame", Bench_decodeFrame, &CODECS[0], 64, noise);
+    #if CODEC_DECODE_BATCH
+        Bench_frame("decodeBatch", Bench_decodeBatch, &CODECS[0], 64, noise);
+    #endif
+        Bench_frame("decode",      Bench_decodeAsync, &CODECS[0], 64, noise);
+    }
+
+    if (!csv) {
+        PUTS("\nBenchmarks Ended");
+    }
+    return 0;
+}
+/**
+ * @brief print result of a benchmark, in human readable or csv format
+ *
+ * @param codec name of frame type
+ * @param mode name of benchmark
+ * @param payload payload size of frames
+ * @param noise noise bytes before each frame
+ * @param frames number of processed frames, 0 if benchmark is not frame based
+ * @param bytes number of processed bytes
+ * @param elapsed seconds
+ */
+void Bench_report(const char* codec, const char* mode, uint32_t payload, uint32_t noise,
+                  uint64_t frames, uint64_t bytes, double elapsed) {
+    double mbs = (double) bytes / elapsed / 1e6;
+    double fps = (double) frames / elapsed;
+    double ns = frames > 0 ? elapsed * 1e9 / (double) frames : 0;
+
+    if (csv) {
+        PRINTF("%s,%s,%u,%u,%llu,%llu,%.6f,%.3f,%.0f,%.1f\n", codec, mode, payload, noise,
+               (unsigned long long) frames, (unsigned long long) bytes, elapsed, mbs, fps, ns);
+    }
+    else if (frames > 0) {
+        PRINTF("%-10s %-18s %8u B noise %5u B: %10.2f MB/s %12.0f frames/s %10.1f ns/frame\n",
+               codec, mode, payload, noise, mbs, fps, ns);
+    }
+    else {
+        PRINTF("%-10s %-18s: %10.2f MB/s\n", codec, mode, mbs);
+    }
+}
+/**
+ * @brief report a failed benchmark
+ */
+static void Bench_fail(const char* codec, const char* mode, uint32_t payload, const char* reason) {
+    if (csv) {
+        PRINTF("# %s,%s,%u failed: %s\n", codec, mode, payload, reason);
+    }
+    else {
+        PRINTF("%-10s %-18s %8u B: failed, %s\n", codec, mode, payload, reason);
+    }
+}
+/**
+ * @brief scan a stream full of noise that pattern placed at the end of it
+ *
+ * @param name name of benchmark
+ * @param fn scan function
+ * @param noise noise byte
+ */
+void Bench_scan(const char* name, Bench_ScanFn fn, uint8_t noise) {
+    StreamIn stream;
+    uint64_t offset = 0;
+    uint32_t rounds = (uint32_t) (SCAN_TOTAL_BYTES / SCAN_BUFF_SIZE / quick);
+    uint32_t i;
+    double start;
+    double elapsed;
+
+    memset(scanBuff, noise, sizeof(scanBuff));
+    IStream_init(&stream, NULL, scanBuff, sizeof(scanBuff));
+    Stream_moveWritePos(&stream.Buffer, sizeof(scanBuff));
+    IStream_setByteOrder(&stream, PACKET_BYTE_ORDER);
+    // place first sign at end of buffer
+    scanBuff[SCAN_BUFF_SIZE - 2] = (uint8_t) (PACKET_FIRST_SIGN >> 8);
+    scanBuff[SCAN_BUFF_SIZE - 1] = (uint8_t) PACKET_FIRST_SIGN;
+
+    start = Bench_now();
+    for (i = 0; i < rounds; i++) {
+        offset += (uint64_t) fn(&stream);
+    }
+    elapsed = Bench_now() - start;
+
+    if (offset != (uint64_t) rounds * (SCAN_BUFF_SIZE - 2)) {
+        Bench_fail("Packet", name, 0, "wrong offset");
+        return;
+    }
+    Bench_report("Packet", name, 0, SCAN_BUFF_SIZE - 2, 0, (uint64_t) rounds * SCAN_BUFF_SIZE, elapsed);
+}
+
+Stream_LenType Bench_scanFind(StreamIn* stream) {
+    return IStream_findUInt16(stream, PACKET_FIRST_SIGN);
+}
+Stream_LenType Bench_scanSync(StreamIn* stream) {
+    return Packet_sync(NULL, stream);
+}
+static void Bench_onEncode(Codec* codec, Codec_Frame* frame) {
+    encodeCount++;
+}
+/**
+ * @brief encode small packets through async encode api and report frames per second
+ *
+ * @param name name of benchmark
+ * @param fn encode function
+ */
+void Bench_encode(const char* name, Bench_EncodeFn fn) {
+    static uint8_t payload[16] = {0};
+    Packet frames[ENCODE_QUEUE_SIZE];
+    StreamOut stream;
+    Codec codec;
+    uint32_t i;
+    uint32_t total;
+    double start;
+    double elapsed;
+
+    OStream_init(&stream, NULL, encodeBuff, sizeof(encodeBuff));
+    Codec_init(&codec, Packet_baseLayer());
+    Codec_onEncode(&codec, Bench_onEncode);
+    for (i = 0; i < ENCODE_QUEUE_SIZE; i++) {
+        Packet_init(&frames[i], payload, sizeof(payload));
+    }
+    encodeCount = 0;
+
+    start = Bench_now();
+    total = fn(&codec, frames, ENCODE_TOTAL_FRAMES / quick, &stream);
+    elapsed = Bench_now() - start;
+
+    if (encodeCount != total) {
+        Bench_fail("Packet", name, sizeof(payload), "wrong frame count");
+        return;
+    }
+    Bench_report("Packet", name, sizeof(payload), 0, total, (uint64_t) total * Packet_len(&frames[0]), elapsed);
+}
+/**
+ * @brief encode frames one by one with Codec_beginEncode and Codec_encode
+ */
+uint32_t Bench_encodeBegin(Codec* codec, Packet* frames, uint32_t num, StreamOut* stream) {
+    uint32_t i;
+
+    for (i = 0; i < num; i++) {
+        Codec_beginEncode(codec, &frames[i % ENCODE_QUEUE_SIZE], Codec_EncodeMode_Normal);
+        Codec_encode(codec, stream);
+        // consume transmitted bytes
+        Stream_moveReadPos(&stream->Buffer, OStream_pendingBytes(stream));
+    }
+    return num;
+}
+#if CODEC_ENCODE_QUEUE
+#if BENCH_THREADS
+typedef struct {
+    Codec_EncodeQueue*      Queue;
+    Packet*                 Frames;
+    uint32_t                Num;
+} Bench_Producer;
+/**
+ * @brief producer side of encode queue, push frames and wait for free slot when queue is full
+ *
+ * @param arg Bench_Producer
+ * @return void* NULL
+ */
+static void* Bench_produce(void* arg) {
+    Bench_Producer* producer = (Bench_Producer*) arg;
+    uint32_t i;
+
+    for (i = 0; i < producer->Num; i++) {
+        while (Codec_EncodeQueue_push(producer->Queue, &producer->Frames[i % ENCODE_QUEUE_SIZE]) != Codec_Status_Done) {
+            // queue is full, give cpu to tx thread
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+#endif
+/**
+ * @brief producer thread push frames into encode queue, tx thread drain queue with Codec_encode,
+ * without threads support push and drain run in turn on one thread
+ */
+uint32_t Bench_encodeQueue(Codec* codec, Packet* frames, uint32_t num, StreamOut* stream) {
+    static Codec_Frame* slots[ENCODE_QUEUE_SIZE];
+    static Codec_EncodeQueue queue;
+#if BENCH_THREADS
+    Bench_Producer producer;
+    pthread_t thread;
+#else
+    uint32_t i = 0;
+#endif
+
+    Codec_EncodeQueue_init(&queue, slots, ENCODE_QUEUE_SIZE);
+    Codec_setEncodeQueue(codec, &queue);
+#if BENCH_THREADS
+    producer.Queue = &queue;
+    producer.Frames = frames;
+    producer.Num = num;
+    if (pthread_create(&thread, NULL, Bench_produce, &producer) != 0) {
+        return 0;
+    }
+#endif
+    while (encodeCount < num) {
+    #if BENCH_THREADS
+        if (Codec_EncodeQueue_available(&queue) == 0) {
+            // queue is empty, give cpu to producer
+            sched_yield();
+            continue;
+        }
+    #else
+        while (i < num && Codec_EncodeQueue_push(&queue, &frames[i % ENCODE_QUEUE_SIZE]) == Codec_Status_Done) {
+            i++;
+        }
+    #endif
+        Codec_encode(codec, stream);
+        // consume transmitted bytes
+        Stream_moveReadPos(&stream->Buffer, OStream_pendingBytes(stream));
+    }
+#if BENCH_THREADS
+    pthread_join(thread, NULL);
+#endif
+    return num;
+}
+#endif
+static void Bench_onDecode(Codec* codec, Codec_Frame* frame) {
+    decodeCount++;
+}
+/**
+ * @brief prepare sample of encoded frames with noise, as many frames that fit in frame stream
+ *
+ * @param bc
+ * @return uint8_t 0 if sample prepared
+ */
+static uint8_t Bench_sample(const Bench_Case* bc) {
+    Bench_Frame frame;
+    Codec codec;
+    uint32_t unit = bc->FrameLen + bc->Noise;
+    uint32_t i;
+
+    sampleFrames = (uint32_t) (FRAME_STREAM_SIZE / unit);
+    if (sampleFrames > bc->Frames) {
+        sampleFrames = bc->Frames;
+    }
+    Codec_init(&codec, bc->Codec->baseLayer());
+    bc->Codec->init((Codec_Frame*) &frame, payloadBuff, bc->Payload);
+    sampleLen = 0;
+    for (i = 0; i < sampleFrames; i++) {
+        memset(&sampleBuff[sampleLen], 0xFF, bc->Noise);
+        sampleLen += bc->Noise;
+        if (Codec_encodeBuffer(&codec, (Codec_Frame*) &frame, &sampleBuff[sampleLen], bc->FrameLen) != Codec_Status_Done) {
+            return 1;
+        }
+        sampleLen += bc->FrameLen;
+    }
+    return 0;
+}
+/**
+ * @brief walk layer chain of frame with Codec_frameSize, measure only cost of reading lengths
+ * and next layers, from layer descriptors or from compiled chain for "-C" codecs
+ *
+ * @param codec frame type
+ * @param payload payload size
+ */
+void Bench_walk(const Bench_Codec* codec, uint32_t payload) {
+    Bench_Frame frame;
+    Codec c;
+#if CODEC_COMPILE
+    Codec_CompiledLayer chain[8];
+#endif
+    uint32_t total = WALK_TOTAL_FRAMES / quick;
+    uint32_t i;
+    uint64_t bytes = 0;
+    double start;
+    double elapsed;
+
+    codec->init((Codec_Frame*) &frame, payloadBuff, payload);
+    Codec_init(&c, codec->baseLayer());
+#if CODEC_COMPILE
+    if (codec->Compile) {
+        Codec_compile(&c, chain, sizeof(chain) / sizeof(chain[0]));
+    }
+#endif
+
+    start = Bench_now();
+    for (i = 0; i < total; i++) {
+        bytes += Codec_frameSize(&c, (Codec_Frame*) &frame, Codec_Phase_Encode);
+    }
+    elapsed = Bench_now() - start;
+
+    if (bytes != (uint64_t) total * codec->len((Codec_Frame*) &frame)) {
+        Bench_fail(codec->Name, "frameSize", payload, "wrong frame size");
+        return;
+    }
+    Bench_report(codec->Name, "frameSize", payload, 0, total, bytes, elapsed);
+}
+/**
+ * @brief run a frame benchmark and report it
+ *
+ * @param mode name of benchmark
+ * @param fn benchmark function, return number of processed frames
+ * @param codec frame type
+ * @param payload payload size
+ * @param noise noise bytes before each frame
+ */
+void Bench_frame(const char* mode, Bench_FrameFn fn, const Bench_Codec* codec, uint32_t payload, uint32_t noise) {
+    Bench_Case bc;
+    Bench_Frame frame;
+    Codec c;
+#if CODEC_COMPILE
+    Codec_CompiledLayer chain[8];
+#endif
+    uint64_t frames;
+    uint32_t done;
+    double start;
+    double elapsed;
+
+    if (sizeof(Stream_LenType) < 4 && payload > 16384) {
+        // stream can't hold big frames
+        return;
+    }
+
+    bc.Codec = codec;
+    bc.Payload = payload;
+    codec->init((Codec_Frame*) &frame, payloadBuff, payload);
+    bc.FrameLen = codec->len((Codec_Frame*) &frame);
+    bc.Noise = noise;
+    frames = FRAME_TOTAL_BYTES / quick / (bc.FrameLen + noise);
+    if (frames > FRAME_MAX_FRAMES / quick) {
+        frames = FRAME_MAX_FRAMES / quick;
+    }
+    if (frames < FRAME_MIN_FRAMES) {
+        frames = FRAME_MIN_FRAMES;
+    }
+    bc.Frames = (uint32_t) frames;
+
+    if (noise > 0 && codec->sync == NULL) {
+        Bench_fail(codec->Name, mode, payload, "noise need sync function");
+        return;
+    }
+    if (Bench_sample(&bc) != 0) {
+        Bench_fail(codec->Name, mode, payload, "encode sample");
+        return;
+    }
+
+    Codec_init(&c, codec->baseLayer());
+    Codec_onDecode(&c, Bench_onDecode);
+    Codec_onEncode(&c, Bench_onEncode);
+    if (codec->sync) {
+        Codec_setDecodeSync(&c, codec->sync);
+    }
+#if CODEC_COMPILE
+    if (codec->Compile) {
+        Codec_compile(&c, chain, sizeof(chain) / sizeof(chain[0]));
+    }
+#endif
+    decodeCount = 0;
+    encodeCount = 0;
+
+    start = Bench_now();
+    done = fn(&c, &bc);
+    elapsed = Bench_now() - start;
+
+    if (done != bc.Frames) {
+        Bench_fail(codec->Name, mode, payload, "wrong frame count");
+        return;
+    }
+    Bench_report(codec->Name, mode, payload, noise, bc.Frames,
+                 (uint64_t) bc.Frames * (bc.FrameLen + noise), elapsed);
+}
+/**
+ * @brief encode frames with Codec_encodeFrame into a stream
+ */
+uint32_t Bench_encodeFrame(Codec* codec, const Bench_Case* bc) {
+    Bench_Frame frame;
+    StreamOut stream;
+    uint32_t i;
+
+    OStream_init(&stream, NULL, streamBuff, sizeof(streamBuff));
+    bc->Codec->init((Codec_Frame*) &frame, payloadBuff, bc->Payload);
+    for (i = 0; i < bc->Frames; i++) {
+        if (OStream_space(&stream) < (Stream_LenType) bc->FrameLen) {
+            // consume transmitted bytes
+            Stream_moveReadPos(&stream.Buffer, OStream_pendingBytes(&stream));
+        }
+        Codec_encodeFrame(codec, (Codec_Frame*) &frame, &stream, Codec_EncodeMode_Normal);
+    }
+    return encodeCount;
+}
+/**
+ * @brief decode frames with Codec_decodeFrame, stream refilled with sample when it's empty
+ */
+uint32_t Bench_decodeFrame(Codec* codec, const Bench_Case* bc) {
+    Bench_Frame frame;
+    StreamIn stream;
+    uint32_t i;
+    uint32_t count = 0;
+
+    IStream_init(&stream, NULL, streamBuff, sizeof(streamBuff));
+    bc->Codec->init((Codec_Frame*) &frame, rxPayloadBuff, sizeof(rxPayloadBuff));
+    while (count < bc->Frames) {
+        Stream_writeBytes(&stream.Buffer, sampleBuff, sampleLen);
+        for (i = 0; i < sampleFrames && count < bc->Frames; i++) {
+            if (Codec_decodeFrame(codec, (Codec_Frame*) &frame, &stream) != Codec_Status_Done) {
+                return count;
+            }
+            count++;
+        }
+        Stream_moveReadPos(&stream.Buffer, IStream_available(&stream));
+    }
+    return decodeCount;
+}
+#if CODEC_DECODE_BATCH
+/**
+ * @brief decode frames with Codec_decodeBatch, same input of Bench_decodeFrame,
+ * slots share payload buffer because frames are only counted
+ */
+uint32_t Bench_decodeBatch(Codec* codec, const Bench_Case* bc) {
+    Bench_Frame frames[FRAME_BATCH_SIZE];
+    Codec_Frame* slots[FRAME_BATCH_SIZE];
+    StreamIn stream;
+    Stream_LenType len;
+    uint32_t i;
+    uint32_t count = 0;
+
+    IStream_init(&stream, NULL, streamBuff, sizeof(streamBuff));
+    for (i = 0; i < FRAME_BATCH_SIZE; i++) {
+        bc->Codec->init((Codec_Frame*) &frames[i], rxPayloadBuff, sizeof(rxPayloadBuff));
+        slots[i] = (Codec_Frame*) &frames[i];
+    }
+    while (count < bc->Frames) {
+        Stream_writeBytes(&stream.Buffer, sampleBuff, sampleLen);
+        for (i = 0; i < sampleFrames && count < bc->Frames; i += len) {
+            len = FRAME_BATCH_SIZE;
+            if (len > sampleFrames - i) {
+                len = sampleFrames - i;
+            }
+            if (len > bc->Frames - count) {
+                len = bc->Frames - count;
+            }
+            if ((len = Codec_decodeBatch(codec, slots, len, &stream)) == 0) {
+                return count;
+            }
+            count += len;
+        }
+        Stream_moveReadPos(&stream.Buffer, IStream_available(&stream));
+    }
+    return count;
+}
+#endif
+/**
+ * @brief encode frames with Codec_encodeBuffer
+ */
+uint32_t Bench_encodeBuffer(Codec* codec, const Bench_Case* bc) {
+    Bench_Frame frame;
+    uint32_t i;
+
+    bc->Codec->init((Codec_Frame*) &frame, payloadBuff, bc->Payload);
+    for (i = 0; i < bc->Frames; i++) {
+        Codec_encodeBuffer(codec, (Codec_Frame*) &frame, streamBuff, bc->FrameLen);
+    }
+    return encodeCount;
+}
+/**
+ * @brief decode frames with Codec_decodeBuffer, noise is skipped
+ */
+uint32_t Bench_decodeBuffer(Codec* codec, const Bench_Case* bc) {
+    Bench_Frame frame;
+    uint32_t i;
+
+    bc->Codec->init((Codec_Frame*) &frame, rxPayloadBuff, sizeof(rxPayloadBuff));
+    for (i = 0; i < bc->Frames; i++) {
+        Codec_decodeBuffer(codec, (Codec_Frame*) &frame, &sampleBuff[bc->Noise], bc->FrameLen);
+    }
+    return decodeCount;
+}
+/**
+ * @brief encode frames with Codec_beginEncode and Codec_encode
+ */
+uint32_t Bench_encodeAsync(Codec* codec, const Bench_Case* bc) {
+    Bench_Frame frame;
+    StreamOut stream;
+    uint32_t i;
+
+    OStream_init(&stream, NULL, streamBuff, sizeof(streamBuff));
+    bc->Codec->init((Codec_Frame*) &frame, payloadBuff, bc->Payload);
+    for (i = 0; i < bc->Frames; i++) {
+        Codec_beginEncode(codec, (Codec_Frame*) &frame, Codec_EncodeMode_Normal);
+        Codec_encode(codec, &stream);
+        while (codec->Tx.Layer != CODEC_LAYER_NULL) {
+            // consume transmitted bytes
+            Stream_moveReadPos(&stream.Buffer, OStream_pendingBytes(&stream));
+            Codec_encode(codec, &stream);
+        }
+    }
+    return encodeCount;
+}
+/**
+ * @brief decode frames with Codec_decode in decode all mode, stream refilled with sample
+ */
+uint32_t Bench_decodeAsync(Codec* codec, const Bench_Case* bc) {
+    Bench_Frame frame;
+    StreamIn stream;
+    uint32_t rounds = (bc->Frames + sampleFrames - 1) / sampleFrames;
+    uint32_t i;
+
+    IStream_init(&stream, NULL, streamBuff, sizeof(streamBuff));
+    bc->Codec->init((Codec_Frame*) &frame, rxPayloadBuff, sizeof(rxPayloadBuff));
+    Codec_setDecodeAll(codec, 1);
+    Codec_beginDecode(codec, (Codec_Frame*) &frame);
+    for (i = 0; i < rounds; i++) {
+        Stream_writeBytes(&stream.Buffer, sampleBuff, sampleLen);
+        Codec_decode(codec, &stream);
+    }
+    // last round may decode more frames than requested
+    return decodeCount == rounds * sampleFrames ? bc->Frames : decodeCount;
+}
+/**
+ * @brief return monotonic time in seconds
+ *
+ * @return double
+ */
+double Bench_now(void) {
+#if defined(_WIN32)
+    LARGE_INTEGER freq, now;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (double) now.QuadPart / (double) freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+#endif
+}
+
+// ------------------------- Frame Adapters --------------------------
+
+void Bench_Packet_init(Codec_Frame* frame, uint8_t* data, uint32_t size) {
+    Packet_init((Packet*) frame, data, size);
+}
+uint32_t Bench_Packet_len(Codec_Frame* frame) {
+    return frame != NULL ? Packet_len((Packet*) frame) : PACKET_HEADER_SIZE + PACKET_FOOTER_SIZE;
+}
+#if CODEC_CRC
+void Bench_PacketCrc_init(Codec_Frame* frame, uint8_t* data, uint32_t size) {
+    PacketCrc_init((PacketCrc*) frame, data, size);
+}
+uint32_t Bench_PacketCrc_len(Codec_Frame* frame) {
+    return frame != NULL ? PacketCrc_len((PacketCrc*) frame) : PACKET_HEADER_SIZE + PACKET_FOOTER_SIZE;
+}
+#endif
+void Bench_BasicFrame_init(Codec_Frame* frame, uint8_t* data, uint32_t size) {
+    BasicFrame_init((BasicFrame*) frame, data, size);
+}
+uint32_t Bench_BasicFrame_len(Codec_Frame* frame) {
+    return BasicFrame_len((BasicFrame*) frame);
+}
+void Bench_CFrame_init(Codec_Frame* frame, uint8_t* data, uint32_t size) {
+    ((CFrame*) frame)->PacketSize = size;
+    ((CFrame*) frame)->Data = data;
+}
+uint32_t Bench_CFrame_len(Codec_Frame* frame) {
+    return ((CFrame*) frame)->PacketSize + sizeof(uint32_t) + sizeof(uint32_t);
+}
+
+// ------------------------- Custom Frame --------------------------
+
+#if CODEC_DECODE
+static Codec_Error      CFrame_Header_parse(Codec* codec, Codec_Frame* frame, StreamIn* stream);
+static Codec_Error      CFrame_Data_parse(Codec* codec, Codec_Frame* frame, StreamIn* stream);
+static Codec_Error      CFrame_Footer_parse(Codec* codec, Codec_Frame* frame, StreamIn* stream);
+#endif // CODEC_DECODE
+
+#if CODEC_ENCODE
+static Codec_Error      CFrame_Header_write(Codec* codec, Codec_Frame* frame, StreamOut* stream);
+static Codec_Error      CFrame_Data_write(Codec* codec, Codec_Frame* frame, StreamOut* stream);
+static Codec_Error      CFrame_Footer_write(Codec* codec, Codec_Frame* frame, StreamOut* stream);
+#endif // CODEC_ENCODE
+
+static Stream_LenType   CFrame_Header_getLen(Codec* codec, Codec_Frame* frame, Codec_Phase phase);
+static Codec_LayerImpl* CFrame_Header_nextLayer(Codec* codec, Codec_Frame* frame, Codec_Phase phase);
+
+static Stream_LenType   CFrame_Data_getLen(Codec* codec, Codec_Frame* frame, Codec_Phase phase);
+static Codec_LayerImpl* CFrame_Data_nextLayer(Codec* codec, Codec_Frame* frame, Codec_Phase phase);
+
+static Stream_LenType   CFrame_Footer_getLen(Codec* codec, Codec_Frame* frame, Codec_Phase phase);
+static Codec_LayerImpl* CFrame_Footer_nextLayer(Codec* codec, Codec_Frame* frame, Codec_Phase phase);
+
+static const Codec_LayerImpl CFRAME_HEADER_IMPL = {
+#if CODEC_DECODE
+    CFrame_Header_parse,
+#endif
+#if CODEC_ENCODE
+    CFrame_Header_write,
+#endif
+    CFrame_Header_getLen,
+    CFrame_Header_nextLayer,
+};
+
+static const Codec_LayerImpl CFRAME_DATA_IMPL = {
+#if CODEC_DECODE
+    CFrame_Data_parse,
+#endif
+#if CODEC_ENCODE
+    CFrame_Data_write,
+#endif
+    CFrame_Data_getLen,
+    CFrame_Data_nextLayer,
+};
+
+static const Codec_LayerImpl CFRAME_FOOTER_IMPL = {
+#if CODEC_DECODE
+    CFrame_Footer_parse,
+#endif
+#if CODEC_ENCODE
+    CFrame_Footer_write,
+#endif
+    CFrame_Footer_getLen,
+    CFrame_Footer_nextLayer,
+};
+
+#if CODEC_DECODE
+static Codec_Error      CFrame_Header_parse(Codec* codec, Codec_Frame* frame, StreamIn* stream) {
+    ((CFrame*) frame)->PacketSize = IStream_readUInt32(stream);
+    return CODEC_OK;
+}
+static Codec_Error      CFrame_Data_parse(Codec* codec, Codec_Frame* frame, StreamIn* stream) {
+    CFrame* cFrame = (CFrame*) frame;
+    IStream_readBytes(stream, cFrame->Data, cFrame->PacketSize);
+    return CODEC_OK;
+}
+static Codec_Error      CFrame_Footer_parse(Codec* codec, Codec_Frame* frame, StreamIn* stream) {
+    return IStream_readUInt32(stream) != 0xABCD1234;
+}
+#endif // CODEC_DECODE
+
+#if CODEC_ENCODE
+static Codec_Error      CFrame_Header_write(Codec* codec, Codec_Frame* frame, StreamOut* stream) {
+    OStream_writeUInt32(stream, ((CFrame*) frame)->PacketSize);
+    return CODEC_OK;
+}
+static Codec_Error      CFrame_Data_write(Codec* codec, Codec_Frame* frame, StreamOut* stream) {
+    CFrame* cFrame = (CFrame*) frame;
+    OStream_writeBytes(stream, cFrame->Data, cFrame->PacketSize);
+    return CODEC_OK;
+}
+static Codec_Error      CFrame_Footer_write(Codec* codec, Codec_Frame* frame, StreamOut* stream) {
+    OStream_writeUInt32(stream, 0xABCD1234);
+    return CODEC_OK;
+}
+#endif // CODEC_ENCODE
+
+static Stream_LenType   CFrame_Header_getLen(Codec* codec, Codec_Frame* frame, Codec_Phase phase) {
+    return sizeof(uint32_t);
+}
+static Codec_LayerImpl* CFrame_Header_nextLayer(Codec* codec, Codec_Frame* frame, Codec_Phase phase) {
+    return (Codec_LayerImpl*) &CFRAME_DATA_IMPL;
+}
+
+static Stream_LenType   CFrame_Data_getLen(Codec* codec, Codec_Frame* frame, Codec_Phase phase) {
+    return ((CFrame*) frame)->PacketSize;
+}
+static Codec_LayerImpl* CFrame_Data_nextLayer(Codec* codec, Codec_Frame* frame, Codec_Phase phase) {
+    return (Codec_LayerImpl*) &CFRAME_FOOTER_IMPL;
+}
+
+static Stream_LenType   CFrame_Footer_getLen(Codec* codec, Codec_Frame* frame, Codec_Phase phase) {
+    return sizeof(uint32_t);
+}
+static Codec_LayerImpl* CFrame_Footer_nextLayer(Codec* codec, Codec_Frame* frame, Codec_Phase phase) {
+    return CODEC_LAYER_NULL;
+}
+
+Codec_LayerImpl* CFrame_baseLayer(void) {
+    return (Codec_LayerImpl*) &CFRAME_HEADER_IMPL;
+}
@@ -0,0 +1,203 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <csignal>
+#include <memory>
+#include <vector>
+
+#include <sys/socket.h>
+#include <time.h>
+
+#include "CodecEpoll.hpp"
+#include "Frame/Packet.h"
+
+#define PRINTF                  printf
+#define PUTS                    puts
+
+/**
+ * @brief default number of connections
+ */
+#define CONNECTIONS             1000
+/**
+ * @brief default number of frames that each client send
+ */
+#define FRAMES                  200
+/**
+ * @brief biggest payload of frames
+ */
+#define MAX_PAYLOAD             96
+/**
+ * @brief stream buffers are smaller than two frames, so coroutines suspend often
+ */
+#define STREAM_SIZE             128
+
+using namespace codec::coro;
+
+/**
+ * @brief a side of a connection, channel with its codec, buffers and frames
+ */
+struct Peer {
+    explicit Peer(int fd) : Chan(fd, rxBuff, sizeof(rxBuff), txBuff, sizeof(txBuff)),
+                            Codec(Packet_baseLayer()) {
+        Packet_init(&Rx, rxData, sizeof(rxData));
+        Codec.beginDecode(&Rx);
+    }
+
+    uint8_t                 rxBuff[STREAM_SIZE];
+    uint8_t                 txBuff[STREAM_SIZE];
+    uint8_t                 rxData[MAX_PAYLOAD];
+    uint8_t                 txData[MAX_PAYLOAD];
+    Channel                 Chan;
+    AsyncCodec<Packet>      Codec;
+    Packet                  Rx;
+    Packet                  Tx;
+};
+
+/**
+ * @brief echo connection, server echo frames that client send
+ */
+struct Connection {
+    Connection(int clientFd, int serverFd) : Client(clientFd), Server(serverFd) {}
+
+    Peer                    Client;
+    Peer                    Server;
+    uint32_t                Sent = 0;
+    uint32_t                Received = 0;
+    uint32_t                Echoed = 0;
+};
+
+static EpollExecutor executor;
+static uint32_t frames = FRAMES;
+static uint32_t errors = 0;
+
+static uint32_t Frame_len(uint32_t conn, uint32_t index) {
+    return (conn * 7 + index * 13) % (MAX_PAYLOAD + 1);
+}
+static void Frame_fill(uint8_t* data, uint32_t len, uint32_t conn, uint32_t index) {
+    uint32_t i;
+    for (i = 0; i < len; i++) {
+        data[i] = (uint8_t) (conn + index + i);
+    }
+}
+
+Task Server_run(Connection& conn) {
+    Peer& peer = conn.Server;
+    Packet* frame;
+
+    while ((frame = co_await peer.Codec.decodeNext(peer.Chan.In)) != NULL) {
+        // echo frame back, payload copied because decoder reuse rx frame
+        memcpy(peer.txData, frame->Data, frame->Len);
+        Packet_init(&peer.Tx, peer.txData, frame->Len);
+        if (co_await peer.Codec.encode(&peer.Tx, peer.Chan.Out) != Codec_Status_Done) {
+            break;
+        }
+        conn.Echoed++;
+    }
+    // client closed connection
+    executor.remove(peer.Chan);
+    ::close(peer.Chan.Fd);
+}
+
+Task Client_send(Connection& conn, uint32_t id) {
+    Peer& peer = conn.Client;
+    uint32_t len;
+
+    while (conn.Sent < frames) {
+        len = Frame_len(id, conn.Sent);
+        Frame_fill(peer.txData, len, id, conn.Sent);
+        Packet_init(&peer.Tx, peer.txData, len);
+        if (co_await peer.Codec.encode(&peer.Tx, peer.Chan.Out) != Codec_Status_Done) {
+            errors++;
+            break;
+        }
+        conn.Sent++;
+    }
+}
+
+Task Client_receive(Connection& conn, uint32_t id) {
+    Peer& peer = conn.Client;
+    uint8_t expected[MAX_PAYLOAD];
+    Packet* frame;
+    uint32_t len;
+
+    while (conn.Received < frames) {
+        if ((frame = co_await peer.Codec.decodeNext(peer.Chan.In)) == NULL) {
+            errors++;
+            break;
+        }
+        len = Frame_len(id, conn.Received);
+        Frame_fill(expected, len, id, conn.Received);
+        if (frame->Len != len || memcmp(frame->Data, expected, len) != 0) {
+            errors++;
+        }
+        conn.Received++;
+    }
+    // all echoes received, close connection
+    executor.remove(peer.Chan);
+    ::close(peer.Chan.Fd);
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::unique_ptr<Connection>> conns;
+    uint32_t connections = CONNECTIONS;
+    uint64_t echoed = 0;
+    uint32_t i;
+    double start;
+    double elapsed;
+    int fds[2];
+
+    if (argc > 1) {
+        connections = (uint32_t) strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2) {
+        frames = (uint32_t) strtoul(argv[2], NULL, 0);
+    }
+    // closed peers reported by write error
+    signal(SIGPIPE, SIG_IGN);
+
+    PUTS("------- Codec Coroutine Echo -------");
+    if (!executor.valid()) {
+        PUTS("epoll failed");
+        return 1;
+    }
+    for (i = 0; i < connections; i++) {
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0) {
+            PRINTF("socketpair failed after %u connections\n", i);
+            connections = i;
+            break;
+        }
+        conns.emplace_back(new Connection(fds[0], fds[1]));
+        if (!executor.add(conns[i]->Client.Chan) || !executor.add(conns[i]->Server.Chan)) {
+            PUTS("add channel failed");
+            return 1;
+        }
+    }
+    PRINTF("Connections: %u, Frames: %u, Stream: %u B\n", connections, frames, STREAM_SIZE);
+
+    start = now();
+    for (i = 0; i < connections; i++) {
+        Server_run(*conns[i]);
+        Client_receive(*conns[i], i);
+        Client_send(*conns[i], i);
+    }
+    executor.run();
+    elapsed = now() - start;
+
+    for (i = 0; i < connections; i++) {
+        echoed += conns[i]->Echoed;
+        if (conns[i]->Received != frames) {
+            errors++;
+        }
+    }
+    PRINTF("Echoed %llu frames in %.3f s, %.0f frames/s\n", (unsigned long long) echoed, elapsed,
+           elapsed > 0 ? (double) echoed / elapsed : 0.0);
+    PRINTF("Echo Ended, %u Error Counts\n", errors);
+    return errors != 0;
+}
@@ -0,0 +1,209 @@
+#if !defined(_POSIX_C_SOURCE)
+    #define _POSIX_C_SOURCE     200112L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "Codec.h"
+#include "CodecMmap.h"
+#include "CodecParallel.h"
+#include "Frame/Packet.h"
+
+#if !CODEC_PARALLEL || !CODEC_DECODE_VIEW
+    #error "Codec-Parallel need CODEC_PARALLEL and CODEC_DECODE_VIEW"
+#endif
+
+#define PRINTF                  printf
+#define PUTS                    puts
+
+/**
+ * @brief default size of capture in MB
+ */
+#define CAPTURE_MB              2048
+/**
+ * @brief default path of capture, it's generated when size of it is not same
+ */
+#define CAPTURE_PATH            "/tmp/codec-capture.bin"
+/**
+ * @brief payload of frames is between 16 and 16 + PAYLOAD_RANGE bytes
+ */
+#define PAYLOAD_RANGE           1024
+/**
+ * @brief biggest frame of capture
+ */
+#define FRAME_MAX               (PACKET_HEADER_SIZE + 16 + PAYLOAD_RANGE + PACKET_FOOTER_SIZE)
+/**
+ * @brief stream window over mapping, fit biggest frame with noise
+ */
+#define WINDOW                  (4 * FRAME_MAX)
+/**
+ * @brief every Nth frame carry a frame as payload, so workers meet false frames
+ */
+#define NESTED_EVERY            8
+
+static uint32_t seed = 0x12345678;
+
+static uint32_t nextRandom(void) {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+/**
+ * @brief write a capture of frames with noise between them
+ */
+static int generate(const char* path, uint64_t size) {
+    static uint8_t payload[16 + PAYLOAD_RANGE];
+    static uint8_t nested[FRAME_MAX];
+    static uint8_t wire[FRAME_MAX];
+    static uint8_t txBuff[2 * FRAME_MAX];
+    uint8_t noise[8];
+    StreamOut ostream;
+    Codec codec;
+    Packet frame;
+    Stream_LenType nestedLen;
+    Stream_LenType len;
+    uint64_t written = 0;
+    uint64_t frames = 0;
+    uint32_t i;
+    FILE* file;
+
+    if ((file = fopen(path, "wb")) == NULL) {
+        return -1;
+    }
+    for (i = 0; i < sizeof(payload); i++) {
+        payload[i] = (uint8_t) nextRandom();
+    }
+    OStream_init(&ostream, NULL, txBuff, sizeof(txBuff));
+    Codec_init(&codec, Packet_baseLayer());
+    Packet_init(&frame, payload, 64);
+    Codec_encodeFrame(&codec, &frame, &ostream, Codec_EncodeMode_Normal);
+    nestedLen = OStream_pendingBytes(&ostream);
+    Stream_readBytes(&ostream.Buffer, nested, nestedLen);
+
+    while (written < size) {
+        len = nextRandom() % sizeof(noise);
+        for (i = 0; i < (uint32_t) len; i++) {
+            noise[i] = (uint8_t) nextRandom();
+        }
+        fwrite(noise, 1, (size_t) len, file);
+        written += (uint64_t) len;
+        if (++frames % NESTED_EVERY == 0) {
+            Packet_init(&frame, nested, nestedLen);
+        }
+        else {
+            Packet_init(&frame, payload, 16 + nextRandom() % PAYLOAD_RANGE);
+        }
+        Codec_encodeFrame(&codec, &frame, &ostream, Codec_EncodeMode_Normal);
+        len = OStream_pendingBytes(&ostream);
+        Stream_readBytes(&ostream.Buffer, wire, len);
+        fwrite(wire, 1, (size_t) len, file);
+        written += (uint64_t) len;
+    }
+    return fclose(file);
+}
+
+int main(int argc, char* argv[])
+{
+    static Packet frames[CODEC_PARALLEL_MAX_WORKERS];
+    Codec_Frame* pFrames[CODEC_PARALLEL_MAX_WORKERS];
+    Codec_IndexEntry* expected;
+    Codec_IndexEntry* index;
+    Codec_MmapFile file;
+    Codec codec;
+    struct stat st;
+    const char* path = CAPTURE_PATH;
+    uint64_t size = CAPTURE_MB;
+    uint32_t maxWorkers = (uint32_t) sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t workers;
+    uint32_t errors = 0;
+    int64_t count;
+    int64_t total;
+    double start;
+    double base;
+    double elapsed;
+
+    if (argc > 1) {
+        size = strtoull(argv[1], NULL, 0);
+    }
+    if (argc > 2) {
+        maxWorkers = (uint32_t) strtoul(argv[2], NULL, 0);
+    }
+    if (argc > 3) {
+        path = argv[3];
+    }
+    if (maxWorkers == 0 || maxWorkers > CODEC_PARALLEL_MAX_WORKERS) {
+        maxWorkers = CODEC_PARALLEL_MAX_WORKERS;
+    }
+    size *= 1024ULL * 1024ULL;
+
+    PUTS("------- Codec Parallel Decode -------");
+    if (stat(path, &st) != 0 || (uint64_t) st.st_size < size || (uint64_t) st.st_size > size + FRAME_MAX + 8) {
+        PRINTF("Generate %llu MB capture: %s\n", (unsigned long long) (size >> 20), path);
+        if (generate(path, size) != 0) {
+            PUTS("generate failed");
+            return 1;
+        }
+    }
+    if (Codec_MmapFile_open(&file, path, WINDOW) != 0) {
+        PUTS("open failed");
+        return 1;
+    }
+    Codec_init(&codec, Packet_baseLayer());
+    Codec_setDecodeSync(&codec, Packet_sync);
+    // payloads are not copied, so workers only parse headers and footers
+    Codec_setDecodeView(&codec, 1);
+    for (workers = 0; workers < CODEC_PARALLEL_MAX_WORKERS; workers++) {
+        Packet_init(&frames[workers], NULL, 16 + PAYLOAD_RANGE);
+        pFrames[workers] = (Codec_Frame*) &frames[workers];
+    }
+    PRINTF("Capture: %llu MB, Window: %u B, Huge Pages Advised: %u, Max Workers: %u\n",
+           (unsigned long long) (file.Size >> 20), (unsigned) WINDOW, file.HugeAdvised, maxWorkers);
+
+    // first pass count frames and load page cache
+    total = Codec_indexFile(&codec, pFrames[0], &file, NULL, 0);
+    expected = (Codec_IndexEntry*) malloc((size_t) total * sizeof(Codec_IndexEntry));
+    // margin for chunks that have more frames than average
+    index = (Codec_IndexEntry*) malloc((size_t) (total + total / 4 + maxWorkers) * sizeof(Codec_IndexEntry));
+    if (total < 0 || expected == NULL || index == NULL) {
+        PUTS("index failed");
+        return 1;
+    }
+
+    start = now();
+    Codec_indexFile(&codec, pFrames[0], &file, expected, (uint64_t) total);
+    base = now() - start;
+    PRINTF("%-12s %8.3f s %8.2f GB/s %12lld frames\n", "Sequential", base,
+           (double) file.Size / base / 1e9, (long long) total);
+
+    for (workers = 1; ; workers = workers * 2 < maxWorkers ? workers * 2 : maxWorkers) {
+        start = now();
+        count = Codec_decodeParallel(&codec, pFrames, workers, &file, index, (uint64_t) (total + total / 4 + maxWorkers));
+        elapsed = now() - start;
+        if (count != total || memcmp(index, expected, (size_t) total * sizeof(Codec_IndexEntry)) != 0) {
+            errors++;
+        }
+        PRINTF("%3u Workers  %8.3f s %8.2f GB/s %8.2fx %s\n", workers, elapsed,
+               (double) file.Size / elapsed / 1e9, base / elapsed, count == total ? "" : "mismatch");
+        if (workers == maxWorkers) {
+            break;
+        }
+    }
+    PRINTF("Parallel Ended, %u Error Counts\n", errors);
+
+    Codec_MmapFile_close(&file);
+    free(index);
+    free(expected);
+    return errors != 0;
+}
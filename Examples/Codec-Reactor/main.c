@@ -0,0 +1,285 @@
+#if !defined(_POSIX_C_SOURCE)
+    #define _POSIX_C_SOURCE     200112L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+#include "Codec.h"
+#include "CodecReactor.h"
+#include "Frame/Packet.h"
+
+#if !CODEC_REACTOR || !CODEC_ARGS
+    #error "Codec-Reactor need CODEC_REACTOR and CODEC_ARGS"
+#endif
+
+#define PRINTF                  printf
+#define PUTS                    puts
+
+/**
+ * @brief default number of connections
+ */
+#define CONNECTIONS             1000
+/**
+ * @brief default number of frames that each client send
+ */
+#define FRAMES                  200
+/**
+ * @brief default number of frames that each client keep in flight
+ */
+#define WINDOW                  4
+/**
+ * @brief payload of frames, first 8 bytes is send time
+ */
+#define PAYLOAD                 32
+/**
+ * @brief biggest window that output streams fit
+ */
+#define MAX_WINDOW              16
+/**
+ * @brief size of stream buffers
+ */
+#define STREAM_SIZE             (MAX_WINDOW * (PACKET_HEADER_SIZE + PAYLOAD + PACKET_FOOTER_SIZE))
+
+/**
+ * @brief a side of a connection
+ */
+typedef struct {
+    Codec_Connection        Conn;
+    Codec                   Codec;
+    Packet                  Rx;
+    Packet                  Tx;
+    struct __Pair*          Pair;
+    uint8_t                 rxBuff[STREAM_SIZE];
+    uint8_t                 txBuff[STREAM_SIZE];
+    uint8_t                 rxData[PAYLOAD];
+    uint8_t                 txData[PAYLOAD];
+} Peer;
+
+/**
+ * @brief client and server of a connection, server echo frames of client
+ */
+typedef struct __Pair {
+    Peer                    Client;
+    Peer                    Server;
+    uint32_t                Sent;
+    uint32_t                Received;
+} Pair;
+
+static Codec_Reactor reactor;
+static uint32_t frames = FRAMES;
+static uint32_t window = WINDOW;
+static uint32_t errors = 0;
+static uint64_t* samples;
+static uint64_t samplesLen = 0;
+
+static uint64_t now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+static int compareSample(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*) a;
+    uint64_t y = *(const uint64_t*) b;
+    return x < y ? -1 : x > y;
+}
+static uint64_t percentile(uint32_t permyriad) {
+    return samplesLen ? samples[(samplesLen - 1) * permyriad / 10000] : 0;
+}
+
+static void Client_send(Pair* pair) {
+    Peer* peer = &pair->Client;
+    uint64_t time = now();
+
+    memcpy(peer->txData, &time, sizeof(time));
+    memset(peer->txData + sizeof(time), (uint8_t) pair->Sent, PAYLOAD - sizeof(time));
+    Packet_init(&peer->Tx, peer->txData, PAYLOAD);
+    if (Codec_encodeFrame(&peer->Codec, (Codec_Frame*) &peer->Tx, &peer->Conn.Out, Codec_EncodeMode_Normal) != Codec_Status_Done) {
+        errors++;
+        return;
+    }
+    pair->Sent++;
+    Codec_Reactor_send(&peer->Conn);
+}
+static void Client_onDecode(Codec* codec, Codec_Frame* frame) {
+    Pair* pair = (Pair*) Codec_getArgs(codec);
+    Packet* packet = (Packet*) frame;
+    uint64_t time;
+
+    if (packet->Len != PAYLOAD || packet->Data[PAYLOAD - 1] != (uint8_t) pair->Received) {
+        errors++;
+    }
+    memcpy(&time, packet->Data, sizeof(time));
+    samples[samplesLen++] = now() - time;
+    pair->Received++;
+    if (pair->Sent < frames) {
+        Client_send(pair);
+    }
+    else if (pair->Received == frames) {
+        // all echoes received, close connection
+        Codec_Reactor_remove(&reactor, &pair->Client.Conn);
+        close(pair->Client.Conn.Fd);
+    }
+}
+static void Server_onDecode(Codec* codec, Codec_Frame* frame) {
+    Pair* pair = (Pair*) Codec_getArgs(codec);
+    Peer* peer = &pair->Server;
+
+    // echo frame back, rx frame encoded directly before it reused
+    if (Codec_encodeFrame(codec, frame, &peer->Conn.Out, Codec_EncodeMode_Normal) != Codec_Status_Done) {
+        errors++;
+    }
+    Codec_Reactor_send(&peer->Conn);
+}
+static void Server_onClose(Codec_Reactor* reactor, Codec_Connection* conn) {
+    (void) reactor;
+    close(conn->Fd);
+}
+
+static void Peer_init(Peer* peer, Pair* pair, int fd, Codec_OnFrameFn onDecode) {
+    peer->Pair = pair;
+    Codec_init(&peer->Codec, Packet_baseLayer());
+    Codec_setArgs(&peer->Codec, pair);
+    Codec_onDecode(&peer->Codec, onDecode);
+    Codec_setDecodeSync(&peer->Codec, Packet_sync);
+    Packet_init(&peer->Rx, peer->rxData, sizeof(peer->rxData));
+    Codec_beginDecode(&peer->Codec, (Codec_Frame*) &peer->Rx);
+    Codec_Connection_init(&peer->Conn, fd, &peer->Codec, peer->rxBuff, sizeof(peer->rxBuff),
+                          peer->txBuff, sizeof(peer->txBuff));
+    Codec_Connection_setArgs(&peer->Conn, pair);
+}
+/**
+ * @brief connect a socket pair over loopback tcp
+ */
+static int tcpPair(int listener, const struct sockaddr_in* addr, int fds[2]) {
+    int one = 1;
+
+    if ((fds[0] = socket(AF_INET, SOCK_STREAM, 0)) < 0) {
+        return -1;
+    }
+    if (connect(fds[0], (const struct sockaddr*) addr, sizeof(*addr)) < 0 ||
+        (fds[1] = accept(listener, NULL, NULL)) < 0) {
+        close(fds[0]);
+        return -1;
+    }
+    setsockopt(fds[0], IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    setsockopt(fds[1], IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return 0;
+}
+static int tcpListen(struct sockaddr_in* addr) {
+    socklen_t len = sizeof(*addr);
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+
+    memset(addr, 0, sizeof(*addr));
+    addr->sin_family = AF_INET;
+    addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (fd < 0 || bind(fd, (struct sockaddr*) addr, sizeof(*addr)) < 0 ||
+        listen(fd, 128) < 0 || getsockname(fd, (struct sockaddr*) addr, &len) < 0) {
+        return -1;
+    }
+    return fd;
+}
+
+int main(int argc, char* argv[])
+{
+    struct sockaddr_in addr;
+    Pair* pairs;
+    uint32_t connections = CONNECTIONS;
+    uint32_t i;
+    uint64_t start;
+    double elapsed;
+    int listener = -1;
+    int tcp = 0;
+    int arg = 0;
+    int fds[2];
+
+    for (i = 1; i < (uint32_t) argc; i++) {
+        if (strcmp(argv[i], "--tcp") == 0) {
+            tcp = 1;
+        }
+        else if (arg == 0) {
+            connections = (uint32_t) strtoul(argv[i], NULL, 0);
+            arg++;
+        }
+        else if (arg == 1) {
+            frames = (uint32_t) strtoul(argv[i], NULL, 0);
+            arg++;
+        }
+        else {
+            window = (uint32_t) strtoul(argv[i], NULL, 0);
+        }
+    }
+    if (window == 0 || window > MAX_WINDOW) {
+        window = MAX_WINDOW;
+    }
+    // closed peers reported by write error
+    signal(SIGPIPE, SIG_IGN);
+
+    PUTS("------- Codec Reactor Load -------");
+    pairs = (Pair*) calloc(connections, sizeof(Pair));
+    samples = (uint64_t*) malloc(((size_t) connections * frames + 1) * sizeof(uint64_t));
+    if (pairs == NULL || samples == NULL || Codec_Reactor_init(&reactor) < 0) {
+        PUTS("init failed");
+        return 1;
+    }
+    Codec_Reactor_onClose(&reactor, Server_onClose);
+    if (tcp && (listener = tcpListen(&addr)) < 0) {
+        PUTS("listen failed");
+        return 1;
+    }
+    for (i = 0; i < connections; i++) {
+        if ((tcp ? tcpPair(listener, &addr, fds) : socketpair(AF_UNIX, SOCK_STREAM, 0, fds)) < 0) {
+            PRINTF("connect failed after %u connections\n", i);
+            connections = i;
+            break;
+        }
+        Peer_init(&pairs[i].Client, &pairs[i], fds[0], Client_onDecode);
+        Peer_init(&pairs[i].Server, &pairs[i], fds[1], Server_onDecode);
+        if (Codec_Reactor_add(&reactor, &pairs[i].Client.Conn) < 0 ||
+            Codec_Reactor_add(&reactor, &pairs[i].Server.Conn) < 0) {
+            PUTS("add connection failed");
+            return 1;
+        }
+    }
+    PRINTF("Connections: %u, Frames: %u, Window: %u, Payload: %u B, Transport: %s\n",
+           connections, frames, window, PAYLOAD, tcp ? "tcp" : "unix");
+
+    start = now();
+    for (i = 0; i < connections; i++) {
+        while (pairs[i].Sent < window && pairs[i].Sent < frames) {
+            Client_send(&pairs[i]);
+        }
+    }
+    Codec_Reactor_run(&reactor);
+    elapsed = (double) (now() - start) / 1e9;
+
+    for (i = 0; i < connections; i++) {
+        if (pairs[i].Received != frames) {
+            errors++;
+        }
+    }
+    qsort(samples, (size_t) samplesLen, sizeof(uint64_t), compareSample);
+    PRINTF("Echoed %llu frames in %.3f s, %u connections x %.0f frames/s\n",
+           (unsigned long long) samplesLen, elapsed, connections,
+           elapsed > 0 ? (double) samplesLen / elapsed : 0.0);
+    PRINTF("Latency p50: %.1f us, p99: %.1f us, p999: %.1f us\n",
+           (double) percentile(5000) / 1e3, (double) percentile(9900) / 1e3, (double) percentile(9990) / 1e3);
+    PRINTF("Load Ended, %u Error Counts\n", errors);
+
+    if (listener >= 0) {
+        close(listener);
+    }
+    Codec_Reactor_deinit(&reactor);
+    free(samples);
+    free(pairs);
+    return errors != 0;
+}
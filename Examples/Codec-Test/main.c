@@ -1,5 +1,6 @@
 #include <stdio.h>
 
+#include <stddef.h>
 #include <string.h>
 #include "Codec.h"
 #include "StreamBuffer.h"
@@ -8,6 +9,39 @@
 
 #include "Frame/BasicFrame.h"
 #include "Frame/Packet.h"
+#include "Frame/PacketCrc.h"
+#if CODEC_CHECKSUM
+    #include "CodecChecksum.h"
+#endif
+#if CODEC_MMAP
+    #include "CodecMmap.h"
+    #include "CodecParallel.h"
+    #include <stdlib.h>
+    #include <unistd.h>
+#endif
+
+#if CODEC_TRACE
+    #include "CodecTrace.h"
+#endif
+#if CODEC_FD_STREAM
+    #include "CodecFd.h"
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/socket.h>
+#endif
+#if CODEC_ENCODE_GATHER && CODEC_ENCODE_GATHER_POSIX
+    #include "CodecSink.h"
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/socket.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+    #define TEST_THREADS        1
+    #include <pthread.h>
+#else
+    #define TEST_THREADS        0
+#endif
 
 #define PUTCHAR                 putchar
 #define PUTS                    puts
@@ -68,6 +102,77 @@ uint32_t Test_Async_Part(void);
 uint32_t Test_Frame_Size(void);
 uint32_t Test_Frame_CFrame(void);
 uint32_t Test_Buffer_CFrame(void);
+#if CODEC_LAYER_FIXED
+uint32_t Test_Fixed_CFrame(void);
+#endif
+#if CODEC_DECODE_RESYNC
+uint32_t Test_Frame_Noise_Resync_Packet(void);
+uint32_t Test_Async_Noise_Resync_Packet(void);
+#endif
+#if CODEC_DECODE_CHUNK
+uint32_t Test_Async_Chunk_Packet(void);
+#endif
+#if CODEC_DECODE_VIEW
+uint32_t Test_Frame_View_Packet(void);
+uint32_t Test_Async_View_Packet(void);
+#endif
+#if CODEC_DECODE_BATCH
+uint32_t Test_Batch_Packet(void);
+#endif
+#if CODEC_ENCODE_QUEUE
+uint32_t Test_Async_EncodeQueue_Packet(void);
+#endif
+#if CODEC_DECODE_QUEUE
+uint32_t Test_Async_DecodeQueue_Packet(void);
+#endif
+#if CODEC_DECODE_QUEUE && TEST_THREADS
+uint32_t Test_Async_DecodeQueue_Threads_Packet(void);
+#endif
+#if CODEC_ENCODE_GATHER
+uint32_t Test_Gather_Packet(void);
+#endif
+#if CODEC_ENCODE_GATHER && CODEC_ENCODE_GATHER_POSIX
+uint32_t Test_Sink_Packet(void);
+#endif
+#if CODEC_COMPILE
+uint32_t Test_Compile_Packet(void);
+#endif
+#if CODEC_STATS
+uint32_t Test_Stats_Packet(void);
+#endif
+#if CODEC_DECODE_LATENCY
+uint32_t Test_Async_Latency_Packet(void);
+#endif
+#if CODEC_TRACE
+uint32_t Test_Trace_Packet(void);
+#endif
+#if CODEC_PROTOCOL && CODEC_DECODE_ASYNC && CODEC_ENCODE_ASYNC
+uint32_t Test_Protocol_Packet(void);
+#endif
+#if CODEC_FULL_DUPLEX
+uint32_t Test_FullDuplex_Packet(void);
+#endif
+#if CODEC_FULL_DUPLEX && TEST_THREADS
+uint32_t Test_FullDuplex_Threads_Packet(void);
+#endif
+#if CODEC_FD_STREAM && CODEC_DECODE_ASYNC
+uint32_t Test_Fd_Packet(void);
+#endif
+#if CODEC_CRC
+uint32_t Test_Crc_Packet(void);
+#endif
+#if CODEC_CHECKSUM
+uint32_t Test_Checksum_SFrame(void);
+#endif
+#if CODEC_MMAP
+uint32_t Test_Mmap_Packet(void);
+#endif
+#if CODEC_PARALLEL
+uint32_t Test_Parallel_Packet(void);
+#endif
+#if CODEC_DECODE_FILTER
+uint32_t Test_Filter_Packet(void);
+#endif
 
 static const TestFn TESTS[] = {
     Test_Frame_BasicFrame,
@@ -86,6 +191,77 @@ static const TestFn TESTS[] = {
     Test_Frame_Size,
     Test_Frame_CFrame,
     Test_Buffer_CFrame,
+#if CODEC_LAYER_FIXED
+    Test_Fixed_CFrame,
+#endif
+#if CODEC_DECODE_RESYNC
+    Test_Frame_Noise_Resync_Packet,
+    Test_Async_Noise_Resync_Packet,
+#endif
+#if CODEC_DECODE_CHUNK
+    Test_Async_Chunk_Packet,
+#endif
+#if CODEC_DECODE_VIEW
+    Test_Frame_View_Packet,
+    Test_Async_View_Packet,
+#endif
+#if CODEC_DECODE_BATCH
+    Test_Batch_Packet,
+#endif
+#if CODEC_ENCODE_QUEUE
+    Test_Async_EncodeQueue_Packet,
+#endif
+#if CODEC_DECODE_QUEUE
+    Test_Async_DecodeQueue_Packet,
+#endif
+#if CODEC_DECODE_QUEUE && TEST_THREADS
+    Test_Async_DecodeQueue_Threads_Packet,
+#endif
+#if CODEC_ENCODE_GATHER
+    Test_Gather_Packet,
+#endif
+#if CODEC_ENCODE_GATHER && CODEC_ENCODE_GATHER_POSIX
+    Test_Sink_Packet,
+#endif
+#if CODEC_COMPILE
+    Test_Compile_Packet,
+#endif
+#if CODEC_STATS
+    Test_Stats_Packet,
+#endif
+#if CODEC_DECODE_LATENCY
+    Test_Async_Latency_Packet,
+#endif
+#if CODEC_TRACE
+    Test_Trace_Packet,
+#endif
+#if CODEC_PROTOCOL && CODEC_DECODE_ASYNC && CODEC_ENCODE_ASYNC
+    Test_Protocol_Packet,
+#endif
+#if CODEC_FULL_DUPLEX
+    Test_FullDuplex_Packet,
+#endif
+#if CODEC_FULL_DUPLEX && TEST_THREADS
+    Test_FullDuplex_Threads_Packet,
+#endif
+#if CODEC_FD_STREAM && CODEC_DECODE_ASYNC
+    Test_Fd_Packet,
+#endif
+#if CODEC_CRC
+    Test_Crc_Packet,
+#endif
+#if CODEC_CHECKSUM
+    Test_Checksum_SFrame,
+#endif
+#if CODEC_MMAP
+    Test_Mmap_Packet,
+#endif
+#if CODEC_PARALLEL
+    Test_Parallel_Packet,
+#endif
+#if CODEC_DECODE_FILTER
+    Test_Filter_Packet,
+#endif
 };
 static const uint32_t TESTS_LEN = sizeof(TESTS) / sizeof(TESTS[0]);
 
@@ -98,9 +274,20 @@ uint16_t line;
 Codec_Frame* pFrame;
 void Codec_onDecodeBasicFrame(Codec* codec, Codec_Frame* frame);
 void Codec_onDecodePacket(Codec* codec, Codec_Frame* frame);
+#if CODEC_DECODE_VIEW
+void Codec_onDecodeViewPacket(Codec* codec, Codec_Frame* frame);
+#endif
 void Codec_onDecodeErrorPacket(Codec* codec, Codec_Frame* frame, Codec_LayerImpl* layer, Codec_Error error);
 void Codec_onEncodePacket(Codec* codec, Codec_Frame* frame);
 void Codec_onEncodeErrorPacket(Codec* codec, Codec_Frame* frame, Codec_LayerImpl* layer, Codec_Error error);
+#if TEST_THREADS && (CODEC_FULL_DUPLEX || CODEC_DECODE_QUEUE)
+typedef struct {
+    Codec*              Codec;
+    StreamIn*           Stream;
+} DecodeThread;
+
+void* DecodeThread_run(void* arg);
+#endif
 
 int main()
 {
@@ -1560,26 +1747,2310 @@ uint32_t Test_Buffer_CFrame(void) {
     return 0;
 }
 
-// -------------------------- Assert Functions ------------------------
-void Codec_onDecodeBasicFrame(Codec* codec, Codec_Frame* frame) {
-    if ((errorCode = Assert_BasicFrame((BasicFrame*) pFrame, (BasicFrame*) frame, line, cycles, assert_index)) == 0) {
-        frameCount++;
-    }
-}
-void Codec_onDecodePacket(Codec* codec, Codec_Frame* frame) {
-    if ((errorCode = Assert_Packet((Packet*) pFrame, (Packet*) frame, line, cycles, assert_index)) == 0) {
-        frameCount++;
-    }
-}
-void Codec_onDecodeErrorPacket(Codec* codec, Codec_Frame* frame, Codec_LayerImpl* layer, Codec_Error error) {
-    errorCount++;
+#if CODEC_LAYER_FIXED
+// same as CFrame, but header and footer have only fixed fields, getLen/nextLayer never called
+static const Codec_LayerImpl FCFRAME_FOOTER_IMPL = {
+#if CODEC_DECODE
+    .parse = CFrame_Footer_parse,
+#endif
+#if CODEC_ENCODE
+    .write = CFrame_Footer_write,
+#endif
+    .Flags = CODEC_LAYER_STATIC,
+    .FixedLen = sizeof(uint32_t),
+    .FixedNext = CODEC_LAYER_NULL,
+};
+
+static const Codec_LayerImpl FCFRAME_DATA_IMPL = {
+#if CODEC_DECODE
+    .parse = CFrame_Data_parse,
+#endif
+#if CODEC_ENCODE
+    .write = CFrame_Data_write,
+#endif
+    .getLen = CFrame_Data_getLen,
+    .Flags = CODEC_LAYER_FIXED_NEXT,
+    .FixedNext = (Codec_LayerImpl*) &FCFRAME_FOOTER_IMPL,
+};
+
+static const Codec_LayerImpl FCFRAME_HEADER_IMPL = {
+#if CODEC_DECODE
+    .parse = CFrame_Header_parse,
+#endif
+#if CODEC_ENCODE
+    .write = CFrame_Header_write,
+#endif
+    .Flags = CODEC_LAYER_STATIC,
+    .FixedLen = sizeof(CFrame_Header),
+    .FixedNext = (Codec_LayerImpl*) &FCFRAME_DATA_IMPL,
+};
+
+uint32_t Test_Fixed_CFrame(void) {
+    #undef testCFrame
+    #define testCFrame(PAT, N)              PRINTF(#PAT " %dx\n", N);\
+                                            for (cycles = 0; cycles < CYCLES_NUM; cycles++) {\
+                                                CFrame_init(&frame, PAT, sizeof(PAT));\
+                                                assert(Num, Codec_frameSize(&codec, &frame, Codec_Phase_Encode), CFrame_len(&frame));\
+                                                for (assert_index = 0; assert_index < N; assert_index++) {\
+                                                    assert(Status, Codec_encodeFrame(&codec, &frame, &ostream, Codec_EncodeMode_Normal), Codec_Status_Done);\
+                                                }\
+                                                Stream_readStream(&ostream.Buffer, &istream.Buffer, OStream_pendingBytes(&ostream));\
+                                                for (assert_index = 0; assert_index < N; assert_index++) {\
+                                                    assert(Status, Codec_decodeFrame(&codec, &tempFrame, &istream), Codec_Status_Done);\
+                                                    assert(CFrame, &tempFrame, &frame);\
+                                                }\
+                                                assert(Status, Codec_encodeBuffer(&codec, &frame, buffer, CFrame_len(&frame)), Codec_Status_Done);\
+                                                assert(Status, Codec_decodeBuffer(&codec, &tempFrame, buffer, CFrame_len(&frame)), Codec_Status_Done);\
+                                                assert(CFrame, &tempFrame, &frame);\
+                                            }
+
+    static uint8_t PAT1[5] = {0x0A, 0x0B, 0x0C, 0x0D, 0x0E};
+    static uint8_t PAT2[3] = {0x1A, 0x1B, 0x1C};
+    static uint8_t PAT3[0x10] = {0};
+
+    StreamOut ostream;
+    StreamIn istream;
+    Codec codec;
+    CFrame frame;
+    CFrame tempFrame;
+
+    uint8_t txBuff[42];
+    uint8_t rxBuff[42];
+    uint8_t buffer[42];
+    uint8_t tempBuff[30];
+
+    OStream_init(&ostream, NULL, txBuff, sizeof(txBuff));
+    IStream_init(&istream, NULL, rxBuff, sizeof(rxBuff));
+    Codec_init(&codec, (Codec_LayerImpl*) &FCFRAME_HEADER_IMPL);
+    CFrame_init(&tempFrame, tempBuff, sizeof(tempBuff));
+
+    testCFrame(PAT1, 1);
+    testCFrame(PAT1, 3);
+    testCFrame(PAT2, 2);
+    testCFrame(PAT3, 1);
+
+#if CODEC_COMPILE
+    Codec_CompiledLayer chain[4];
+
+    assert(Num, Codec_compile(&codec, chain, 4), 4);
+    assert(Num, chain[0].Len, sizeof(CFrame_Header));
+    assert(Num, chain[1].Len, CODEC_LAYER_LEN_DYNAMIC);
+    assert(Num, chain[2].Len, sizeof(uint32_t));
+    assert(Num, chain[3].Layer == NULL, 1);
+    testCFrame(PAT1, 2);
+    testCFrame(PAT3, 1);
+#endif
+
+    return 0;
 }
-void Codec_onEncodePacket(Codec* codec, Codec_Frame* frame) {
-    frameCplt = 1;
+#endif // CODEC_LAYER_FIXED
+
+#if CODEC_DECODE_RESYNC
+uint32_t Test_Frame_Noise_Resync_Packet(void) {
+    #undef testPacket
+    #undef addNoise
+    #define addNoise(STREAM, N)             OStream_writePadding(STREAM, 0xFF, N)
+    #define testPacket(PAT, N, S)           PRINTF(#PAT " %dx - Noise: %d\n", N, S);\
+                                            for (cycles = 0; cycles < CYCLES_NUM; cycles++) {\
+                                                for (assert_index = 0; assert_index < N; assert_index++) {\
+                                                    Packet_init(&frame, PAT, sizeof(PAT));\
+                                                    addNoise(&ostream, S);\
+                                                    Codec_encodeFrame(&codec, &frame, &ostream, Codec_EncodeMode_Normal);\
+                                                }\
+                                                Stream_readStream(&ostream.Buffer, &istream.Buffer, OStream_pendingBytes(&ostream));\
+                                                errorCount = 0;\
+                                                for (assert_index = 0; assert_index < N; assert_index++) {\
+                                                    status = Codec_decodeFrame(&codec, &tempFrame, &istream);\
+                                                    assert(Status, status, Codec_Status_Done);\
+                                                    assert(Packet, &tempFrame, &frame);\
+                                                }\
+                                                assert(Num, errorCount, N);\
+                                            }
+
+    static uint8_t PAT1[5] = {0x0A, 0x0B, 0x0C, 0x0D, 0x0E};
+    static uint8_t PAT3[4] = {0x2A, 0x2B, 0x2C, 0x2D};
+    static uint8_t PAT5[6] = {0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F};
+
+    Codec_Status status;
+    StreamOut ostream;
+    StreamIn istream;
+    Codec codec;
+    Packet frame;
+    Packet tempFrame;
+
+    uint8_t txBuff[80];
+    uint8_t rxBuff[80];
+    uint8_t tempBuff[30];
+
+    OStream_init(&ostream, NULL, txBuff, sizeof(txBuff));
+    IStream_init(&istream, NULL, rxBuff, sizeof(rxBuff));
+    Codec_init(&codec, Packet_baseLayer());
+    Codec_onDecodeError(&codec, Codec_onDecodeErrorPacket);
+    Codec_setDecodeResync(&codec, Packet_sync);
+    Packet_init(&tempFrame, tempBuff, sizeof(tempBuff));
+
+    // each noise burst must cost a single parse error
+    testPacket(PAT1, 1, 1);
+    testPacket(PAT1, 1, 7);
+    testPacket(PAT1, 3, 3);
+    testPacket(PAT1, 3, 7);
+
+    testPacket(PAT3, 1, 1);
+    testPacket(PAT3, 1, 7);
+    testPacket(PAT3, 3, 3);
+    testPacket(PAT3, 3, 7);
+
+    testPacket(PAT5, 1, 1);
+    testPacket(PAT5, 1, 7);
+    testPacket(PAT5, 3, 3);
+    testPacket(PAT5, 3, 7);
+
+    return 0;
 }
-void Codec_onEncodeErrorPacket(Codec* codec, Codec_Frame* frame, Codec_LayerImpl* layer, Codec_Error error) {
-    PRINTF("[Encode Error] %u\n", error);
+uint32_t Test_Async_Noise_Resync_Packet(void) {
+    #undef testPacket
+    #define testPacket(PAT, N, S)           PRINTF(#PAT " %dx - Noise: %d\n", N, S);\
+                                            Codec_beginDecode(&codec, &tempFrame);\
+                                            pFrame = &frame;\
+                                            for (cycles = 0; cycles < CYCLES_NUM; cycles++) {\
+                                                for (assert_index = 0; assert_index < N; assert_index++) {\
+                                                    Packet_init(&frame, PAT, sizeof(PAT));\
+                                                    addNoise(&ostream, S);\
+                                                    Codec_encodeFrame(&codec, &frame, &ostream, Codec_EncodeMode_Normal);\
+                                                }\
+                                                Stream_readStream(&ostream.Buffer, &istream.Buffer, OStream_pendingBytes(&ostream));\
+                                                line = __LINE__;\
+                                                frameCount = 0;\
+                                                errorCount = 0;\
+                                                Codec_decode(&codec, &istream);\
+                                                assert(Num, frameCount, N);\
+                                                assert(Num, errorCount, N);\
+                                            }
+
+    static uint8_t PAT1[5] = {0x0A, 0x0B, 0x0C, 0x0D, 0x0E};
+    static uint8_t PAT3[4] = {0x2A, 0x2B, 0x2C, 0x2D};
+    static uint8_t PAT5[6] = {0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F};
+
+    StreamOut ostream;
+    StreamIn istream;
+    Codec codec;
+    Packet frame;
+    Packet tempFrame;
+
+    uint8_t txBuff[80];
+    uint8_t rxBuff[80];
+    uint8_t tempBuff[30];
+
+    OStream_init(&ostream, NULL, txBuff, sizeof(txBuff));
+    IStream_init(&istream, NULL, rxBuff, sizeof(rxBuff));
+    Codec_init(&codec, Packet_baseLayer());
+    Codec_onDecode(&codec, Codec_onDecodePacket);
+    Codec_onDecodeError(&codec, Codec_onDecodeErrorPacket);
+    Codec_setDecodeResync(&codec, Packet_sync);
+    Codec_setDecodeAll(&codec, 1);
+    Packet_init(&tempFrame, tempBuff, sizeof(tempBuff));
+
+    testPacket(PAT1, 1, 1);
+    testPacket(PAT1, 1, 7);
+    testPacket(PAT1, 3, 3);
+    testPacket(PAT1, 3, 7);
+
+    testPacket(PAT3, 1, 1);
+    testPacket(PAT3, 1, 7);
+    testPacket(PAT3, 3, 3);
+    testPacket(PAT3, 3, 7);
+
+    testPacket(PAT5, 1, 1);
+    testPacket(PAT5, 1, 7);
+    testPacket(PAT5, 3, 3);
+    testPacket(PAT5, 3, 7);
+
+    return 0;
 }
+#endif // CODEC_DECODE_RESYNC
+
+#if CODEC_DECODE_CHUNK
+uint32_t Test_Async_Chunk_Packet(void) {
+    #undef testPacket
+    #define testPacket(LEN, CHUNK)          PRINTF("Payload: %d, Chunk: %d\n", LEN, CHUNK);\
+                                            Codec_beginDecode(&codec, &tempFrame);\
+                                            pFrame = &frame;\
+                                            for (cycles = 0; cycles < CYCLES_NUM; cycles++) {\
+                                                for (assert_index = 0; assert_index < LEN; assert_index++) {\
+                                                    PAT[assert_index] = (uint8_t) (cycles + assert_index);\
+                                                }\
+                                                Packet_init(&frame, PAT, LEN);\
+                                                status = Codec_encodeBuffer(&codec, &frame, buffer, sizeof(buffer));\
+                                                assert(Status, status, Codec_Status_Done);\
+                                                line = __LINE__;\
+                                                frameCount = 0;\
+                                                offset = 0;\
+                                                while (offset < Packet_len(&frame)) {\
+                                                    len = Packet_len(&frame) - offset;\
+                                                    if (len > CHUNK) {\
+                                                        len = CHUNK;\
+                                                    }\
+                                                    if (len > IStream_space(&istream)) {\
+                                                        len = IStream_space(&istream);\
+                                                    }\
+                                                    Stream_writeBytes(&istream.Buffer, buffer + offset, len);\
+                                                    offset += len;\
+                                                    Codec_decode(&codec, &istream);\
+                                                }\
+                                                assert(Num, frameCount, 1);\
+                                            }
+
+    static uint8_t PAT[200];
+
+    Codec_Status status;
+    StreamIn istream;
+    Codec codec;
+    Packet frame;
+    Packet tempFrame;
+    uint32_t offset;
+    uint32_t len;
+
+    // payload is bigger than input stream buffer
+    uint8_t rxBuff[16];
+    uint8_t buffer[sizeof(PAT) + PACKET_HEADER_SIZE + PACKET_FOOTER_SIZE];
+    uint8_t tempBuff[sizeof(PAT)];
+
+    IStream_init(&istream, NULL, rxBuff, sizeof(rxBuff));
+    Codec_init(&codec, Packet_baseLayer());
+    Codec_onDecode(&codec, Codec_onDecodePacket);
+    Packet_init(&tempFrame, tempBuff, sizeof(tempBuff));
+
+    testPacket(20, 1);
+    testPacket(20, 5);
+    testPacket(20, 16);
+    testPacket(200, 1);
+    testPacket(200, 7);
+    testPacket(200, 16);
+
+    return 0;
+}
+#endif // CODEC_DECODE_CHUNK
+
+#if CODEC_DECODE_VIEW
+uint32_t Test_Frame_View_Packet(void) {
+    #undef testPacket
+    #define testPacket(PAT, N)              PRINTF(#PAT " %dx\n", N);\
+                                            pFrame = &frame;\
+                                            for (cycles = 0; cycles < CYCLES_NUM; cycles++) {\
+                                                for (assert_index = 0; assert_index < N; assert_index++) {\
+                                                    Packet_init(&frame, PAT, sizeof(PAT));\
+                                                    Codec_encodeFrame(&codec, &frame, &ostream, Codec_EncodeMode_Normal);\
+                                                }\
+                                                Stream_readStream(&ostream.Buffer, &istream.Buffer, OStream_pendingBytes(&ostream));\
+                                                line = __LINE__;\
+                                                frameCount = 0;\
+                                                for (assert_index = 0; assert_index < N; assert_index++) {\
+                                                    status = Codec_decodeFrame(&codec, &tempFrame, &istream);\
+                                                    assert(Status, status, Codec_Status_Done);\
+                                                }\
+                                                assert(Num, frameCount, N);\
+                                                assert(Num, IStream_available(&istream), 0);\
+                                            }
+
+    static uint8_t PAT1[5] = {0x0A, 0x0B, 0x0C, 0x0D, 0x0E};
+    static uint8_t PAT3[4] = {0x2A, 0x2B, 0x2C, 0x2D};
+    static uint8_t PAT5[6] = {0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F};
+
+    Codec_Status status;
+    StreamOut ostream;
+    StreamIn istream;
+    Codec codec;
+    Packet frame;
+    Packet tempFrame;
+
+    // odd buffer size, so payloads wrap around end of buffer
+    uint8_t txBuff[61];
+    uint8_t rxBuff[61];
+
+    OStream_init(&ostream, NULL, txBuff, sizeof(txBuff));
+    IStream_init(&istream, NULL, rxBuff, sizeof(rxBuff));
+    Codec_init(&codec, Packet_baseLayer());
+    Codec_onDecode(&codec, Codec_onDecodeViewPacket);
+    Codec_setDecodeView(&codec, 1);
+    // no data buffer, payload just viewed, size is max accepted payload length
+    Packet_init(&tempFrame, NULL, 30);
+
+    testPacket(PAT1, 1);
+    testPacket(PAT1, 3);
+    testPacket(PAT3, 1);
+    testPacket(PAT3, 3);
+    testPacket(PAT5, 1);
+    testPacket(PAT5, 3);
+
+    return 0;
+}
+uint32_t Test_Async_View_Packet(void) {
+    #undef testPacket
+    #undef addNoise
+    #define addNoise(STREAM, N)             OStream_writePadding(STREAM, 0xFF, N)
+    #define testPacket(PAT, N, S, CHUNK)    PRINTF(#PAT " %dx - Noise: %d, Chunk: %d\n", N, S, CHUNK);\
+                                            Codec_beginDecode(&codec, &tempFrame);\
+                                            pFrame = &frame;\
+                                            for (cycles = 0; cycles < CYCLES_NUM; cycles++) {\
+                                                for (assert_index = 0; assert_index < N; assert_index++) {\
+                                                    Packet_init(&frame, PAT, sizeof(PAT));\
+                                                    addNoise(&ostream, S);\
+                                                    Codec_encodeFrame(&codec, &frame, &ostream, Codec_EncodeMode_Normal);\
+                                                }\
+                                                line = __LINE__;\
+                                                frameCount = 0;\
+                                                while (OStream_pendingBytes(&ostream) > 0) {\
+                                                    len = OStream_pendingBytes(&ostream);\
+                                                    if (len > CHUNK) {\
+                                                        len = CHUNK;\
+                                                    }\
+                                                    Stream_readStream(&ostream.Buffer, &istream.Buffer, len);\
+                                                    Codec_decode(&codec, &istream);\
+                                                }\
+                                                assert(Num, frameCount, N);\
+                                                assert(Num, IStream_available(&istream), 0);\
+                                            }
+
+    static uint8_t PAT1[5] = {0x0A, 0x0B, 0x0C, 0x0D, 0x0E};
+    static uint8_t PAT3[4] = {0x2A, 0x2B, 0x2C, 0x2D};
+    static uint8_t PAT5[6] = {0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F};
+
+    StreamOut ostream;
+    StreamIn istream;
+    Codec codec;
+    Packet frame;
+    Packet tempFrame;
+    uint32_t len;
+
+    uint8_t txBuff[80];
+    uint8_t rxBuff[41];
+
+    OStream_init(&ostream, NULL, txBuff, sizeof(txBuff));
+    IStream_init(&istream, NULL, rxBuff, sizeof(rxBuff));
+    Codec_init(&codec, Packet_baseLayer());
+    Codec_onDecode(&codec, Codec_onDecodeViewPacket);
+    Codec_setDecodeSync(&codec, Packet_sync);
+    Codec_setDecodeAll(&codec, 1);
+    Codec_setDecodeView(&codec, 1);
+    // size is max accepted payload length
+    Packet_init(&tempFrame, NULL, 30);
+
+    testPacket(PAT1, 1, 3, 1);
+    testPacket(PAT1, 3, 3, 5);
+    testPacket(PAT1, 3, 7, 20);
+    testPacket(PAT3, 1, 3, 1);
+    testPacket(PAT3, 3, 3, 5);
+    testPacket(PAT3, 3, 7, 20);
+    testPacket(PAT5, 1, 3, 1);
+    testPacket(PAT5, 3, 3, 5);
+    testPacket(PAT5, 3, 7, 20);
+
+    return 0;
+}
+#endif // CODEC_DECODE_VIEW
+
+#if CODEC_DECODE_BATCH
+uint32_t Test_Batch_Packet(void) {
+    #undef testPacket
+    #undef addNoise
+    #define addNoise(STREAM, N)             OStream_writePadding(STREAM, 0xFF, N)
+    #define testPacket(PAT, N, S)           PRINTF(#PAT " %dx - Noise: %d\n", N, S);\
+                                            for (cycles = 0; cycles < CYCLES_NUM; cycles++) {\
+                                                for (assert_index = 0; assert_index < N; assert_index++) {\
+                                                    Packet_init(&frame, PAT, sizeof(PAT));\
+                                                    addNoise(&ostream, S);\
+                                                    Codec_encodeFrame(&codec, &frame, &ostream, Codec_EncodeMode_Normal);\
+                                                }\
+                                                /* keep last byte of last frame to check incomplete frame */\
+                                                Stream_readStream(&ostream.Buffer, &istream.Buffer, OStream_pendingBytes(&ostream) - 1);\
+                                                count = 0;\
+                                                errorCount = 0;\
+                                                while ((len = Codec_decodeBatch(&codec, frames, BATCH_SIZE, &istream)) > 0) {\
+                                                    for (assert_index = 0; assert_index < len; assert_index++) {\
+                                                        assert(Packet, (Packet*) frames[assert_index], &frame);\
+                                                    }\
+                                                    count += len;\
+                                                }\
+                                                assert_index = 0;\
+                                                assert(Num, count, N - 1);\
+                                                /* noise after a frame is synced, not reported as error */\
+                                                assert(Num, errorCount, 0);\
+                                                assert(Num, IStream_available(&istream), Packet_len(&frame) - 1);\
+                                                Stream_readStream(&ostream.Buffer, &istream.Buffer, 1);\
+                                                len = Codec_decodeBatch(&codec, frames, BATCH_SIZE, &istream);\
+                                                assert(Num, len, 1);\
+                                                assert(Packet, (Packet*) frames[0], &frame);\
+                                                assert(Num, IStream_available(&istream), 0);\
+                                            }
+
+    #define BATCH_SIZE                      4
+
+    static uint8_t PAT1[5] = {0x0A, 0x0B, 0x0C, 0x0D, 0x0E};
+    static uint8_t PAT3[4] = {0x2A, 0x2B, 0x2C, 0x2D};
+    static uint8_t PAT5[6] = {0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F};
+
+    StreamOut ostream;
+    StreamIn istream;
+    Codec codec;
+    Packet frame;
+    Packet tempFrames[BATCH_SIZE];
+    Codec_Frame* frames[BATCH_SIZE];
+    uint8_t tempBuff[BATCH_SIZE][30];
+    uint32_t count;
+    uint32_t len;
+
+    uint8_t txBuff[200];
+    uint8_t rxBuff[200];
+
+    OStream_init(&ostream, NULL, txBuff, sizeof(txBuff));
+    IStream_init(&istream, NULL, rxBuff, sizeof(rxBuff));
+    Codec_init(&codec, Packet_baseLayer());
+    Codec_setDecodeSync(&codec, Packet_sync);
+#if CODEC_DECODE_ERROR
+    Codec_onDecodeError(&codec, Codec_onDecodeErrorPacket);
+#endif
+    for (len = 0; len < BATCH_SIZE; len++) {
+        Packet_init(&tempFrames[len], tempBuff[len], sizeof(tempBuff[len]));
+        frames[len] = &tempFrames[len];
+    }
+
+    testPacket(PAT1, 1, 0);
+    testPacket(PAT1, 4, 3);
+    testPacket(PAT1, 7, 0);
+    testPacket(PAT3, 1, 3);
+    testPacket(PAT3, 5, 0);
+    testPacket(PAT3, 6, 5);
+    testPacket(PAT5, 1, 0);
+    testPacket(PAT5, 4, 5);
+    testPacket(PAT5, 7, 3);
+
+    return 0;
+}
+#endif // CODEC_DECODE_BATCH
+
+#if CODEC_ENCODE_QUEUE
+uint32_t Test_Async_EncodeQueue_Packet(void) {
+    #undef testPacket
+    #define testPacket(PAT, N)              PRINTF(#PAT " %dx\n", N);\
+                                            Codec_beginDecode(&codec, &tempFrame);\
+                                            pFrame = &frames[0];\
+                                            for (cycles = 0; cycles < CYCLES_NUM; cycles++) {\
+                                                line = __LINE__;\
+                                                frameCount = 0;\
+                                                for (assert_index = 0; assert_index < N; assert_index++) {\
+                                                    Packet_init(&frames[assert_index], PAT, sizeof(PAT));\
+                                                    assert(Status, Codec_EncodeQueue_push(&queue, &frames[assert_index]), Codec_Status_Done);\
+                                                }\
+                                                assert(Num, Codec_EncodeQueue_available(&queue), N);\
+                                                if (N == QUEUE_SIZE - 1) {\
+                                                    assert(Status, Codec_EncodeQueue_push(&queue, &frames[0]), Codec_Status_Pending);\
+                                                }\
+                                                for (len = 0; frameCount < N && len < 100; len++) {\
+                                                    Codec_encode(&codec, &ostream);\
+                                                    Stream_readStream(&ostream.Buffer, &istream.Buffer, OStream_pendingBytes(&ostream));\
+                                                    Codec_decode(&codec, &istream);\
+                                                }\
+                                                assert_index = 0;\
+                                                assert(Num, frameCount, N);\
+                                                assert(Num, Codec_EncodeQueue_available(&queue), 0);\
+                                            }
+
+    #define QUEUE_SIZE                      4
+
+    static uint8_t PAT1[5] = {0x0A, 0x0B, 0x0C, 0x0D, 0x0E};
+    static uint8_t PAT3[4] = {0x2A, 0x2B, 0x2C, 0x2D};
+    static uint8_t PAT5[6] = {0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F};
+
+    StreamOut ostream;
+    StreamIn istream;
+    Codec codec;
+    Codec_EncodeQueue queue;
+    Codec_Frame* queueSlots[QUEUE_SIZE];
+    Packet frames[QUEUE_SIZE - 1];
+    Packet tempFrame;
+    uint32_t len;
+
+    uint8_t txBuff[10];
+    uint8_t rxBuff[10];
+    uint8_t tempBuff[30];
+
+    OStream_init(&ostream, NULL, txBuff, sizeof(txBuff));
+    IStream_init(&istream, NULL, rxBuff, sizeof(rxBuff));
+    Codec_init(&codec, Packet_baseLayer());
+    Codec_onDecode(&codec, Codec_onDecodePacket);
+    Codec_setDecodeSync(&codec, Packet_sync);
+    Codec_setDecodeAll(&codec, 1);
+    Codec_EncodeQueue_init(&queue, queueSlots, QUEUE_SIZE);
+    Codec_setEncodeQueue(&codec, &queue);
+    Packet_init(&tempFrame, tempBuff, sizeof(tempBuff));
+
+    testPacket(PAT1, 1);
+    testPacket(PAT1, 3);
+    testPacket(PAT3, 1);
+    testPacket(PAT3, 2);
+    testPacket(PAT5, 1);
+    testPacket(PAT5, 3);
+
+    return 0;
+}
+#endif // CODEC_ENCODE_QUEUE
+
+#if CODEC_DECODE_QUEUE
+uint32_t Test_Async_DecodeQueue_Packet(void) {
+    #undef testPacket
+    #undef addNoise
+    #define addNoise(STREAM, N)             OStream_writePadding(STREAM, 0xFF, N)
+    #define testPacket(PAT, N, S)           PRINTF(#PAT " %dx - Noise: %d\n", N, S);\
+                                            for (cycles = 0; cycles < CYCLES_NUM; cycles++) {\
+                                                for (assert_index = 0; assert_index < N; assert_index++) {\
+                                                    Packet_init(&frame, PAT, sizeof(PAT));\
+                                                    addNoise(&ostream, S);\
+                                                    Codec_encodeFrame(&codec, &frame, &ostream, Codec_EncodeMode_Normal);\
+                                                }\
+                                                Stream_readStream(&ostream.Buffer, &istream.Buffer, OStream_pendingBytes(&ostream));\
+                                                count = 0;\
+                                                assert_index = 0;\
+                                                while (count < N) {\
+                                                    Codec_decode(&codec, &istream);\
+                                                    len = Codec_DecodeQueue_available(&queue);\
+                                                    assert(Num, len, N - count < QUEUE_SIZE - 1 ? N - count : QUEUE_SIZE - 1);\
+                                                    while ((pFrame = Codec_DecodeQueue_peek(&queue)) != NULL) {\
+                                                        assert(Packet, (Packet*) pFrame, &frame);\
+                                                        Codec_DecodeQueue_release(&queue);\
+                                                        count++;\
+                                                    }\
+                                                }\
+                                                assert(Num, count, N);\
+                                                assert(Num, IStream_available(&istream), 0);\
+                                            }
+
+    #define QUEUE_SIZE                      4
+
+    static uint8_t PAT1[5] = {0x0A, 0x0B, 0x0C, 0x0D, 0x0E};
+    static uint8_t PAT3[4] = {0x2A, 0x2B, 0x2C, 0x2D};
+    static uint8_t PAT5[6] = {0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F};
+
+    StreamOut ostream;
+    StreamIn istream;
+    Codec codec;
+    Codec_DecodeQueue queue;
+    Codec_Frame* queueSlots[QUEUE_SIZE];
+    Packet frame;
+    Packet tempFrames[QUEUE_SIZE];
+    uint8_t tempBuff[QUEUE_SIZE][30];
+    uint32_t count;
+    uint32_t len;
+
+    uint8_t txBuff[200];
+    uint8_t rxBuff[200];
+
+    OStream_init(&ostream, NULL, txBuff, sizeof(txBuff));
+    IStream_init(&istream, NULL, rxBuff, sizeof(rxBuff));
+    Codec_init(&codec, Packet_baseLayer());
+    Codec_setDecodeSync(&codec, Packet_sync);
+    Codec_setDecodeAll(&codec, 1);
+    for (len = 0; len < QUEUE_SIZE; len++) {
+        Packet_init(&tempFrames[len], tempBuff[len], sizeof(tempBuff[len]));
+        queueSlots[len] = &tempFrames[len];
+    }
+    Codec_DecodeQueue_init(&queue, queueSlots, QUEUE_SIZE);
+    Codec_setDecodeQueue(&codec, &queue);
+
+    testPacket(PAT1, 1, 0);
+    testPacket(PAT1, 3, 3);
+    testPacket(PAT1, 7, 0);
+    testPacket(PAT3, 2, 3);
+    testPacket(PAT3, 5, 0);
+    testPacket(PAT5, 1, 5);
+    testPacket(PAT5, 7, 3);
+
+    return 0;
+}
+#endif // CODEC_DECODE_QUEUE
+#if CODEC_DECODE_QUEUE && TEST_THREADS
+uint32_t Test_Async_DecodeQueue_Threads_Packet(void) {
+    #undef testPacket
+    #undef addNoise
+    #define addNoise(STREAM, N)             OStream_writePadding(STREAM, 0xFF, N)
+    #define testPacket(PAT, N, S)           PRINTF(#PAT " %dx - Noise: %d\n", N, S);\
+                                            for (cycles = 0; cycles < CYCLES_NUM; cycles++) {\
+                                                OStream_init(&ostream, NULL, txBuff, sizeof(txBuff));\
+                                                IStream_init(&istream, NULL, rxBuff, sizeof(rxBuff));\
+                                                Packet_init(&frame, PAT, sizeof(PAT));\
+                                                for (assert_index = 0; assert_index < N; assert_index++) {\
+                                                    addNoise(&ostream, S);\
+                                                    Codec_encodeFrame(&codec, &frame, &ostream, Codec_EncodeMode_Normal);\
+                                                }\
+                                                Stream_readStream(&ostream.Buffer, &istream.Buffer, OStream_pendingBytes(&ostream));\
+                                                result = 0;\
+                                                pthread_create(&rx, NULL, DecodeThread_run, &ctx);\
+                                                for (count = 0; count < N; ) {\
+                                                    if ((pFrame = Codec_DecodeQueue_peek(&queue)) != NULL) {\
+                                                        if (result == 0) {\
+                                                            result = Assert_Packet((Packet*) pFrame, &frame, __LINE__, cycles, count);\
+                                                        }\
+                                                        Codec_DecodeQueue_release(&queue);\
+                                                        count++;\
+                                                    }\
+                                                }\
+                                                pthread_join(rx, NULL);\
+                                                if (result) return result;\
+                                                assert(Num, Codec_DecodeQueue_available(&queue), 0);\
+                                                assert(Num, IStream_available(&istream), 0);\
+                                            }
+
+    #define QUEUE_SIZE                      4
+
+    static uint8_t PAT1[5] = {0x0A, 0x0B, 0x0C, 0x0D, 0x0E};
+    static uint8_t PAT5[6] = {0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F};
+    // whole input is received before rx thread start, consumer drain queue meanwhile
+    static uint8_t txBuff[2048];
+    static uint8_t rxBuff[2048];
+
+    StreamOut ostream;
+    StreamIn istream;
+    Codec codec;
+    Codec_DecodeQueue queue;
+    Codec_Frame* queueSlots[QUEUE_SIZE];
+    Packet frame;
+    Packet tempFrames[QUEUE_SIZE];
+    uint8_t tempBuff[QUEUE_SIZE][30];
+    DecodeThread ctx;
+    pthread_t rx;
+    uint32_t result;
+    uint32_t count;
+
+    Codec_init(&codec, Packet_baseLayer());
+    Codec_setDecodeSync(&codec, Packet_sync);
+    Codec_setDecodeAll(&codec, 1);
+    for (count = 0; count < QUEUE_SIZE; count++) {
+        Packet_init(&tempFrames[count], tempBuff[count], sizeof(tempBuff[count]));
+        queueSlots[count] = &tempFrames[count];
+    }
+    Codec_DecodeQueue_init(&queue, queueSlots, QUEUE_SIZE);
+    Codec_setDecodeQueue(&codec, &queue);
+    ctx.Codec = &codec;
+    ctx.Stream = &istream;
+
+    testPacket(PAT1, 50, 0);
+    testPacket(PAT1, 50, 3);
+    testPacket(PAT5, 100, 1);
+
+    return 0;
+}
+#endif // CODEC_DECODE_QUEUE && TEST_THREADS
+
+#if CODEC_ENCODE_GATHER
+uint32_t Test_Gather_Packet(void) {
+    #undef testPacket
+    #define testPacket(PAT, N)              PRINTF(#PAT " %dx\n", N);\
+                                            for (cycles = 0; cycles < CYCLES_NUM; cycles++) {\
+                                                Codec_Gather_reset(&gather);\
+                                                for (assert_index = 0; assert_index < N; assert_index++) {\
+                                                    Packet_init(&frame, PAT, sizeof(PAT));\
+                                                    assert(Status, Codec_encodeGather(&codec, &frame, &gather), Codec_Status_Done);\
+                                                    Codec_encodeFrame(&codec, &frame, &ostream, Codec_EncodeMode_Normal);\
+                                                }\
+                                                assert_index = 0;\
+                                                /* header and footer of neighbor frames merged */\
+                                                assert(Num, gather.Count, 2 * N + 1);\
+                                                assert(Num, (uint8_t*) gather.Vec[1].Data == PAT, 1);\
+                                                assert(Num, Codec_Gather_len(&gather), OStream_pendingBytes(&ostream));\
+                                                /* send vectors in small parts */\
+                                                while ((len = Codec_Gather_len(&gather)) > 0) {\
+                                                    if (len > 5) {\
+                                                        len = 5;\
+                                                    }\
+                                                    if (len > Codec_Gather_vec(&gather)->Len) {\
+                                                        len = Codec_Gather_vec(&gather)->Len;\
+                                                    }\
+                                                    Stream_readBytes(&ostream.Buffer, outBuff, len);\
+                                                    assert(Num, memcmp(Codec_Gather_vec(&gather)->Data, outBuff, len), 0);\
+                                                    Codec_Gather_consume(&gather, len);\
+                                                }\
+                                                assert(Num, OStream_pendingBytes(&ostream), 0);\
+                                            }
+
+    static uint8_t PAT1[5] = {0x0A, 0x0B, 0x0C, 0x0D, 0x0E};
+    static uint8_t PAT3[4] = {0x2A, 0x2B, 0x2C, 0x2D};
+    static uint8_t PAT5[6] = {0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F};
+
+    StreamOut ostream;
+    Codec codec;
+    Codec_Gather gather;
+    Codec_IoVec vec[8];
+    Packet frame;
+    uint32_t len;
+
+    uint8_t txBuff[80];
+    uint8_t scratch[64];
+    uint8_t outBuff[8];
+
+    OStream_init(&ostream, NULL, txBuff, sizeof(txBuff));
+    Codec_init(&codec, Packet_baseLayer());
+    Codec_Gather_init(&gather, vec, 8, scratch, sizeof(scratch));
+
+    testPacket(PAT1, 1);
+    testPacket(PAT1, 3);
+    testPacket(PAT3, 1);
+    testPacket(PAT3, 3);
+    testPacket(PAT5, 1);
+    testPacket(PAT5, 3);
+
+    // frame that not fit in vectors must not change gather
+    Codec_Gather_reset(&gather);
+    for (assert_index = 0; assert_index < 3; assert_index++) {
+        Packet_init(&frame, PAT1, sizeof(PAT1));
+        assert(Status, Codec_encodeGather(&codec, &frame, &gather), Codec_Status_Done);
+    }
+    len = Codec_Gather_len(&gather);
+    assert(Status, Codec_encodeGather(&codec, &frame, &gather), Codec_Status_Error);
+    assert(Num, gather.Count, 7);
+    assert(Num, Codec_Gather_len(&gather), len);
+
+    return 0;
+}
+#endif // CODEC_ENCODE_GATHER
+#if CODEC_ENCODE_GATHER && CODEC_ENCODE_GATHER_POSIX
+uint32_t Test_Sink_Packet(void) {
+    #undef testPacket
+    #define testPacket(N, SIZE)             PRINTF("Payload: %u, %dx\n", SIZE, N);\
+                                            for (cycles = 0; cycles < CYCLES_NUM; cycles++) {\
+                                                Codec_Gather_reset(&gather);\
+                                                Packet_init(&frame, payload, SIZE);\
+                                                for (assert_index = 0; assert_index < N; assert_index++) {\
+                                                    assert(Status, Codec_encodeGather(&codec, &frame, &gather), Codec_Status_Done);\
+                                                }\
+                                                assert_index = 0;\
+                                                total = Codec_Gather_len(&gather);\
+                                                received = 0;\
+                                                partial = 0;\
+                                                blocked = 0;\
+                                                while ((len = Codec_Gather_len(&gather)) > 0) {\
+                                                    /* writev and sendmsg both resume from consumed part of gather */\
+                                                    sent = (partial + blocked) & 1 ? Codec_Gather_sendmsg(&gather, fds[0], MSG_NOSIGNAL) :\
+                                                                                     Codec_Gather_writev(&gather, fds[0]);\
+                                                    assert(Num, sent >= 0, 1);\
+                                                    assert(Num, Codec_Gather_len(&gather), len - sent);\
+                                                    if (sent == 0) {\
+                                                        /* socket is full, drain it on other end */\
+                                                        blocked++;\
+                                                        while ((n = read(fds[1], &rxAll[received], sizeof(rxAll) - received)) > 0) {\
+                                                            received += (uint32_t) n;\
+                                                        }\
+                                                    }\
+                                                    else if (Codec_Gather_len(&gather) > 0) {\
+                                                        partial++;\
+                                                    }\
+                                                }\
+                                                while ((n = read(fds[1], &rxAll[received], sizeof(rxAll) - received)) > 0) {\
+                                                    received += (uint32_t) n;\
+                                                }\
+                                                assert(Num, received, total);\
+                                                assert(Num, partial > 0, 1);\
+                                                assert(Num, blocked > 0, 1);\
+                                                IStream_init(&istream, NULL, rxAll, sizeof(rxAll));\
+                                                Stream_moveWritePos(&istream.Buffer, received);\
+                                                for (assert_index = 0; assert_index < N; assert_index++) {\
+                                                    assert(Status, Codec_decodeFrame(&codec, &rxFrame, &istream), Codec_Status_Done);\
+                                                    assert(Packet, &rxFrame, &frame);\
+                                                }\
+                                                assert(Num, IStream_available(&istream), 0);\
+                                            }
+
+    #define SINK_PAYLOAD_SIZE               16384
+    // small socket buffers, so frames never fit and writes are partial
+    #define SINK_SOCKET_SIZE                4096
+
+    static uint8_t payload[SINK_PAYLOAD_SIZE];
+    static uint8_t rxPayload[SINK_PAYLOAD_SIZE];
+    static uint8_t rxAll[3 * (SINK_PAYLOAD_SIZE + PACKET_HEADER_SIZE + PACKET_FOOTER_SIZE)];
+
+    StreamIn istream;
+    Codec codec;
+    Codec_Gather gather;
+    Codec_IoVec vec[8];
+    Packet frame;
+    Packet rxFrame;
+    int fds[2];
+    int size = SINK_SOCKET_SIZE;
+    ssize_t sent;
+    ssize_t n;
+    uint32_t total;
+    uint32_t received;
+    uint32_t partial;
+    uint32_t blocked;
+    uint32_t len;
+    uint32_t i;
+
+    uint8_t scratch[64];
+
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0 ||
+        fcntl(fds[0], F_SETFL, O_NONBLOCK) < 0 || fcntl(fds[1], F_SETFL, O_NONBLOCK) < 0 ||
+        setsockopt(fds[0], SOL_SOCKET, SO_SNDBUF, &size, sizeof(size)) < 0 ||
+        setsockopt(fds[1], SOL_SOCKET, SO_RCVBUF, &size, sizeof(size)) < 0) {
+        PUTS("socketpair failed");
+        return 0;
+    }
+    for (i = 0; i < sizeof(payload); i++) {
+        payload[i] = (uint8_t) (i * 7);
+    }
+    Codec_init(&codec, Packet_baseLayer());
+    Codec_Gather_init(&gather, vec, 8, scratch, sizeof(scratch));
+    Packet_init(&rxFrame, rxPayload, sizeof(rxPayload));
+
+    testPacket(1, SINK_PAYLOAD_SIZE);
+    testPacket(3, SINK_PAYLOAD_SIZE);
+    testPacket(3, SINK_PAYLOAD_SIZE / 2);
+
+    close(fds[0]);
+    close(fds[1]);
+
+    return 0;
+}
+#endif // CODEC_ENCODE_GATHER_POSIX
+#if CODEC_COMPILE
+uint32_t Test_Compile_Packet(void) {
+    #undef testPacket
+    #define testPacket(PAT, N, S)           PRINTF(#PAT " %dx, Chain: %d\n", N, codec.ChainLen);\
+                                            Codec_beginDecode(&codec, &tempFrame);\
+                                            pFrame = &frame;\
+                                            for (cycles = 0; cycles < CYCLES_NUM; cycles++) {\
+                                                Packet_init(&frame, PAT, sizeof(PAT));\
+                                                assert(Num, Codec_frameSize(&codec, &frame, Codec_Phase_Encode), Packet_len(&frame));\
+                                                for (assert_index = 0; assert_index < N; assert_index++) {\
+                                                    assert(Status, Codec_encodeFrame(&codec, &frame, &ostream, Codec_EncodeMode_Normal), Codec_Status_Done);\
+                                                }\
+                                                Stream_readStream(&ostream.Buffer, &istream.Buffer, OStream_pendingBytes(&ostream));\
+                                                line = __LINE__;\
+                                                frameCount = 0;\
+                                                while (IStream_available(&istream) > 0) {\
+                                                    Stream_readStream(&istream.Buffer, &partStream.Buffer, IStream_available(&istream) < S ? IStream_available(&istream) : S);\
+                                                    Codec_decode(&codec, &partStream);\
+                                                }\
+                                                assert(Num, frameCount, N);\
+                                                assert(Status, Codec_encodeFrame(&codec, &frame, &ostream, Codec_EncodeMode_Normal), Codec_Status_Done);\
+                                                Stream_readStream(&ostream.Buffer, &istream.Buffer, OStream_pendingBytes(&ostream));\
+                                                assert(Status, Codec_decodeFrame(&codec, &tempFrame, &istream), Codec_Status_Done);\
+                                                assert(Packet, &tempFrame, &frame);\
+                                            }
+
+    static uint8_t PAT1[5] = {0x0A, 0x0B, 0x0C, 0x0D, 0x0E};
+    static uint8_t PAT2[3] = {0x1A, 0x1B, 0x1C};
+
+    Codec_CompiledLayer chain[4];
+    StreamOut ostream;
+    StreamIn istream;
+    StreamIn partStream;
+    Codec codec;
+    Packet frame;
+    Packet tempFrame;
+
+    uint8_t txBuff[80];
+    uint8_t rxBuff[80];
+    uint8_t partBuff[80];
+    uint8_t tempBuff[30];
+
+    OStream_init(&ostream, NULL, txBuff, sizeof(txBuff));
+    IStream_init(&istream, NULL, rxBuff, sizeof(rxBuff));
+    IStream_init(&partStream, NULL, partBuff, sizeof(partBuff));
+    Codec_init(&codec, Packet_baseLayer());
+    Codec_onDecode(&codec, Codec_onDecodePacket);
+    Codec_setDecodeAll(&codec, 1);
+    Packet_init(&tempFrame, tempBuff, sizeof(tempBuff));
+    cycles = 0;
+    assert_index = 0;
+
+    // header and footer are fixed, data length depend on frame
+    assert(Num, Codec_compile(&codec, chain, 4), 4);
+    assert(Num, chain[0].Layer == Packet_baseLayer(), 1);
+    assert(Num, chain[0].Len, PACKET_HEADER_SIZE);
+    assert(Num, chain[1].Len, CODEC_LAYER_LEN_DYNAMIC);
+    assert(Num, chain[2].Len, PACKET_FOOTER_SIZE);
+    assert(Num, chain[3].Layer == NULL, 1);
+
+    testPacket(PAT1, 1, 1);
+    testPacket(PAT1, 3, 3);
+    testPacket(PAT2, 2, 7);
+
+    // table without space for end of chain, footer next layer called
+    assert(Num, Codec_compile(&codec, chain, 3), 3);
+    testPacket(PAT1, 2, 5);
+    testPacket(PAT2, 3, 1);
+
+    // only base layer compiled
+    assert(Num, Codec_compile(&codec, chain, 1), 1);
+    testPacket(PAT1, 3, 2);
+    testPacket(PAT2, 1, 4);
+
+    return 0;
+}
+#endif // CODEC_COMPILE
+#if CODEC_STATS
+uint32_t Test_Stats_Packet(void) {
+    #undef testPacket
+    #define assertStats(STATS)              assert(Num, (STATS).Decode.Frames, 2);\
+                                            assert(Num, (STATS).Decode.Bytes, 3 * len - PACKET_FOOTER_SIZE);\
+                                            assert(Num, (STATS).Decode.Errors, 1);\
+                                            assert(Num, (STATS).SyncSkipped, 3 + PACKET_FOOTER_SIZE - 1);\
+                                            assert(Num, (STATS).ErrorDropped, 1);\
+                                            assert(Num, (STATS).Layers[0].Layer != NULL, 1);\
+                                            assert(Num, (STATS).Layers[0].DecodeErrors, 1);\
+                                            assert(Num, (STATS).Layers[1].Layer == NULL, 1);\
+                                            assert(Num, Codec_Stats_layer(&(STATS), Packet_baseLayer()) == NULL, 1);\
+                                            assert(Num, Codec_Stats_error(&(STATS), Packet_Error_FooterSign), 1);\
+                                            assert(Num, Codec_Stats_error(&(STATS), Packet_Error_FirstSign), 0);
+
+    static uint8_t PAT1[5] = {0x0A, 0x0B, 0x0C, 0x0D, 0x0E};
+
+    StreamIn istream;
+    Codec encoder;
+    Codec codec;
+    Codec_Stats stats;
+    Packet frame;
+    Packet rxFrame;
+    uint32_t len;
+    uint32_t i;
+
+    uint8_t txBuff[64];
+    uint8_t rxBuff[64];
+    uint8_t tempBuff[16];
+
+    Codec_init(&encoder, Packet_baseLayer());
+    Codec_init(&codec, Packet_baseLayer());
+    Codec_setDecodeSync(&codec, Packet_sync);
+    Packet_init(&frame, PAT1, sizeof(PAT1));
+    Packet_init(&rxFrame, tempBuff, sizeof(tempBuff));
+    len = Packet_len(&frame);
+    cycles = 0;
+    assert_index = 0;
+
+    // noise, frame, frame with wrong footer, frame
+    memset(txBuff, 0xFF, 3);
+    for (i = 0; i < 3; i++) {
+        assert(Status, Codec_encodeBuffer(&encoder, &frame, &txBuff[3 + i * len], len), Codec_Status_Done);
+    }
+    memset(&txBuff[3 + 2 * len - PACKET_FOOTER_SIZE], 0x00, PACKET_FOOTER_SIZE);
+    assert(Status, Codec_encodeBuffer(&encoder, &frame, tempBuff, len - 1), Codec_Status_Pending);
+    Codec_getStats(&encoder, &stats);
+    assert(Num, stats.Encode.Frames, 3);
+    assert(Num, stats.Encode.Bytes, 3 * len + PACKET_HEADER_SIZE + sizeof(PAT1));
+    assert(Num, stats.Encode.Errors, 0);
+    assert(Num, stats.Encode.Pending, 1);
+
+    PUTS("Frame");
+    IStream_init(&istream, NULL, rxBuff, sizeof(rxBuff));
+    Stream_writeBytes(&istream.Buffer, txBuff, 3 + 3 * len);
+    assert(Status, Codec_decodeFrame(&codec, &rxFrame, &istream), Codec_Status_Done);
+    assert(Status, Codec_decodeFrame(&codec, &rxFrame, &istream), Codec_Status_Done);
+    Codec_getStats(&codec, &stats);
+    assertStats(stats);
+    assert(Num, stats.Decode.Pending, 0);
+    // only noise, sync drop all of bytes
+    memset(tempBuff, 0xFF, 10);
+    Stream_writeBytes(&istream.Buffer, tempBuff, 10);
+    assert(Status, Codec_decodeFrame(&codec, &rxFrame, &istream), Codec_Status_Pending);
+    Codec_getStats(&codec, &stats);
+    assert(Num, stats.SyncSkipped, 3 + PACKET_FOOTER_SIZE - 1 + 10);
+    assert(Num, stats.Decode.Pending, 1);
+    Codec_resetStats(&codec);
+    Codec_getStats(&codec, &stats);
+    assert(Num, stats.Decode.Frames, 0);
+    assert(Num, stats.Layers[0].Layer == NULL, 1);
+
+    PUTS("Async");
+    IStream_init(&istream, NULL, rxBuff, sizeof(rxBuff));
+    Codec_setDecodeAll(&codec, 1);
+    Codec_beginDecode(&codec, &rxFrame);
+    for (i = 0; i < 3 + 3 * len; i += 5) {
+        Stream_writeBytes(&istream.Buffer, &txBuff[i], 3 + 3 * len - i < 5 ? 3 + 3 * len - i : 5);
+        Codec_decode(&codec, &istream);
+    }
+    Codec_getStats(&codec, &stats);
+    assertStats(stats);
+    assert(Num, stats.Decode.Pending > 0, 1);
+
+    return 0;
+}
+#endif // CODEC_STATS
+#if CODEC_DECODE_LATENCY
+static Codec_Tick latencyTick;
+
+static Codec_Tick Test_clock(Codec* codec) {
+    return latencyTick;
+}
+
+uint32_t Test_Async_Latency_Packet(void) {
+    #undef testPacket
+    // header received at begin, rest of frame received after DELAY ticks
+    #define testPacket(PAT, N, DELAY)       PRINTF(#PAT " %dx - Delay: %d\n", N, DELAY);\
+                                            for (assert_index = 0; assert_index < N; assert_index++) {\
+                                                Packet_init(&frame, PAT, sizeof(PAT));\
+                                                Codec_encodeFrame(&codec, &frame, &ostream, Codec_EncodeMode_Normal);\
+                                                Stream_readStream(&ostream.Buffer, &istream.Buffer, PACKET_HEADER_SIZE);\
+                                                Codec_decode(&codec, &istream);\
+                                                latencyTick += DELAY;\
+                                                Stream_readStream(&ostream.Buffer, &istream.Buffer, OStream_pendingBytes(&ostream));\
+                                                Codec_decode(&codec, &istream);\
+                                                latencyTick += 1000;\
+                                            }
+
+    static uint8_t PAT1[5] = {0x0A, 0x0B, 0x0C, 0x0D, 0x0E};
+
+    StreamOut ostream;
+    StreamIn istream;
+    Codec codec;
+    Codec_Histogram hist;
+    Packet frame;
+    Packet rxFrame;
+    uint8_t tempBuff[16];
+    uint32_t i;
+
+    uint8_t txBuff[64];
+    uint8_t rxBuff[64];
+    uint8_t noiseBuff[32];
+
+    cycles = 0;
+    assert_index = 0;
+    // buckets are exact for small values and 25% wide for big values
+    Codec_Histogram_reset(&hist);
+    for (i = 0; i < 8; i++) {
+        Codec_Histogram_add(&hist, i);
+    }
+    assert(Num, hist.Count, 8);
+    assert(Num, Codec_Histogram_p50(&hist), 3);
+    assert(Num, Codec_Histogram_percentile(&hist, 10000), 7);
+    Codec_Histogram_add(&hist, 1000);
+    assert(Num, Codec_Histogram_p50(&hist), 4);
+    assert(Num, Codec_Histogram_p99(&hist), 1000);
+    assert(Num, hist.Min, 0);
+    assert(Num, hist.Max, 1000);
+
+    OStream_init(&ostream, NULL, txBuff, sizeof(txBuff));
+    IStream_init(&istream, NULL, rxBuff, sizeof(rxBuff));
+    Codec_init(&codec, Packet_baseLayer());
+    Codec_setDecodeSync(&codec, Packet_sync);
+    Codec_setClock(&codec, Test_clock);
+    Packet_init(&rxFrame, tempBuff, sizeof(tempBuff));
+    Codec_beginDecode(&codec, &rxFrame);
+    latencyTick = 0;
+
+    testPacket(PAT1, 99, 30);
+    testPacket(PAT1, 1, 5000);
+    assert(Num, Codec_decodeLatency(&codec)->Count, 100);
+    assert(Num, Codec_decodeLatency(&codec)->Min, 30);
+    assert(Num, Codec_decodeLatency(&codec)->Max, 5000);
+    assert(Num, Codec_Histogram_p50(Codec_decodeLatency(&codec)), 31);
+    assert(Num, Codec_Histogram_p99(Codec_decodeLatency(&codec)), 31);
+    assert(Num, Codec_Histogram_p999(Codec_decodeLatency(&codec)), 5000);
+
+    // noise and failed frames are not measured
+    Codec_Histogram_reset(Codec_decodeLatency(&codec));
+    Packet_init(&frame, PAT1, sizeof(PAT1));
+    memset(noiseBuff, 0xFF, 5);
+    Codec_encodeBuffer(&codec, &frame, &noiseBuff[5], Packet_len(&frame));
+    memset(&noiseBuff[5 + Packet_len(&frame) - PACKET_FOOTER_SIZE], 0x00, PACKET_FOOTER_SIZE);
+    Stream_writeBytes(&istream.Buffer, noiseBuff, 5 + Packet_len(&frame));
+    Codec_decode(&codec, &istream);
+    assert(Num, Codec_decodeLatency(&codec)->Count, 0);
+    testPacket(PAT1, 1, 7);
+    assert(Num, Codec_decodeLatency(&codec)->Count, 1);
+    assert(Num, Codec_decodeLatency(&codec)->Min, 7);
+
+    return 0;
+}
+#endif // CODEC_DECODE_LATENCY
+#if CODEC_TRACE
+static char traceBuff[4096];
+static uint32_t traceLen;
+
+static void Test_traceWrite(void* args, const char* str, uint32_t len) {
+    if (traceLen + len < sizeof(traceBuff)) {
+        memcpy(&traceBuff[traceLen], str, len);
+        traceLen += len;
+        traceBuff[traceLen] = '\0';
+    }
+}
+
+uint32_t Test_Trace_Packet(void) {
+    #define assertTrace(INDEX, EVENT, PHASE, VALUE) \
+                                            assert_index = INDEX;\
+                                            assert(Num, Codec_Trace_get(&ring, INDEX)->Event, EVENT);\
+                                            assert(Num, Codec_Trace_get(&ring, INDEX)->Phase, PHASE);\
+                                            assert(Num, Codec_Trace_get(&ring, INDEX)->Value, VALUE);
+
+    static uint8_t PAT1[5] = {0x0A, 0x0B, 0x0C, 0x0D, 0x0E};
+    static Codec_TraceRing ring;
+    Codec_TraceRing* rings[1] = { &ring };
+
+    StreamIn istream;
+    Codec codec;
+    Packet frame;
+    Packet rxFrame;
+    // fit whole frame, it also encode frame with trace disabled
+    uint8_t tempBuff[32];
+    uint8_t rxBuff[64];
+    const char* str;
+    uint32_t len;
+    uint32_t count;
+
+    cycles = 0;
+    Codec_init(&codec, Packet_baseLayer());
+    Codec_setDecodeSync(&codec, Packet_sync);
+    Packet_init(&frame, PAT1, sizeof(PAT1));
+    Packet_init(&rxFrame, tempBuff, sizeof(tempBuff));
+    IStream_init(&istream, NULL, rxBuff, sizeof(rxBuff));
+    len = Packet_len(&frame);
+    Codec_Trace_initRing(&ring, 1);
+    Codec_Trace_setRing(&ring);
+
+    // noise, frame, frame with wrong footer
+    memset(rxBuff, 0xFF, 3);
+    Codec_encodeBuffer(&codec, &frame, &rxBuff[3], len);
+    Codec_encodeBuffer(&codec, &frame, &rxBuff[3 + len], len);
+    memset(&rxBuff[3 + 2 * len - PACKET_FOOTER_SIZE], 0x00, PACKET_FOOTER_SIZE);
+    Stream_moveWritePos(&istream.Buffer, 3 + 2 * len);
+    assert(Num, Codec_Trace_len(&ring), 12);
+    assertTrace(0, Codec_TraceEvent_Enter, Codec_Phase_Encode, PACKET_HEADER_SIZE);
+    assertTrace(1, Codec_TraceEvent_Exit, Codec_Phase_Encode, PACKET_HEADER_SIZE);
+    assertTrace(2, Codec_TraceEvent_Enter, Codec_Phase_Encode, sizeof(PAT1));
+    assertTrace(5, Codec_TraceEvent_Exit, Codec_Phase_Encode, PACKET_FOOTER_SIZE);
+
+    assert(Status, Codec_decodeFrame(&codec, &rxFrame, &istream), Codec_Status_Done);
+    assert(Num, Codec_Trace_len(&ring), 19);
+    assertTrace(12, Codec_TraceEvent_Sync, Codec_Phase_Decode, 3);
+    assertTrace(13, Codec_TraceEvent_Enter, Codec_Phase_Decode, PACKET_HEADER_SIZE);
+    assertTrace(18, Codec_TraceEvent_Exit, Codec_Phase_Decode, PACKET_FOOTER_SIZE);
+    assert(Status, Codec_decodeFrame(&codec, &rxFrame, &istream), Codec_Status_Error);
+    assertTrace(23, Codec_TraceEvent_Enter, Codec_Phase_Decode, PACKET_FOOTER_SIZE);
+    assertTrace(24, Codec_TraceEvent_Error, Codec_Phase_Decode, Packet_Error_FooterSign);
+    assertTrace(25, Codec_TraceEvent_Exit, Codec_Phase_Decode, 0);
+    assert(Num, Codec_Trace_len(&ring), 26);
+
+    // every enter event has an exit event in dump
+    traceLen = 0;
+    Codec_Trace_dump(rings, 1, 1, Test_traceWrite, NULL);
+    assert_index = 0;
+    assert(Num, strncmp(traceBuff, "{\"traceEvents\":[{", 17), 0);
+    assert(Num, strcmp(&traceBuff[traceLen - 3], "]}\n"), 0);
+    for (count = 0, str = traceBuff; (str = strstr(str, "\"ph\":\"B\"")) != NULL; str++, count++) {}
+    assert(Num, count, 12);
+    for (count = 0, str = traceBuff; (str = strstr(str, "\"ph\":\"E\"")) != NULL; str++, count++) {}
+    assert(Num, count, 12);
+
+    Codec_Trace_setRing(NULL);
+    assert(Status, Codec_encodeBuffer(&codec, &frame, tempBuff, len), Codec_Status_Done);
+    assert(Num, Codec_Trace_len(&ring), 26);
+
+    return 0;
+}
+#endif // CODEC_TRACE
+#if CODEC_PROTOCOL && CODEC_DECODE_ASYNC && CODEC_ENCODE_ASYNC
+uint32_t Test_Protocol_Packet(void) {
+    #undef testPacket
+    #define testPacket(PAT, N, S)           PRINTF(#PAT " %dx, Part: %d\n", N, S);\
+                                            pFrame = &frame;\
+                                            for (cycles = 0; cycles < CYCLES_NUM; cycles++) {\
+                                                Packet_init(&frame, PAT, sizeof(PAT));\
+                                                for (i = 0; i < 2; i++) {\
+                                                    for (assert_index = 0; assert_index < N; assert_index++) {\
+                                                        Codec_State_beginEncode(&txState);\
+                                                        do {\
+                                                            status = Codec_State_encode(&proto, &txState, (Codec_Frame*) &frame, &partOut);\
+                                                            Stream_readStream(&partOut.Buffer, &rxStream[i].Buffer, OStream_pendingBytes(&partOut));\
+                                                        } while (status == Codec_Status_Pending);\
+                                                        assert(Status, status, Codec_Status_Done);\
+                                                        assert(Num, Codec_State_isEncoding(&txState), 0);\
+                                                    }\
+                                                    assert(Num, IStream_available(&rxStream[i]), N * Packet_len(&frame));\
+                                                }\
+                                                line = __LINE__;\
+                                                frameCount = 0;\
+                                                while (IStream_available(&rxStream[0]) > 0 || IStream_available(&rxStream[1]) > 0) {\
+                                                    for (i = 0; i < 2; i++) {\
+                                                        Stream_readStream(&rxStream[i].Buffer, &partStream[i].Buffer, IStream_available(&rxStream[i]) < S ? IStream_available(&rxStream[i]) : S);\
+                                                        Codec_State_decode(&proto, &rxState[i], (Codec_Frame*) &tempFrame[i], &partStream[i]);\
+                                                    }\
+                                                }\
+                                                assert(Num, frameCount, 2 * N);\
+                                            }
+
+    static uint8_t PAT1[5] = {0x0A, 0x0B, 0x0C, 0x0D, 0x0E};
+    static uint8_t PAT2[3] = {0x1A, 0x1B, 0x1C};
+
+    Codec_LayerImpl* layers[3];
+    Codec_Protocol proto;
+    Codec_State rxState[2];
+    Codec_State txState;
+    Codec_Status status;
+    StreamOut ostream;
+    StreamOut partOut;
+    StreamIn rxStream[2];
+    StreamIn partStream[2];
+    Packet frame;
+    Packet tempFrame[2];
+    uint32_t i;
+
+    uint8_t txBuff[30];
+    uint8_t refBuff[30];
+    uint8_t partOutBuff[PACKET_HEADER_SIZE + 1];
+    uint8_t rxStreamBuff[2][80];
+    uint8_t partBuff[2][80];
+    uint8_t tempBuff[2][30];
+#if CODEC_DECODE_CHUNK
+    static uint8_t bigPat[60];
+    uint8_t bigBuff[sizeof(bigPat) + PACKET_HEADER_SIZE + PACKET_FOOTER_SIZE];
+    uint8_t tempBigBuff[2][sizeof(bigPat)];
+    uint32_t len;
+#endif
+
+    OStream_init(&ostream, NULL, txBuff, sizeof(txBuff));
+    OStream_init(&partOut, NULL, partOutBuff, sizeof(partOutBuff));
+    for (i = 0; i < 2; i++) {
+        IStream_init(&rxStream[i], NULL, rxStreamBuff[i], sizeof(rxStreamBuff[i]));
+        IStream_init(&partStream[i], NULL, partBuff[i], sizeof(partBuff[i]));
+        Packet_init(&tempFrame[i], tempBuff[i], sizeof(tempBuff[i]));
+        Codec_State_init(&rxState[i]);
+    }
+    Codec_State_init(&txState);
+    cycles = 0;
+    assert_index = 0;
+
+    // one protocol shared by all connections
+    Codec_Protocol_init(&proto, Packet_baseLayer(), layers, 3);
+    Codec_onDecode(Codec_Protocol_codec(&proto), Codec_onDecodePacket);
+    Packet_init(&frame, PAT1, sizeof(PAT1));
+    // layers with dynamic next layer must be added, added layers keep their index
+    assert(Num, Codec_Protocol_addLayer(&proto, Packet_baseLayer()), 0);
+    assert(Num, Codec_Protocol_addLayer(&proto, Packet_baseLayer()->nextLayer(Codec_Protocol_codec(&proto), (Codec_Frame*) &frame, Codec_Phase_Decode)), 1);
+    assert(Num, Codec_Protocol_addLayer(&proto, layers[1]->nextLayer(Codec_Protocol_codec(&proto), (Codec_Frame*) &frame, Codec_Phase_Decode)), 2);
+    assert(Num, proto.LayersLen, 3);
+    assert(Num, Codec_Protocol_indexOf(&proto, NULL), CODEC_LAYER_INDEX_END);
+    // state of a connection is only layer cursors
+#if CODEC_DECODE_CHUNK
+    assert(Num, sizeof(Codec_State) <= 2 * sizeof(Codec_LayerIndex) + sizeof(Stream_LenType), 1);
+#else
+    assert(Num, sizeof(Codec_State) <= 2 * sizeof(Codec_LayerIndex), 1);
+#endif
+    // nothing to encode
+    assert(Status, Codec_State_encode(&proto, &txState, (Codec_Frame*) &frame, &partOut), Codec_Status_Done);
+    assert(Num, OStream_pendingBytes(&partOut), 0);
+
+    testPacket(PAT1, 1, 1);
+    testPacket(PAT1, 2, 3);
+    testPacket(PAT2, 2, 4);
+    testPacket(PAT2, 3, 7);
+
+    // same bytes as codec encoder
+    Packet_init(&frame, PAT1, sizeof(PAT1));
+    Codec_State_beginEncode(&txState);
+    assert(Status, Codec_State_encode(&proto, &txState, (Codec_Frame*) &frame, &ostream), Codec_Status_Done);
+    OStream_init(&ostream, NULL, refBuff, sizeof(refBuff));
+    assert(Status, Codec_encodeFrame(Codec_Protocol_codec(&proto), (Codec_Frame*) &frame, &ostream, Codec_EncodeMode_Normal), Codec_Status_Done);
+    assert(Num, OStream_pendingBytes(&ostream), Packet_len(&frame));
+    assert(Num, memcmp(txBuff, refBuff, Packet_len(&frame)), 0);
+
+#if CODEC_DECODE_CHUNK
+    // chunk layer of payload bigger than stream buffer, connections interleaved
+    for (assert_index = 0; assert_index < sizeof(bigPat); assert_index++) {
+        bigPat[assert_index] = (uint8_t) assert_index;
+    }
+    Packet_init(&frame, bigPat, sizeof(bigPat));
+    OStream_init(&ostream, NULL, bigBuff, sizeof(bigBuff));
+    assert(Status, Codec_encodeFrame(Codec_Protocol_codec(&proto), (Codec_Frame*) &frame, &ostream, Codec_EncodeMode_Normal), Codec_Status_Done);
+    for (i = 0; i < 2; i++) {
+        IStream_init(&partStream[i], NULL, partBuff[i], 16);
+        Packet_init(&tempFrame[i], tempBigBuff[i], sizeof(tempBigBuff[i]));
+    }
+    pFrame = &frame;
+    line = __LINE__;
+    frameCount = 0;
+    for (len = 0; len < Packet_len(&frame); len += 7) {
+        for (i = 0; i < 2; i++) {
+            Stream_writeBytes(&partStream[i].Buffer, bigBuff + len, Packet_len(&frame) - len < 7 ? Packet_len(&frame) - len : 7);
+            status = Codec_State_decode(&proto, &rxState[i], (Codec_Frame*) &tempFrame[i], &partStream[i]);
+        }
+    }
+    assert(Status, status, Codec_Status_Done);
+    assert(Num, frameCount, 2);
+#endif
+#if CODEC_DECODE_VIEW
+    // features that keep frame state in base codec are rejected
+    Codec_setDecodeView(Codec_Protocol_codec(&proto), 1);
+    assert(Status, Codec_State_decode(&proto, &rxState[0], (Codec_Frame*) &tempFrame[0], &partStream[0]), Codec_Status_Error);
+    Codec_setDecodeView(Codec_Protocol_codec(&proto), 0);
+#endif
+#if CODEC_CHECKSUM
+    Codec_setEncodeChecksum(Codec_Protocol_codec(&proto), &CODEC_CHECKSUM_XOR);
+    Codec_State_beginEncode(&txState);
+    assert(Status, Codec_State_encode(&proto, &txState, (Codec_Frame*) &frame, &ostream), Codec_Status_Error);
+    Codec_setEncodeChecksum(Codec_Protocol_codec(&proto), NULL);
+#endif
+
+    return 0;
+}
+#endif // CODEC_PROTOCOL && CODEC_DECODE_ASYNC && CODEC_ENCODE_ASYNC
+#if CODEC_FULL_DUPLEX
+uint32_t Test_FullDuplex_Packet(void) {
+    #undef testPacket
+    #define testPacket(PAT, N, S)           PRINTF(#PAT " %dx\n", N);\
+                                            pFrame = &frame;\
+                                            for (cycles = 0; cycles < CYCLES_NUM; cycles++) {\
+                                                Packet_init(&frame, PAT, sizeof(PAT));\
+                                                frameCount = 0;\
+                                                line = __LINE__;\
+                                                for (assert_index = 0; assert_index < N; assert_index++) {\
+                                                    frameCplt = 0;\
+                                                    Codec_beginEncode(&codec, &frame, Codec_EncodeMode_Normal);\
+                                                    while (frameCplt == 0) {\
+                                                        Codec_encode(&codec, &ostream);\
+                                                        Stream_readStream(&ostream.Buffer, &istream.Buffer, OStream_pendingBytes(&ostream));\
+                                                        Codec_decode(&codec, &istream);\
+                                                    }\
+                                                }\
+                                                while (IStream_available(&istream) > 0) {\
+                                                    Codec_decode(&codec, &istream);\
+                                                }\
+                                                assert(Num, frameCount, N);\
+                                                frames += N;\
+                                            }
+
+    static uint8_t PAT1[5] = {0x0A, 0x0B, 0x0C, 0x0D, 0x0E};
+    static uint8_t PAT2[3] = {0x1A, 0x1B, 0x1C};
+
+    StreamOut ostream;
+    StreamIn istream;
+    Codec codec;
+    Packet frame;
+    Packet tempFrame;
+    uint32_t frames = 0;
+#if CODEC_STATS
+    Codec_Stats stats;
+#endif
+
+    uint8_t txBuff[10];
+    uint8_t rxBuff[40];
+    uint8_t tempBuff[30];
+
+    // decoder and encoder sides start new cache lines
+    assert(Num, offsetof(Codec, FreeStream) % CODEC_CACHE_LINE, 0);
+    assert(Num, offsetof(Codec, TxReserved) % CODEC_CACHE_LINE, 0);
+    assert(Num, offsetof(Codec, TxReserved) > offsetof(Codec, Rx), 1);
+    assert(Num, offsetof(Codec, Tx) > offsetof(Codec, TxReserved), 1);
+    assert(Num, sizeof(Codec) % CODEC_CACHE_LINE, 0);
+
+    OStream_init(&ostream, NULL, txBuff, sizeof(txBuff));
+    IStream_init(&istream, NULL, rxBuff, sizeof(rxBuff));
+    Codec_init(&codec, Packet_baseLayer());
+    Codec_onDecode(&codec, Codec_onDecodePacket);
+    Codec_onEncode(&codec, Codec_onEncodePacket);
+    Codec_setDecodeSync(&codec, Packet_sync);
+    Packet_init(&tempFrame, tempBuff, sizeof(tempBuff));
+    Codec_beginDecode(&codec, &tempFrame);
+    cycles = 0;
+    assert_index = 0;
+
+    testPacket(PAT1, 1, 1);
+    testPacket(PAT1, 2, 1);
+    testPacket(PAT2, 1, 1);
+    testPacket(PAT2, 3, 1);
+
+#if CODEC_STATS
+    // each side count into its own stats, snapshot merge them
+    assert(Num, codec.RxStats.Decode.Frames, frames);
+    assert(Num, codec.RxStats.Encode.Frames, 0);
+    assert(Num, codec.TxStats.Encode.Frames, frames);
+    assert(Num, codec.TxStats.Decode.Frames, 0);
+    Codec_getStats(&codec, &stats);
+    assert(Num, stats.Decode.Frames, frames);
+    assert(Num, stats.Encode.Frames, frames);
+    assert(Num, stats.Decode.Bytes, stats.Encode.Bytes);
+#endif
+
+    return 0;
+}
+#endif // CODEC_FULL_DUPLEX
+#if CODEC_FULL_DUPLEX && TEST_THREADS
+uint32_t Test_FullDuplex_Threads_Packet(void) {
+    #undef testPacket
+    #define testPacket(PAT, N)              PRINTF(#PAT " %dx\n", N);\
+                                            pFrame = &frame;\
+                                            for (cycles = 0; cycles < CYCLES_NUM; cycles++) {\
+                                                Packet_init(&frame, PAT, sizeof(PAT));\
+                                                OStream_init(&ostream, NULL, txBuff, sizeof(txBuff));\
+                                                IStream_init(&istream, NULL, rxBuff, sizeof(rxBuff));\
+                                                for (assert_index = 0; assert_index < N; assert_index++) {\
+                                                    Codec_encodeFrame(&peer, &frame, &ostream, Codec_EncodeMode_Normal);\
+                                                }\
+                                                len = OStream_pendingBytes(&ostream);\
+                                                Stream_readStream(&ostream.Buffer, &istream.Buffer, len);\
+                                                OStream_init(&ostream, NULL, txBuff, sizeof(txBuff));\
+                                                frameCount = 0;\
+                                                line = __LINE__;\
+                                                assert_index = 0;\
+                                                pthread_create(&rx, NULL, DecodeThread_run, &ctx);\
+                                                for (count = 0; count < N; count++) {\
+                                                    frameCplt = 0;\
+                                                    Codec_beginEncode(&codec, &frame, Codec_EncodeMode_Normal);\
+                                                    while (frameCplt == 0) {\
+                                                        Codec_encode(&codec, &ostream);\
+                                                    }\
+                                                }\
+                                                pthread_join(rx, NULL);\
+                                                assert(Num, frameCount, N);\
+                                                assert(Num, OStream_pendingBytes(&ostream), len);\
+                                                assert(Num, memcmp(txBuff, rxBuff, len), 0);\
+                                                frames += N;\
+                                            }
+
+    static uint8_t PAT1[5] = {0x0A, 0x0B, 0x0C, 0x0D, 0x0E};
+    static uint8_t PAT2[3] = {0x1A, 0x1B, 0x1C};
+    // whole input is received before rx thread start, tx side write same bytes meanwhile
+    static uint8_t txBuff[2048];
+    static uint8_t rxBuff[2048];
+
+    StreamOut ostream;
+    StreamIn istream;
+    Codec codec;
+    Codec peer;
+    Packet frame;
+    Packet tempFrame;
+    DecodeThread ctx;
+    pthread_t rx;
+    Stream_LenType len;
+    uint32_t count;
+    uint32_t frames = 0;
+
+    uint8_t tempBuff[30];
+
+    Codec_init(&peer, Packet_baseLayer());
+    Codec_init(&codec, Packet_baseLayer());
+    Codec_onDecode(&codec, Codec_onDecodePacket);
+    Codec_onEncode(&codec, Codec_onEncodePacket);
+    Codec_setDecodeSync(&codec, Packet_sync);
+    Packet_init(&tempFrame, tempBuff, sizeof(tempBuff));
+    Codec_beginDecode(&codec, &tempFrame);
+    ctx.Codec = &codec;
+    ctx.Stream = &istream;
+    cycles = 0;
+    assert_index = 0;
+
+    testPacket(PAT1, 64);
+    testPacket(PAT2, 100);
+
+#if CODEC_STATS
+    assert(Num, codec.RxStats.Decode.Frames, frames);
+    assert(Num, codec.TxStats.Encode.Frames, frames);
+#endif
+
+    return 0;
+}
+#endif // CODEC_FULL_DUPLEX && TEST_THREADS
+#if CODEC_FD_STREAM && CODEC_DECODE_ASYNC
+uint32_t Test_Fd_Packet(void) {
+    #undef testPacket
+    #define testPacket(PAT, N, MODE)        PRINTF(#PAT " %dx, Mode: %d\n", N, MODE);\
+                                            pFrame = &frame;\
+                                            for (cycles = 0; cycles < CYCLES_NUM; cycles++) {\
+                                                Packet_init(&frame, PAT, sizeof(PAT));\
+                                                line = __LINE__;\
+                                                frameCount = 0;\
+                                                for (assert_index = 0; assert_index < N; assert_index++) {\
+                                                    assert(Status, Codec_encodeFrame(&codec, &frame, &ostream, MODE), Codec_Status_Done);\
+                                                    if (MODE == Codec_EncodeMode_Normal) {\
+                                                        assert(Num, Codec_FdOut_flush(&ostream), Packet_len(&frame));\
+                                                    }\
+                                                    assert(Num, OStream_pendingBytes(&ostream), 0);\
+                                                    assert(Num, Codec_FdIn_decode(&codec, &istream), Packet_len(&frame));\
+                                                }\
+                                                assert(Num, frameCount, N);\
+                                                assert(Num, Codec_FdIn_read(&istream), 0);\
+                                            }
+
+    static uint8_t PAT1[5] = {0x0A, 0x0B, 0x0C, 0x0D, 0x0E};
+    static uint8_t PAT2[3] = {0x1A, 0x1B, 0x1C};
+
+    StreamOut ostream;
+    StreamIn istream;
+    Codec codec;
+    Packet frame;
+    Packet tempFrame;
+    int fds[2];
+
+    // buffers are not multiple of frames, so bytes wrap around end of buffers
+    uint8_t txBuff[23];
+    uint8_t rxBuff[19];
+    uint8_t tempBuff[30];
+
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0 ||
+        fcntl(fds[0], F_SETFL, O_NONBLOCK) < 0 || fcntl(fds[1], F_SETFL, O_NONBLOCK) < 0) {
+        PUTS("socketpair failed");
+        return 0;
+    }
+    Codec_FdOut_init(&ostream, fds[0], txBuff, sizeof(txBuff));
+    Codec_FdIn_init(&istream, fds[1], rxBuff, sizeof(rxBuff));
+    Codec_init(&codec, Packet_baseLayer());
+    Codec_onDecode(&codec, Codec_onDecodePacket);
+    Codec_setDecodeAll(&codec, 1);
+    Packet_init(&tempFrame, tempBuff, sizeof(tempBuff));
+    Codec_beginDecode(&codec, &tempFrame);
+    cycles = 0;
+    assert_index = 0;
+
+    assert(Num, Codec_Fd_get(&istream), fds[1]);
+    assert(Num, Codec_FdIn_read(&istream), 0);
+    assert(Num, Codec_FdOut_flush(&ostream), 0);
+
+    testPacket(PAT1, 1, Codec_EncodeMode_Normal);
+    testPacket(PAT1, 3, Codec_EncodeMode_Flush);
+    testPacket(PAT2, 2, Codec_EncodeMode_FlushLayer);
+    testPacket(PAT2, 3, Codec_EncodeMode_Normal);
+
+    // peer closed
+    close(fds[0]);
+    assert(Num, Codec_FdIn_read(&istream), CODEC_FD_CLOSED);
+    assert(Num, Codec_FdIn_decode(&codec, &istream), CODEC_FD_CLOSED);
+    close(fds[1]);
+
+    return 0;
+}
+#endif // CODEC_FD_STREAM
+#if CODEC_CRC
+uint32_t Test_Crc_Packet(void) {
+    #undef testPacket
+    #define testPacket(PAT, N)              PRINTF(#PAT " %dx\n", N);\
+                                            for (cycles = 0; cycles < CYCLES_NUM; cycles++) {\
+                                                for (assert_index = 0; assert_index < N; assert_index++) {\
+                                                    PacketCrc_init(&frame, PAT, sizeof(PAT));\
+                                                    assert(Status, Codec_encodeFrame(&codec, &frame, &ostream, Codec_EncodeMode_Normal), Codec_Status_Done);\
+                                                }\
+                                                Stream_readStream(&ostream.Buffer, &istream.Buffer, OStream_pendingBytes(&ostream));\
+                                                for (assert_index = 0; assert_index < N; assert_index++) {\
+                                                    assert(Status, Codec_decodeFrame(&codec, &tempFrame, &istream), Codec_Status_Done);\
+                                                    Packet_init(&expected, frame.Data, frame.Len);\
+                                                    Packet_init(&decoded, tempFrame.Data, tempFrame.Len);\
+                                                    assert(Packet, &decoded, &expected);\
+                                                }\
+                                            }
+
+    static uint8_t PAT1[5] = {0x0A, 0x0B, 0x0C, 0x0D, 0x0E};
+    static uint8_t PAT2[3] = {0x1A, 0x1B, 0x1C};
+    static uint8_t PAT3[0x40];
+    static const uint8_t CHECK[] = "123456789";
+
+    StreamOut ostream;
+    StreamIn istream;
+    Codec codec;
+    PacketCrc frame;
+    PacketCrc tempFrame;
+    Packet expected;
+    Packet decoded;
+    uint32_t crc;
+    uint32_t i;
+
+    // buffers are not multiple of frames, so bytes wrap around end of buffers
+    uint8_t txBuff[89];
+    uint8_t rxBuff[97];
+    uint8_t tempBuff[0x40];
+    uint8_t wire[PACKET_HEADER_SIZE + sizeof(PAT1) + PACKET_FOOTER_SIZE];
+
+    cycles = 0;
+    assert_index = 0;
+
+    // CRC32C check value and continue from previous bytes
+    assert(Num, Codec_crc32c(CODEC_CRC32C_INIT, CHECK, 9), 0xE3069283);
+    crc = Codec_crc32c(CODEC_CRC32C_INIT, CHECK, 4);
+    assert(Num, Codec_crc32c(crc, CHECK + 4, 5), 0xE3069283);
+    assert(Num, Codec_crc32cCopy(CODEC_CRC32C_INIT, tempBuff, CHECK, 9), 0xE3069283);
+    assert(Num, memcmp(tempBuff, CHECK, 9), 0);
+    for (i = 0; i < sizeof(PAT3); i++) {
+        PAT3[i] = (uint8_t) (i * 7 + 3);
+    }
+
+    OStream_init(&ostream, NULL, txBuff, sizeof(txBuff));
+    IStream_init(&istream, NULL, rxBuff, sizeof(rxBuff));
+    Codec_init(&codec, PacketCrc_baseLayer());
+    Codec_onDecodeError(&codec, Codec_onDecodeErrorPacket);
+    Codec_setDecodeSync(&codec, PacketCrc_sync);
+    PacketCrc_init(&tempFrame, tempBuff, sizeof(tempBuff));
+
+    testPacket(PAT1, 1);
+    testPacket(PAT1, 3);
+    testPacket(PAT2, 2);
+    testPacket(PAT3, 1);
+
+    // footer is CRC32C of header and data in big endian
+    PacketCrc_init(&frame, PAT1, sizeof(PAT1));
+    assert(Status, Codec_encodeFrame(&codec, &frame, &ostream, Codec_EncodeMode_Normal), Codec_Status_Done);
+    assert(Num, OStream_pendingBytes(&ostream), sizeof(wire));
+    Stream_readBytes(&ostream.Buffer, wire, sizeof(wire));
+    crc = Codec_crc32c(CODEC_CRC32C_INIT, wire, sizeof(wire) - PACKET_FOOTER_SIZE);
+    assert(Num, wire[sizeof(wire) - 4], (uint8_t) (crc >> 24));
+    assert(Num, wire[sizeof(wire) - 3], (uint8_t) (crc >> 16));
+    assert(Num, wire[sizeof(wire) - 2], (uint8_t) (crc >> 8));
+    assert(Num, wire[sizeof(wire) - 1], (uint8_t) crc);
+
+    // corrupted payload rejected, next frame decoded
+    errorCount = 0;
+    wire[PACKET_HEADER_SIZE + 2] ^= 0x10;
+    Stream_writeBytes(&istream.Buffer, wire, sizeof(wire));
+    wire[PACKET_HEADER_SIZE + 2] ^= 0x10;
+    Stream_writeBytes(&istream.Buffer, wire, sizeof(wire));
+    assert(Status, Codec_decodeFrame(&codec, &tempFrame, &istream), Codec_Status_Done);
+    assert(Num, errorCount, 1);
+    Packet_init(&expected, PAT1, sizeof(PAT1));
+    Packet_init(&decoded, tempFrame.Data, tempFrame.Len);
+    assert(Packet, &decoded, &expected);
+    assert(Num, IStream_available(&istream), 0);
+
+#if CODEC_DECODE_VIEW
+    // payload checksummed in place of stream buffer
+    Codec_setDecodeView(&codec, 1);
+    PacketCrc_init(&frame, PAT3, sizeof(PAT3));
+    assert(Status, Codec_encodeFrame(&codec, &frame, &ostream, Codec_EncodeMode_Normal), Codec_Status_Done);
+    Stream_readStream(&ostream.Buffer, &istream.Buffer, OStream_pendingBytes(&ostream));
+    assert(Status, Codec_decodeFrame(&codec, &tempFrame, &istream), Codec_Status_Done);
+    assert(Num, Codec_viewLen(&tempFrame.View), sizeof(PAT3));
+    assert(Num, tempFrame.Crc, frame.Crc);
+    Codec_setDecodeView(&codec, 0);
+#endif
+
+    return 0;
+}
+#endif // CODEC_CRC
+#if CODEC_CHECKSUM
+// --------------------- Checksum Custom Frame ---------------------
+typedef struct {
+    uint8_t*            Data;
+    uint16_t            Len;
+    uint16_t            Size;
+} SFrame;
+
+#if CODEC_DECODE
+static Codec_Error      SFrame_Header_parse(Codec* codec, Codec_Frame* frame, StreamIn* stream);
+static Codec_Error      SFrame_Data_parse(Codec* codec, Codec_Frame* frame, StreamIn* stream);
+static Codec_Error      SFrame_Footer_parse(Codec* codec, Codec_Frame* frame, StreamIn* stream);
+#endif // CODEC_DECODE
+
+#if CODEC_ENCODE
+static Codec_Error      SFrame_Header_write(Codec* codec, Codec_Frame* frame, StreamOut* stream);
+static Codec_Error      SFrame_Data_write(Codec* codec, Codec_Frame* frame, StreamOut* stream);
+static Codec_Error      SFrame_Footer_write(Codec* codec, Codec_Frame* frame, StreamOut* stream);
+#endif // CODEC_ENCODE
+
+static Stream_LenType   SFrame_Header_getLen(Codec* codec, Codec_Frame* frame, Codec_Phase phase);
+static Codec_LayerImpl* SFrame_Header_nextLayer(Codec* codec, Codec_Frame* frame, Codec_Phase phase);
+
+static Stream_LenType   SFrame_Data_getLen(Codec* codec, Codec_Frame* frame, Codec_Phase phase);
+static Codec_LayerImpl* SFrame_Data_nextLayer(Codec* codec, Codec_Frame* frame, Codec_Phase phase);
+
+static Stream_LenType   SFrame_Footer_getLen(Codec* codec, Codec_Frame* frame, Codec_Phase phase);
+static Codec_LayerImpl* SFrame_Footer_nextLayer(Codec* codec, Codec_Frame* frame, Codec_Phase phase);
+
+static const Codec_LayerImpl SFRAME_HEADER_IMPL = {
+#if CODEC_DECODE
+    SFrame_Header_parse,
+#endif
+#if CODEC_ENCODE
+    SFrame_Header_write,
+#endif
+    SFrame_Header_getLen,
+    SFrame_Header_nextLayer,
+};
+
+static const Codec_LayerImpl SFRAME_DATA_IMPL = {
+#if CODEC_DECODE
+    SFrame_Data_parse,
+#endif
+#if CODEC_ENCODE
+    SFrame_Data_write,
+#endif
+    SFrame_Data_getLen,
+    SFrame_Data_nextLayer,
+};
+
+static const Codec_LayerImpl SFRAME_FOOTER_IMPL = {
+#if CODEC_DECODE
+    SFrame_Footer_parse,
+#endif
+#if CODEC_ENCODE
+    SFrame_Footer_write,
+#endif
+    SFrame_Footer_getLen,
+    SFrame_Footer_nextLayer,
+};
+
+#if CODEC_DECODE
+static Codec_Error      SFrame_Header_parse(Codec* codec, Codec_Frame* frame, StreamIn* stream) {
+    SFrame* sFrame = (SFrame*) frame;
+    sFrame->Len = IStream_readUInt16(stream);
+    return sFrame->Len > sFrame->Size;
+}
+static Codec_Error      SFrame_Data_parse(Codec* codec, Codec_Frame* frame, StreamIn* stream) {
+    SFrame* sFrame = (SFrame*) frame;
+    IStream_readBytes(stream, sFrame->Data, sFrame->Len);
+    return CODEC_OK;
+}
+static Codec_Error      SFrame_Footer_parse(Codec* codec, Codec_Frame* frame, StreamIn* stream) {
+    // checksum of header and data layers
+    return IStream_readUInt32(stream) != Codec_decodeChecksum(codec);
+}
+#endif // CODEC_DECODE
+
+#if CODEC_ENCODE
+static Codec_Error      SFrame_Header_write(Codec* codec, Codec_Frame* frame, StreamOut* stream) {
+    OStream_writeUInt16(stream, ((SFrame*) frame)->Len);
+    return CODEC_OK;
+}
+static Codec_Error      SFrame_Data_write(Codec* codec, Codec_Frame* frame, StreamOut* stream) {
+    SFrame* sFrame = (SFrame*) frame;
+#if CODEC_ENCODE_GATHER
+    return Codec_writeRef(codec, stream, sFrame->Data, sFrame->Len);
+#else
+    OStream_writeBytes(stream, sFrame->Data, sFrame->Len);
+    return CODEC_OK;
+#endif
+}
+static Codec_Error      SFrame_Footer_write(Codec* codec, Codec_Frame* frame, StreamOut* stream) {
+    OStream_writeUInt32(stream, Codec_encodeChecksum(codec));
+    return CODEC_OK;
+}
+#endif // CODEC_ENCODE
+
+static Stream_LenType   SFrame_Header_getLen(Codec* codec, Codec_Frame* frame, Codec_Phase phase) {
+    return sizeof(uint16_t);
+}
+static Codec_LayerImpl* SFrame_Header_nextLayer(Codec* codec, Codec_Frame* frame, Codec_Phase phase) {
+    return (Codec_LayerImpl*) &SFRAME_DATA_IMPL;
+}
+
+static Stream_LenType   SFrame_Data_getLen(Codec* codec, Codec_Frame* frame, Codec_Phase phase) {
+    return ((SFrame*) frame)->Len;
+}
+static Codec_LayerImpl* SFrame_Data_nextLayer(Codec* codec, Codec_Frame* frame, Codec_Phase phase) {
+    return (Codec_LayerImpl*) &SFRAME_FOOTER_IMPL;
+}
+
+static Stream_LenType   SFrame_Footer_getLen(Codec* codec, Codec_Frame* frame, Codec_Phase phase) {
+    return sizeof(uint32_t);
+}
+static Codec_LayerImpl* SFrame_Footer_nextLayer(Codec* codec, Codec_Frame* frame, Codec_Phase phase) {
+    return CODEC_LAYER_NULL;
+}
+
+void SFrame_init(SFrame* frame, uint8_t* data, uint16_t size) {
+    frame->Data = data;
+    frame->Len = size;
+    frame->Size = size;
+}
+
+uint32_t SFrame_len(SFrame* frame) {
+    return frame->Len + sizeof(uint16_t) + sizeof(uint32_t);
+}
+
+Codec_LayerImpl* SFrame_baseLayer(void) {
+    return (Codec_LayerImpl*) &SFRAME_HEADER_IMPL;
+}
+
+void Codec_onDecodeSFrame(Codec* codec, Codec_Frame* frame) {
+    frameCount++;
+}
+
+uint32_t Test_Checksum_SFrame(void) {
+    #undef testSFrame
+    #define testSFrame(PAT, N)              PRINTF(#PAT " %dx, Checksum: %u\n", N, (unsigned) impl);\
+                                            for (cycles = 0; cycles < CYCLES_NUM; cycles++) {\
+                                                for (assert_index = 0; assert_index < N; assert_index++) {\
+                                                    SFrame_init(&frame, PAT, sizeof(PAT));\
+                                                    assert(Status, Codec_encodeFrame(&codec, &frame, &ostream, Codec_EncodeMode_Normal), Codec_Status_Done);\
+                                                }\
+                                                Stream_readStream(&ostream.Buffer, &istream.Buffer, OStream_pendingBytes(&ostream));\
+                                                for (assert_index = 0; assert_index < N; assert_index++) {\
+                                                    assert(Status, Codec_decodeFrame(&codec, &tempFrame, &istream), Codec_Status_Done);\
+                                                    assert(Num, tempFrame.Len, sizeof(PAT));\
+                                                    assert(Num, memcmp(tempFrame.Data, PAT, sizeof(PAT)), 0);\
+                                                    assert(Num, Codec_decodeChecksum(&codec), Codec_encodeChecksum(&codec));\
+                                                }\
+                                            }
+
+    static uint8_t PAT1[5] = {0x0A, 0x0B, 0x0C, 0x0D, 0x0E};
+    static uint8_t PAT2[3] = {0x1A, 0x1B, 0x1C};
+    static uint8_t PAT3[0x30];
+    static const uint8_t CHECK[] = "123456789";
+    static const Codec_ChecksumImpl* IMPLS[] = {
+        &CODEC_CHECKSUM_XOR,
+        &CODEC_CHECKSUM_FLETCHER16,
+        &CODEC_CHECKSUM_CRC16,
+        &CODEC_CHECKSUM_CRC32,
+    #if CODEC_CRC
+        &CODEC_CHECKSUM_CRC32C,
+    #endif
+    };
+    static const uint32_t CHECK_VALUES[] = {
+        0x31,
+        0x1EDE,
+        0x29B1,
+        0xCBF43926,
+    #if CODEC_CRC
+        0xE3069283,
+    #endif
+    };
+
+    StreamOut ostream;
+    StreamIn istream;
+    Codec codec;
+    SFrame frame;
+    SFrame tempFrame;
+    uint32_t impl;
+    uint32_t sum;
+    uint32_t i;
+
+    // buffers are not multiple of frames, so bytes wrap around end of buffers
+    uint8_t txBuff[61];
+    uint8_t rxBuff[67];
+    uint8_t tempBuff[0x30];
+    uint8_t wire[sizeof(uint16_t) + sizeof(PAT1) + sizeof(uint32_t)];
+#if CODEC_ENCODE_GATHER
+    Codec_Gather gather;
+    Codec_IoVec vec[8];
+    uint8_t scratch[32];
+    uint8_t flat[sizeof(wire)];
+    Stream_LenType len;
+#endif
+
+    cycles = 0;
+    assert_index = 0;
+    for (i = 0; i < sizeof(PAT3); i++) {
+        PAT3[i] = (uint8_t) (i * 13 + 5);
+    }
+
+    OStream_init(&ostream, NULL, txBuff, sizeof(txBuff));
+    IStream_init(&istream, NULL, rxBuff, sizeof(rxBuff));
+    Codec_init(&codec, SFrame_baseLayer());
+    Codec_onDecode(&codec, Codec_onDecodeSFrame);
+    Codec_onDecodeError(&codec, Codec_onDecodeErrorPacket);
+    Codec_onEncode(&codec, Codec_onEncodePacket);
+    SFrame_init(&tempFrame, tempBuff, sizeof(tempBuff));
+
+    for (impl = 0; impl < sizeof(IMPLS) / sizeof(IMPLS[0]); impl++) {
+        // check value and continue from previous bytes
+        assert_index = (uint8_t) impl;
+        assert(Num, IMPLS[impl]->update(IMPLS[impl]->Init, CHECK, 9), CHECK_VALUES[impl]);
+        sum = IMPLS[impl]->update(IMPLS[impl]->Init, CHECK, 4);
+        assert(Num, IMPLS[impl]->update(sum, CHECK + 4, 5), CHECK_VALUES[impl]);
+
+        Codec_setDecodeChecksum(&codec, IMPLS[impl]);
+        Codec_setEncodeChecksum(&codec, IMPLS[impl]);
+
+        testSFrame(PAT1, 1);
+        testSFrame(PAT1, 3);
+        testSFrame(PAT2, 2);
+        testSFrame(PAT3, 1);
+
+        // after frame, checksum cover all layers of frame, footer included
+        SFrame_init(&frame, PAT1, sizeof(PAT1));
+        assert(Status, Codec_encodeFrame(&codec, &frame, &ostream, Codec_EncodeMode_Normal), Codec_Status_Done);
+        assert(Num, OStream_pendingBytes(&ostream), sizeof(wire));
+        Stream_readBytes(&ostream.Buffer, wire, sizeof(wire));
+        assert(Num, Codec_encodeChecksum(&codec), IMPLS[impl]->update(IMPLS[impl]->Init, wire, sizeof(wire)));
+
+        // layers committed in parts by async encoder and decoder
+        frameCount = 0;
+        Codec_beginDecode(&codec, &tempFrame);
+        for (cycles = 0; cycles < CYCLES_NUM; cycles++) {
+            SFrame_init(&frame, PAT3, sizeof(PAT3));
+            frameCplt = 0;
+            Codec_beginEncode(&codec, &frame, Codec_EncodeMode_Normal);
+            while (frameCplt == 0) {
+                Codec_encode(&codec, &ostream);
+                Stream_readStream(&ostream.Buffer, &istream.Buffer, OStream_pendingBytes(&ostream));
+                Codec_decode(&codec, &istream);
+            }
+            assert(Num, frameCount, cycles + 1);
+            assert(Num, memcmp(tempFrame.Data, PAT3, sizeof(PAT3)), 0);
+        }
+        cycles = 0;
+
+    #if CODEC_ENCODE_GATHER
+        // referenced payload added into checksum without copy
+        Codec_Gather_init(&gather, vec, 8, scratch, sizeof(scratch));
+        SFrame_init(&frame, PAT1, sizeof(PAT1));
+        assert(Status, Codec_encodeGather(&codec, &frame, &gather), Codec_Status_Done);
+        assert(Num, Codec_Gather_len(&gather), sizeof(flat));
+        i = 0;
+        while ((len = Codec_Gather_len(&gather)) > 0) {
+            len = Codec_Gather_vec(&gather)->Len;
+            memcpy(&flat[i], Codec_Gather_vec(&gather)->Data, len);
+            Codec_Gather_consume(&gather, len);
+            i += len;
+        }
+        assert(Num, memcmp(flat, wire, sizeof(wire)), 0);
+    #endif
+
+        // corrupted payload rejected
+        errorCount = 0;
+        wire[sizeof(uint16_t) + 2] ^= 0x10;
+        assert(Num, Codec_decodeBuffer(&codec, &tempFrame, wire, sizeof(wire)) != Codec_Status_Done, 1);
+        assert(Num, errorCount > 0, 1);
+        wire[sizeof(uint16_t) + 2] ^= 0x10;
+        assert(Status, Codec_decodeBuffer(&codec, &tempFrame, wire, sizeof(wire)), Codec_Status_Done);
+    }
+    assert_index = 0;
+
+    return 0;
+}
+#endif // CODEC_CHECKSUM
+#if CODEC_MMAP
+uint32_t Test_Mmap_Packet(void) {
+    #define MMAP_FRAMES                     40
+
+    static uint8_t PAT[32];
+
+    Codec_MmapFile file;
+    Codec_IndexEntry index[MMAP_FRAMES];
+    uint64_t offsets[MMAP_FRAMES];
+    StreamOut ostream;
+    Codec codec;
+    Packet frame;
+    Packet tempFrame;
+    Packet decoded;
+    char path[] = "/tmp/codec-capture-XXXXXX";
+    uint64_t offset = 0;
+    uint32_t len;
+    uint32_t i;
+    int fd;
+
+    uint8_t txBuff[64];
+    uint8_t tempBuff[32];
+    uint8_t wire[PACKET_HEADER_SIZE + sizeof(PAT) + PACKET_FOOTER_SIZE];
+    uint8_t noise[4] = {0};
+
+    cycles = 0;
+    assert_index = 0;
+    for (i = 0; i < sizeof(PAT); i++) {
+        PAT[i] = (uint8_t) (i * 11 + 1);
+    }
+    if ((fd = mkstemp(path)) < 0) {
+        PUTS("mkstemp failed");
+        return 0;
+    }
+
+    // capture of frames with noise between them
+    OStream_init(&ostream, NULL, txBuff, sizeof(txBuff));
+    Codec_init(&codec, Packet_baseLayer());
+    Codec_setDecodeSync(&codec, Packet_sync);
+    for (i = 0; i < MMAP_FRAMES; i++) {
+        assert(Num, write(fd, noise, i % 4), i % 4);
+        offset += i % 4;
+        offsets[i] = offset;
+        Packet_init(&frame, PAT, i % sizeof(PAT) + 1);
+        assert(Status, Codec_encodeFrame(&codec, &frame, &ostream, Codec_EncodeMode_Normal), Codec_Status_Done);
+        len = OStream_pendingBytes(&ostream);
+        Stream_readBytes(&ostream.Buffer, wire, len);
+        assert(Num, write(fd, wire, len), len);
+        offset += len;
+    }
+    assert(Num, write(fd, PAT, 5), 5);
+    close(fd);
+
+    // window smaller than a few frames, so frames cross window edges
+    assert(Num, Codec_MmapFile_open(&file, path, 2 * PACKET_HEADER_SIZE + sizeof(PAT)), 0);
+    assert(Num, file.Size == offset + 5, 1);
+    Packet_init(&tempFrame, tempBuff, sizeof(tempBuff));
+    assert(Num, Codec_indexFile(&codec, &tempFrame, &file, NULL, 0), MMAP_FRAMES);
+    assert(Num, Codec_indexFile(&codec, &tempFrame, &file, index, 10), MMAP_FRAMES);
+    assert(Num, Codec_indexFile(&codec, &tempFrame, &file, index, MMAP_FRAMES), MMAP_FRAMES);
+    for (assert_index = 0; assert_index < MMAP_FRAMES; assert_index++) {
+        assert(Num, Codec_IndexEntry_offset(index[assert_index]) == offsets[assert_index], 1);
+        assert(Num, Codec_IndexEntry_len(index[assert_index]), PACKET_HEADER_SIZE + assert_index % sizeof(PAT) + 1 + PACKET_FOOTER_SIZE);
+    }
+
+    // random access by index
+    Codec_MmapFile_random(&file);
+    for (assert_index = MMAP_FRAMES; assert_index-- > 0; ) {
+        assert(Status, Codec_decodeIndex(&codec, &tempFrame, &file, index[assert_index]), Codec_Status_Done);
+        Packet_init(&frame, PAT, assert_index % sizeof(PAT) + 1);
+        Packet_init(&decoded, tempFrame.Data, tempFrame.Len);
+        assert(Packet, &decoded, &frame);
+    }
+    assert_index = 0;
+
+#if CODEC_DECODE_VIEW
+    // payloads not copied in view mode
+    Codec_setDecodeView(&codec, 1);
+    Packet_init(&tempFrame, NULL, sizeof(PAT));
+    assert(Num, Codec_indexFile(&codec, &tempFrame, &file, index, MMAP_FRAMES), MMAP_FRAMES);
+    assert(Num, Codec_IndexEntry_offset(index[MMAP_FRAMES - 1]) == offsets[MMAP_FRAMES - 1], 1);
+    Codec_setDecodeView(&codec, 0);
+#endif
+
+    Codec_MmapFile_close(&file);
+    unlink(path);
+
+    return 0;
+}
+#endif // CODEC_MMAP
+#if CODEC_PARALLEL
+uint32_t Test_Parallel_Packet(void) {
+    #define PARALLEL_FRAMES                 300
+    #define PARALLEL_WORKERS                8
+
+    static uint8_t PAT[24];
+    static Codec_IndexEntry expected[PARALLEL_FRAMES];
+    static Codec_IndexEntry index[PARALLEL_FRAMES * 2];
+
+    Codec_MmapFile file;
+    StreamOut ostream;
+    Codec codec;
+    Packet frame;
+    Packet inner;
+    Packet frames[PARALLEL_WORKERS];
+    Codec_Frame* pFrames[PARALLEL_WORKERS];
+    char path[] = "/tmp/codec-parallel-XXXXXX";
+    int64_t count;
+    uint32_t len;
+    uint32_t workers;
+    uint32_t i;
+    int fd;
+
+    uint8_t txBuff[128];
+    uint8_t nested[PACKET_HEADER_SIZE + sizeof(PAT) + PACKET_FOOTER_SIZE];
+    uint8_t wire[PACKET_HEADER_SIZE + sizeof(nested) + PACKET_FOOTER_SIZE];
+    uint8_t tempBuff[PARALLEL_WORKERS][sizeof(nested)];
+    uint8_t noise[5] = {0x33, 0x00, 0x33, 0xCC, 0x00};
+
+    cycles = 0;
+    assert_index = 0;
+    for (i = 0; i < sizeof(PAT); i++) {
+        PAT[i] = (uint8_t) (i * 5 + 7);
+    }
+    if ((fd = mkstemp(path)) < 0) {
+        PUTS("mkstemp failed");
+        return 0;
+    }
+
+    // payload of some frames is a frame, so a worker that start inside them find a false frame
+    OStream_init(&ostream, NULL, txBuff, sizeof(txBuff));
+    Codec_init(&codec, Packet_baseLayer());
+    Codec_setDecodeSync(&codec, Packet_sync);
+    Packet_init(&inner, PAT, sizeof(PAT));
+    assert(Status, Codec_encodeFrame(&codec, &inner, &ostream, Codec_EncodeMode_Normal), Codec_Status_Done);
+    Stream_readBytes(&ostream.Buffer, nested, sizeof(nested));
+    for (i = 0; i < PARALLEL_FRAMES; i++) {
+        assert(Num, write(fd, noise, i % 6 == 5 ? 5 : i % 3), i % 6 == 5 ? 5 : i % 3);
+        if (i % 2 == 0) {
+            Packet_init(&frame, nested, sizeof(nested));
+        }
+        else {
+            Packet_init(&frame, PAT, i % sizeof(PAT) + 1);
+        }
+        assert(Status, Codec_encodeFrame(&codec, &frame, &ostream, Codec_EncodeMode_Normal), Codec_Status_Done);
+        len = OStream_pendingBytes(&ostream);
+        Stream_readBytes(&ostream.Buffer, wire, len);
+        assert(Num, write(fd, wire, len), len);
+    }
+    close(fd);
+
+    assert(Num, Codec_MmapFile_open(&file, path, sizeof(wire) + 16), 0);
+    for (i = 0; i < PARALLEL_WORKERS; i++) {
+        Packet_init(&frames[i], tempBuff[i], sizeof(nested));
+        pFrames[i] = (Codec_Frame*) &frames[i];
+    }
+    assert(Num, Codec_indexFile(&codec, pFrames[0], &file, expected, PARALLEL_FRAMES), PARALLEL_FRAMES);
+
+    for (workers = 1; workers <= PARALLEL_WORKERS; workers++) {
+        assert_index = (uint8_t) workers;
+        // index with margin
+        memset(index, 0, sizeof(index));
+        count = Codec_decodeParallel(&codec, pFrames, workers, &file, index, PARALLEL_FRAMES * 2);
+        assert(Num, count, PARALLEL_FRAMES);
+        assert(Num, memcmp(index, expected, sizeof(expected)), 0);
+        // index without margin, overfilled chunks decoded sequentially
+        memset(index, 0, sizeof(index));
+        count = Codec_decodeParallel(&codec, pFrames, workers, &file, index, PARALLEL_FRAMES);
+        assert(Num, count, PARALLEL_FRAMES);
+        assert(Num, memcmp(index, expected, sizeof(expected)), 0);
+        // short index only count rest of frames
+        count = Codec_decodeParallel(&codec, pFrames, workers, &file, index, PARALLEL_FRAMES / 2);
+        assert(Num, count, PARALLEL_FRAMES);
+        assert(Num, memcmp(index, expected, sizeof(expected) / 2), 0);
+    }
+    assert_index = 0;
+
+    Codec_MmapFile_close(&file);
+    unlink(path);
+
+    return 0;
+}
+#endif // CODEC_PARALLEL
+#if CODEC_DECODE_FILTER
+static uint32_t filterCalls;
+
+static Codec_FilterResult Test_filterPacket(Codec* codec, Codec_Frame* frame, Codec_LayerImpl* layer) {
+    Packet* p = (Packet*) frame;
+
+    if (layer != Packet_baseLayer()) {
+        // only layers of accepted frames parsed after header
+        filterCalls++;
+        return Codec_Filter_Accept;
+    }
+    if (p->Len == 1) {
+        return Codec_Filter_Abort;
+    }
+    return p->Len == 4 ? Codec_Filter_Accept : Codec_Filter_Skip;
+}
+static void Test_onFilterErrorPacket(Codec* codec, Codec_Frame* frame, Codec_LayerImpl* layer, Codec_Error error) {
+    if (error == CODEC_ERROR_FILTER) {
+        errorCount++;
+    }
+}
+uint32_t Test_Filter_Packet(void) {
+    #undef testPacket
+    #define FILTER_FRAMES                   6
+    #define FILTER_ACCEPTED                 3
+
+    static uint8_t PAT1[1] = {0x0A};
+    static uint8_t PAT3[4] = {0x2A, 0x2B, 0x2C, 0x2D};
+    static uint8_t PAT5[6] = {0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F};
+    // skip, accept, skip, accept, abort, accept
+    static uint8_t* const PATS[FILTER_FRAMES] = {PAT5, PAT3, PAT5, PAT3, PAT1, PAT3};
+    static const uint8_t PATS_LEN[FILTER_FRAMES] = {sizeof(PAT5), sizeof(PAT3), sizeof(PAT5), sizeof(PAT3), sizeof(PAT1), sizeof(PAT3)};
+
+    Codec_Status status;
+    StreamOut ostream;
+    StreamIn istream;
+    Codec codec;
+    Packet frame;
+    Packet tempFrame;
+    Stream_LenType wireLen;
+    Stream_LenType len;
+    uint32_t i;
+#if CODEC_STATS
+    Codec_Stats stats;
+#endif
+
+    uint8_t txBuff[128];
+    uint8_t wire[128];
+    uint8_t rxBuff[128];
+    // skipped frames are bigger than async input buffer
+    uint8_t asyncBuff[16];
+    uint8_t tempBuff[8];
+
+    OStream_init(&ostream, NULL, txBuff, sizeof(txBuff));
+    Codec_init(&codec, Packet_baseLayer());
+    for (i = 0; i < FILTER_FRAMES; i++) {
+        Packet_init(&frame, PATS[i], PATS_LEN[i]);
+        Codec_encodeFrame(&codec, &frame, &ostream, Codec_EncodeMode_Normal);
+    }
+    wireLen = OStream_pendingBytes(&ostream);
+    Stream_readBytes(&ostream.Buffer, wire, wireLen);
+
+    Codec_setDecodeSync(&codec, Packet_sync);
+    Codec_setDecodeFilter(&codec, Test_filterPacket);
+    Codec_onDecode(&codec, Codec_onDecodePacket);
+    Codec_onDecodeError(&codec, Test_onFilterErrorPacket);
+    Packet_init(&frame, PAT3, sizeof(PAT3));
+    Packet_init(&tempFrame, tempBuff, sizeof(tempBuff));
+    pFrame = &frame;
+    cycles = 0;
+    assert_index = 0;
+
+    PUTS("Frame");
+    line = __LINE__;
+    frameCount = 0;
+    errorCount = 0;
+    filterCalls = 0;
+    IStream_init(&istream, NULL, rxBuff, sizeof(rxBuff));
+    Stream_writeBytes(&istream.Buffer, wire, wireLen);
+    for (i = 0; i < FILTER_ACCEPTED; i++) {
+        status = Codec_decodeFrame(&codec, &tempFrame, &istream);
+        assert(Status, status, Codec_Status_Done);
+    }
+    assert(Num, frameCount, FILTER_ACCEPTED);
+    assert(Num, errorCount, 1);
+    assert(Num, filterCalls, FILTER_ACCEPTED * 2);
+    assert(Num, IStream_available(&istream), 0);
+#if CODEC_STATS
+    Codec_getStats(&codec, &stats);
+    assert(Num, stats.FilterSkipped, 2);
+    assert(Num, stats.Decode.Frames, FILTER_ACCEPTED);
+    assert(Num, Codec_Stats_error(&stats, CODEC_ERROR_FILTER), 1);
+    Codec_resetStats(&codec);
+#endif
+
+    PUTS("Async");
+    line = __LINE__;
+    frameCount = 0;
+    errorCount = 0;
+    filterCalls = 0;
+    IStream_init(&istream, NULL, asyncBuff, sizeof(asyncBuff));
+    Codec_setDecodeAll(&codec, 1);
+    Codec_beginDecode(&codec, &tempFrame);
+    for (i = 0; i < wireLen; i += len) {
+        len = wireLen - i < 3 ? wireLen - i : 3;
+        Stream_writeBytes(&istream.Buffer, &wire[i], len);
+        Codec_decode(&codec, &istream);
+    }
+    assert(Num, frameCount, FILTER_ACCEPTED);
+    assert(Num, errorCount, 1);
+    assert(Num, filterCalls, FILTER_ACCEPTED * 2);
+    assert(Num, IStream_available(&istream), 0);
+#if CODEC_STATS
+    Codec_getStats(&codec, &stats);
+    assert(Num, stats.FilterSkipped, 2);
+    assert(Num, stats.Decode.Frames, FILTER_ACCEPTED);
+#endif
+
+    return 0;
+}
+#endif // CODEC_DECODE_FILTER
+
+// -------------------------- Assert Functions ------------------------
+void Codec_onDecodeBasicFrame(Codec* codec, Codec_Frame* frame) {
+    if ((errorCode = Assert_BasicFrame((BasicFrame*) pFrame, (BasicFrame*) frame, line, cycles, assert_index)) == 0) {
+        frameCount++;
+    }
+}
+void Codec_onDecodePacket(Codec* codec, Codec_Frame* frame) {
+    if ((errorCode = Assert_Packet((Packet*) pFrame, (Packet*) frame, line, cycles, assert_index)) == 0) {
+        frameCount++;
+    }
+}
+#if CODEC_DECODE_VIEW
+void Codec_onDecodeViewPacket(Codec* codec, Codec_Frame* frame) {
+    static uint8_t data[64];
+    Packet* p = (Packet*) frame;
+    Packet temp;
+
+    Codec_viewCopy(&p->View, data);
+    Packet_init(&temp, data, Codec_viewLen(&p->View));
+    if ((errorCode = Assert_Packet((Packet*) pFrame, &temp, line, cycles, assert_index)) == 0) {
+        frameCount++;
+    }
+}
+#endif
+void Codec_onDecodeErrorPacket(Codec* codec, Codec_Frame* frame, Codec_LayerImpl* layer, Codec_Error error) {
+    errorCount++;
+}
+void Codec_onEncodePacket(Codec* codec, Codec_Frame* frame) {
+    frameCplt = 1;
+}
+void Codec_onEncodeErrorPacket(Codec* codec, Codec_Frame* frame, Codec_LayerImpl* layer, Codec_Error error) {
+    PRINTF("[Encode Error] %u\n", error);
+}
+#if TEST_THREADS && (CODEC_FULL_DUPLEX || CODEC_DECODE_QUEUE)
+/**
+ * @brief rx thread, decode until input stream is empty
+ */
+void* DecodeThread_run(void* arg) {
+    DecodeThread* ctx = (DecodeThread*) arg;
+
+    while (IStream_available(ctx->Stream) > 0) {
+        Codec_decode(ctx->Codec, ctx->Stream);
+    }
+    return NULL;
+}
+#endif
 void printArray(uint8_t* arr, int len) {
     PUTCHAR('{');
     while (--len > 0) {
@@ -1,4 +1,9 @@
 #include "Codec.h"
+#include <string.h>
+
+#if CODEC_TRACE
+    #include "CodecTrace.h"
+#endif
 
 #ifndef NULL
     #define NULL          ((void*) 0)
@@ -10,6 +15,167 @@
     #define __nextLayer(C, F, L, P)             (L)->nextLayer((C), (F), (P))
 #endif
 
+#define __frameBegin(B, S)                  if ((B) != NULL) { *(B) = IStream_available(S); }
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define __queueLoad(P)                      __atomic_load_n((P), __ATOMIC_ACQUIRE)
+    #define __queueStore(P, V)                  __atomic_store_n((P), (V), __ATOMIC_RELEASE)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_ATOMICS__)
+    #include <stdatomic.h>
+    // indexes are not _Atomic, so fences order slot accesses around plain volatile accesses
+    #define __queueFence()                      atomic_thread_fence(memory_order_seq_cst)
+#else
+    /**
+     * @brief call through volatile pointer is opaque for compiler, so memory accesses
+     * not moved across it, it's a compiler barrier for single core targets with ISR consumer
+     */
+    static void Codec_queueBarrier(void) {}
+    static void (* volatile __queueBarrierFn)(void) = Codec_queueBarrier;
+    #define __queueFence()                      __queueBarrierFn()
+#endif
+#ifdef __queueFence
+    /**
+     * @brief load index before slot of it read and store index after slot of it written
+     */
+    static Stream_LenType Codec_queueLoad(volatile Stream_LenType* index) {
+        Stream_LenType value = *index;
+        __queueFence();
+        return value;
+    }
+    #define __queueLoad(P)                      Codec_queueLoad(P)
+    #define __queueStore(P, V)                  (__queueFence(), *(P) = (V))
+#endif
+#define __queueNext(Q, I)                   ((Stream_LenType) ((I) + 1 < (Q)->Size ? (I) + 1 : 0))
+#define __queueAvailable(Q, H, T)           ((Stream_LenType) ((H) >= (T) ? (H) - (T) : (Q)->Size - (T) + (H)))
+
+#if CODEC_DECODE_CHUNK
+    #define __rxNeedLen(R, LEN)                 ((R)->Layer->parseChunk ? (Stream_LenType) ((LEN) > (R)->Offset) : (LEN))
+    #define __rxLayerBegin(R)                   ((R)->Offset == 0)
+#else
+    #define __rxNeedLen(R, LEN)                 (LEN)
+    #define __rxLayerBegin(R)                   1
+#endif
+
+#if CODEC_STATS
+#if CODEC_FULL_DUPLEX
+    #define __rxStats(C)                        ((C)->RxStats)
+    #define __txStats(C)                        ((C)->TxStats)
+#else
+    #define __rxStats(C)                        ((C)->Stats)
+    #define __txStats(C)                        ((C)->Stats)
+#endif
+    #define __rxStatsAdd(C, F, N)               (__rxStats(C).F += (Codec_StatsCounter) (N))
+    #define __txStatsAdd(C, F, N)               (__txStats(C).F += (Codec_StatsCounter) (N))
+    #define __statsError(C, L, E, P)            Codec_statsError((C), (L), (E), (P))
+#else
+    #define __rxStatsAdd(C, F, N)
+    #define __txStatsAdd(C, F, N)
+    #define __statsError(C, L, E, P)
+#endif
+
+#if CODEC_CHECKSUM
+    #define __rxSumBegin(C)                     if ((C)->RxChecksum != NULL) { (C)->RxSum = (C)->RxChecksum->Init; }
+    #define __rxSum(C, S, LK)                   if ((C)->RxChecksum != NULL) { Codec_sumIn((C), (S), IStream_lockLen((S), (LK))); }
+    #define __txSumBegin(C)                     if ((C)->TxChecksum != NULL) { (C)->TxSum = (C)->TxChecksum->Init; }
+    #define __txSum(C, S, LK)                   if ((C)->TxChecksum != NULL) { Codec_sumOut((C), (S), OStream_lockLen((S), (LK))); }
+#else
+    #define __rxSumBegin(C)
+    #define __rxSum(C, S, LK)
+    #define __txSumBegin(C)
+    #define __txSum(C, S, LK)
+#endif
+
+#if CODEC_DECODE_LATENCY
+    #define __latencyBegin(C)                   if ((C)->clock != NULL && !(C)->RxTimed) { (C)->RxBegin = (C)->clock((C)); (C)->RxTimed = 1; }
+    #define __latencyEnd(C)                     if ((C)->RxTimed) { Codec_Histogram_add(&(C)->RxLatency, (Codec_Tick) ((C)->clock((C)) - (C)->RxBegin)); (C)->RxTimed = 0; }
+    #define __latencyCancel(C)                  if ((C)->RxTimed) { (C)->RxTimed = 0; }
+#else
+    #define __latencyBegin(C)
+    #define __latencyEnd(C)
+    #define __latencyCancel(C)
+#endif
+
+#if CODEC_TRACE
+    #define __trace(C, E, L, P, V)              Codec_Trace_record((C), Codec_TraceEvent_ ##E, (L), Codec_Phase_ ##P, (uint32_t) (V))
+#else
+    #define __trace(C, E, L, P, V)
+#endif
+
+#if CODEC_LAYER_FIXED
+    #define __fixedLen(C, F, L, P)              (((L)->Flags & CODEC_LAYER_FIXED_LEN) ? (L)->FixedLen : (L)->getLen((C), (F), (P)))
+    #define __fixedNext(C, F, L, P)             (((L)->Flags & CODEC_LAYER_FIXED_NEXT) ? (L)->FixedNext : (__nextLayer((C), (F), (L), (P))))
+#else
+    #define __fixedLen(C, F, L, P)              (L)->getLen((C), (F), (P))
+    #define __fixedNext(C, F, L, P)             (__nextLayer((C), (F), (L), (P)))
+#endif
+
+#if CODEC_COMPILE
+    #define __layerLen(C, F, L, I, P)           Codec_layerLen((C), (F), (L), (I), (P))
+    #define __layerNext(C, F, L, I, P)          Codec_layerNext((C), (F), (L), &(I), (P))
+    #define __layerIndex(I, V)                  (I) = (V)
+#else
+    #define __layerLen(C, F, L, I, P)           __fixedLen((C), (F), (L), (P))
+    #define __layerNext(C, F, L, I, P)          __fixedNext((C), (F), (L), (P))
+    #define __layerIndex(I, V)
+#endif
+
+#if CODEC_COMPILE
+    #define __skipLen(C, F, L, I)               Codec_skipLen((C), (F), (L), (I))
+#else
+    #define __skipLen(C, F, L, I)               Codec_skipLen((C), (F), (L), 0)
+#endif
+
+#if CODEC_DECODE_FILTER && CODEC_DECODE_ASYNC
+    #define __rxSkip(C)                         ((C)->RxSkip)
+#else
+    #define __rxSkip(C)                         0
+#endif
+
+#if CODEC_DECODE_CHUNK
+    #define __rxLayerEnd(R, LK, N, LEN)         (!(R)->Layer->parseChunk || (R)->Offset + (N) - IStream_availableUncheck(LK) >= (LEN))
+#else
+    #define __rxLayerEnd(R, LK, N, LEN)         1
+#endif
+
+#if CODEC_COMPILE
+/**
+ * @brief return length of layer, from compiled chain if layer length is fixed
+ *
+ * @param codec
+ * @param frame
+ * @param layer
+ * @param index index of layer in compiled chain, equal to ChainLen when layer is out of chain
+ * @param phase
+ * @return Stream_LenType
+ */
+static Stream_LenType Codec_layerLen(Codec* codec, Codec_Frame* frame, Codec_LayerImpl* layer, Codec_LayerIndex index, Codec_Phase phase) {
+    if (index < codec->ChainLen && codec->Chain[index].Len != CODEC_LAYER_LEN_DYNAMIC) {
+        return codec->Chain[index].Len;
+    }
+    return __fixedLen(codec, frame, layer, phase);
+}
+/**
+ * @brief return next layer of layer, from compiled chain if next layer is fixed
+ *
+ * @param codec
+ * @param frame
+ * @param layer
+ * @param index index of layer in compiled chain, updated to index of next layer
+ * @param phase
+ * @return Codec_LayerImpl*
+ */
+static Codec_LayerImpl* Codec_layerNext(Codec* codec, Codec_Frame* frame, Codec_LayerImpl* layer, Codec_LayerIndex* index, Codec_Phase phase) {
+    Codec_LayerIndex next = *index + 1;
+    if (next < codec->ChainLen) {
+        *index = next;
+        return codec->Chain[next].Layer;
+    }
+    // out of compiled chain
+    *index = codec->ChainLen;
+    return __fixedNext(codec, frame, layer, phase);
+}
+#endif
+
 /**
  * @brief initialize codec
  *
@@ -19,13 +185,29 @@
  */
 void Codec_init(Codec* codec, Codec_LayerImpl* baseLayer) {
     codec->BaseLayer = baseLayer;
+#if CODEC_COMPILE
+    codec->Chain = NULL;
+    codec->ChainLen = 0;
+#endif
 #if CODEC_ARGS
     codec->Args = (void*) 0;
 #endif
 #if CODEC_DECODE
 #if CODEC_DECODE_ASYNC
-    codec->RxLayer = baseLayer;
-    codec->RxFrame = NULL;
+    codec->Rx.Layer = baseLayer;
+    codec->Rx.Frame = NULL;
+#if CODEC_COMPILE
+    codec->Rx.Index = 0;
+#endif
+#if CODEC_DECODE_CHUNK
+    codec->Rx.Offset = 0;
+#endif
+#if CODEC_DECODE_QUEUE
+    codec->RxQueue = NULL;
+#endif
+#if CODEC_DECODE_FILTER
+    codec->RxSkip = 0;
+#endif
 #endif
 #if CODEC_DECODE_CALLBACK
     codec->onDecode = (Codec_OnFrameFn) 0;
@@ -33,15 +215,36 @@ void Codec_init(Codec* codec, Codec_LayerImpl* baseLayer) {
 #if CODEC_DECODE_ERROR
     codec->onDecodeError = (Codec_OnErrorFn) 0;
 #endif
+#if CODEC_DECODE_FILTER
+    codec->filter = (Codec_FilterFn) 0;
+#endif
 #if CODEC_DECODE_SYNC
     codec->sync = (Codec_SyncFn) 0;
 #endif
+#if CODEC_DECODE_RESYNC
+    codec->resync = (Codec_SyncFn) 0;
+#endif
+#if CODEC_DECODE_LATENCY
+    codec->clock = (Codec_ClockFn) 0;
+    codec->RxBegin = 0;
+    Codec_Histogram_reset(&codec->RxLatency);
+#endif
+#if CODEC_CHECKSUM
+    codec->RxChecksum = NULL;
+    codec->RxSum = 0;
+#endif
 #endif // CODEC_DECODE
 #if CODEC_ENCODE
 #if CODEC_ENCODE_ASYNC
-    codec->TxLayer = baseLayer;
-    codec->TxFrame = NULL;
+    codec->Tx.Layer = baseLayer;
+    codec->Tx.Frame = NULL;
     codec->EncodeMode = Codec_EncodeMode_Normal;
+#if CODEC_COMPILE
+    codec->Tx.Index = 0;
+#endif
+#if CODEC_ENCODE_QUEUE
+    codec->TxQueue = NULL;
+#endif
 #endif
 #if CODEC_ENCODE_CALLBACK
     codec->onEncode = (Codec_OnFrameFn) 0;
@@ -49,9 +252,24 @@ void Codec_init(Codec* codec, Codec_LayerImpl* baseLayer) {
 #if CODEC_ENCODE_ERROR
     codec->onEncodeError = (Codec_OnErrorFn) 0;
 #endif
+#if CODEC_ENCODE_GATHER
+    codec->TxGather = NULL;
+#endif
+#if CODEC_CHECKSUM
+    codec->TxChecksum = NULL;
+    codec->TxSum = 0;
+#if CODEC_ENCODE_GATHER
+    codec->TxSumMark = 0;
+#endif
+#endif
 #endif // CODEC_ENCODE
     codec->DecodeAll = 0;
     codec->FreeStream = 1;
+    codec->DecodeView = 0;
+    codec->RxTimed = 0;
+#if CODEC_STATS
+    Codec_resetStats(codec);
+#endif
 }
 /**
  * @brief This function help you te get full frame size before encode
@@ -63,12 +281,64 @@ void Codec_init(Codec* codec, Codec_LayerImpl* baseLayer) {
 Stream_LenType Codec_frameSize(Codec* codec, Codec_Frame* frame, Codec_Phase phase) {
     Codec_LayerImpl* layer = codec->BaseLayer;
     uint32_t size = 0;
+#if CODEC_COMPILE
+    Codec_LayerIndex index = 0;
+#endif
     while (layer) {
-        size += layer->getLen(codec, frame, phase);
-        layer = __nextLayer(codec, frame, layer, phase);
+        size += __layerLen(codec, frame, layer, index, phase);
+        layer = __layerNext(codec, frame, layer, index, phase);
     }
     return size;
 }
+#if CODEC_COMPILE
+/**
+ * @brief compile layer chain of codec into given table, layers walked from base layer
+ * as long as next layer is fixed, so decode and encode walk a flat table
+ * instead of layer descriptors,
+ * table must be valid until codec compiled again or initialized
+ *
+ * @param codec
+ * @param chain table of compiled layers
+ * @param size size of table, one entry used for end of chain
+ * @return Codec_LayerIndex number of entries used
+ */
+Codec_LayerIndex Codec_compile(Codec* codec, Codec_CompiledLayer* chain, Codec_LayerIndex size) {
+    Codec_LayerImpl* layer = codec->BaseLayer;
+    Codec_LayerIndex len = 0;
+
+    while (len < size) {
+        chain[len].Layer = layer;
+        if (layer == CODEC_LAYER_NULL) {
+            // end of frame
+            chain[len++].Len = 0;
+            break;
+        }
+        chain[len++].Len = (layer->Flags & CODEC_LAYER_FIXED_LEN) ? layer->FixedLen : CODEC_LAYER_LEN_DYNAMIC;
+        if (layer->Flags & CODEC_LAYER_FIXED_NEXT) {
+            layer = layer->FixedNext;
+        }
+    #if CODEC_SUPPORT_NEXT_LAYER_NULL
+        else if (layer->nextLayer == NULL) {
+            layer = CODEC_LAYER_NULL;
+        }
+    #endif
+        else {
+            // next layer depend on frame
+            break;
+        }
+    }
+
+    codec->Chain = chain;
+    codec->ChainLen = len;
+#if CODEC_DECODE && CODEC_DECODE_ASYNC
+    codec->Rx.Index = 0;
+#endif
+#if CODEC_ENCODE && CODEC_ENCODE_ASYNC
+    codec->Tx.Index = 0;
+#endif
+    return len;
+}
+#endif // CODEC_COMPILE
 #if CODEC_ARGS
 /**
  * @brief set user args
@@ -89,6 +359,152 @@ void* Codec_getArgs(Codec* codec) {
     return codec->Args;
 }
 #endif // CODEC_ARGS
+#if CODEC_STATS
+/**
+ * @brief take snapshot of codec statistics
+ *
+ * @param codec
+ * @param stats
+ */
+void Codec_getStats(Codec* codec, Codec_Stats* stats) {
+#if CODEC_FULL_DUPLEX && CODEC_DECODE && CODEC_ENCODE
+    const Codec_Stats* tx = &codec->TxStats;
+    uint16_t i;
+    uint16_t j;
+
+    // decoder side with encoder errors merged into tables
+    memcpy(stats, &codec->RxStats, sizeof(Codec_Stats));
+    stats->Encode = tx->Encode;
+    for (i = 0; i < CODEC_STATS_LAYERS && tx->Layers[i].Layer != NULL; i++) {
+        for (j = 0; j < CODEC_STATS_LAYERS; j++) {
+            if (stats->Layers[j].Layer == NULL) {
+                stats->Layers[j].Layer = tx->Layers[i].Layer;
+            }
+            if (stats->Layers[j].Layer == tx->Layers[i].Layer) {
+                stats->Layers[j].EncodeErrors += tx->Layers[i].EncodeErrors;
+                break;
+            }
+        }
+    }
+    for (i = 0; i < CODEC_STATS_ERRORS && tx->Errors[i].Count != 0; i++) {
+        for (j = 0; j < CODEC_STATS_ERRORS; j++) {
+            if (stats->Errors[j].Count == 0) {
+                stats->Errors[j].Error = tx->Errors[i].Error;
+            }
+            if (stats->Errors[j].Error == tx->Errors[i].Error) {
+                stats->Errors[j].Count += tx->Errors[i].Count;
+                break;
+            }
+        }
+    }
+#elif CODEC_FULL_DUPLEX && CODEC_DECODE
+    memcpy(stats, &codec->RxStats, sizeof(Codec_Stats));
+#elif CODEC_FULL_DUPLEX
+    memcpy(stats, &codec->TxStats, sizeof(Codec_Stats));
+#else
+    memcpy(stats, &codec->Stats, sizeof(Codec_Stats));
+#endif
+}
+/**
+ * @brief reset all statistics counters of codec
+ *
+ * @param codec
+ */
+void Codec_resetStats(Codec* codec) {
+#if CODEC_FULL_DUPLEX
+#if CODEC_DECODE
+    memset(&codec->RxStats, 0, sizeof(Codec_Stats));
+#endif
+#if CODEC_ENCODE
+    memset(&codec->TxStats, 0, sizeof(Codec_Stats));
+#endif
+#else
+    memset(&codec->Stats, 0, sizeof(Codec_Stats));
+#endif
+}
+/**
+ * @brief find error counters of a layer
+ *
+ * @param stats
+ * @param layer
+ * @return const Codec_LayerStats* NULL if layer has no error
+ */
+const Codec_LayerStats* Codec_Stats_layer(const Codec_Stats* stats, const Codec_LayerImpl* layer) {
+    uint16_t i;
+
+    for (i = 0; i < CODEC_STATS_LAYERS && stats->Layers[i].Layer != NULL; i++) {
+        if (stats->Layers[i].Layer == layer) {
+            return &stats->Layers[i];
+        }
+    }
+    return NULL;
+}
+/**
+ * @brief return number of times that an error code returned by layers
+ *
+ * @param stats
+ * @param error
+ * @return Codec_StatsCounter
+ */
+Codec_StatsCounter Codec_Stats_error(const Codec_Stats* stats, Codec_Error error) {
+    uint16_t i;
+
+    for (i = 0; i < CODEC_STATS_ERRORS && stats->Errors[i].Count != 0; i++) {
+        if (stats->Errors[i].Error == error) {
+            return stats->Errors[i].Count;
+        }
+    }
+    return 0;
+}
+/**
+ * @brief count an error of layer, errors are rare so tables searched linearly
+ *
+ * @param codec
+ * @param layer failed layer
+ * @param error
+ * @param phase
+ */
+static void Codec_statsError(Codec* codec, Codec_LayerImpl* layer, Codec_Error error, Codec_Phase phase) {
+    Codec_Stats* stats;
+    uint16_t i;
+
+#if CODEC_DECODE
+    if (phase == Codec_Phase_Decode) {
+        stats = &__rxStats(codec);
+        stats->Decode.Errors++;
+    }
+#endif
+#if CODEC_ENCODE
+    if (phase == Codec_Phase_Encode) {
+        stats = &__txStats(codec);
+        stats->Encode.Errors++;
+    }
+#endif
+    for (i = 0; i < CODEC_STATS_LAYERS; i++) {
+        if (stats->Layers[i].Layer == NULL) {
+            stats->Layers[i].Layer = layer;
+        }
+        if (stats->Layers[i].Layer == layer) {
+            if (phase == Codec_Phase_Decode) {
+                stats->Layers[i].DecodeErrors++;
+            }
+            else {
+                stats->Layers[i].EncodeErrors++;
+            }
+            break;
+        }
+    }
+    for (i = 0; i < CODEC_STATS_ERRORS; i++) {
+        if (stats->Errors[i].Count == 0) {
+            stats->Errors[i].Error = error;
+        }
+        if (stats->Errors[i].Error == error) {
+            stats->Errors[i].Count++;
+            break;
+        }
+    }
+}
+#endif // CODEC_STATS
 #if CODEC_DECODE
 #if CODEC_DECODE_CALLBACK
 /**
@@ -112,6 +528,37 @@ void Codec_onDecodeError(Codec* codec, Codec_OnErrorFn fn) {
     codec->onDecodeError = fn;
 }
 #endif // CODEC_DECODE_ERROR
+#if CODEC_DECODE_FILTER
+/**
+ * @brief set decode filter, it's called after each layer of a frame parsed,
+ * on Codec_Filter_Skip rest of frame ignored without parse and onDecode not called,
+ * so length and next layer of remaining layers must be known from parsed layers,
+ * on Codec_Filter_Abort frame handled like a failed layer with CODEC_ERROR_FILTER
+ *
+ * @param codec
+ * @param fn NULL to disable filter
+ */
+void Codec_setDecodeFilter(Codec* codec, Codec_FilterFn fn) {
+    codec->filter = fn;
+}
+/**
+ * @brief return length of layers after layer until end of frame
+ *
+ * @param codec
+ * @param frame
+ * @param layer last parsed layer
+ * @param index index of layer in compiled chain
+ * @return Stream_LenType
+ */
+static Stream_LenType Codec_skipLen(Codec* codec, Codec_Frame* frame, Codec_LayerImpl* layer, Codec_LayerIndex index) {
+    Stream_LenType len = 0;
+
+    while ((layer = __layerNext(codec, frame, layer, index, Codec_Phase_Decode)) != CODEC_LAYER_NULL) {
+        len += __layerLen(codec, frame, layer, index, Codec_Phase_Decode);
+    }
+    return len;
+}
+#endif // CODEC_DECODE_FILTER
 #if CODEC_DECODE_SYNC
 /**
  * @brief set decode sync function
@@ -123,6 +570,225 @@ void Codec_setDecodeSync(Codec* codec, Codec_SyncFn fn) {
     codec->sync = fn;
 }
 #endif // CODEC_DECODE_SYNC
+#if CODEC_DECODE_RESYNC
+/**
+ * @brief set decode resync function, it's called after a layer parse failed
+ * and must return offset of next frame candidate in stream, or -1 if there is no candidate,
+ * Sync functions such as Packet_sync can be used as resync function too
+ *
+ * @param codec
+ * @param fn
+ */
+void Codec_setDecodeResync(Codec* codec, Codec_SyncFn fn) {
+    codec->resync = fn;
+}
+/**
+ * @brief skip bytes until next frame candidate that resync function found
+ *
+ * @param codec
+ * @param stream
+ */
+static void Codec_resync(Codec* codec, StreamIn* stream) {
+    Stream_LenType len = codec->resync(codec, stream);
+    if (len > 0) {
+        IStream_ignore(stream, len);
+        __rxStatsAdd(codec, ResyncSkipped, len);
+        __trace(codec, Sync, codec->BaseLayer, Decode, len);
+    }
+    else if (len == -1 && codec->FreeStream) {
+        __rxStatsAdd(codec, ResyncSkipped, IStream_available(stream));
+        __trace(codec, Sync, codec->BaseLayer, Decode, IStream_available(stream));
+        IStream_ignore(stream, IStream_available(stream));
+    }
+}
+#endif // CODEC_DECODE_RESYNC
+#if CODEC_CHECKSUM
+/**
+ * @brief set checksum that decoder run over bytes of layers, checksum restart on first layer
+ * of each frame and bytes of a layer added after its parse succeeded,
+ * so a footer layer read checksum of previous layers with Codec_decodeChecksum
+ *
+ * @param codec
+ * @param impl NULL to disable checksum
+ */
+void Codec_setDecodeChecksum(Codec* codec, const Codec_ChecksumImpl* impl) {
+    codec->RxChecksum = impl;
+    codec->RxSum = impl != NULL ? impl->Init : 0;
+}
+/**
+ * @brief add bytes from begin of stream into decode checksum, bytes may wrap around end of buffer
+ *
+ * @param codec
+ * @param stream
+ * @param len
+ */
+static void Codec_sumIn(Codec* codec, StreamIn* stream, Stream_LenType len) {
+    Stream_LenType direct = Stream_directAvailable(&stream->Buffer);
+
+    if (direct > len) {
+        direct = len;
+    }
+    codec->RxSum = codec->RxChecksum->update(codec->RxSum, Stream_getReadPtr(&stream->Buffer), direct);
+    if (len > direct) {
+        codec->RxSum = codec->RxChecksum->update(codec->RxSum, Stream_getDataPtr(&stream->Buffer), len - direct);
+    }
+}
+#endif // CODEC_CHECKSUM
+#if CODEC_DECODE_LATENCY
+/**
+ * @brief set clock of decode latency, latency not measured when clock is NULL
+ *
+ * @param codec
+ * @param fn
+ */
+void Codec_setClock(Codec* codec, Codec_ClockFn fn) {
+    codec->clock = fn;
+    codec->RxTimed = 0;
+}
+/**
+ * @brief remove all values of histogram
+ *
+ * @param hist
+ */
+void Codec_Histogram_reset(Codec_Histogram* hist) {
+    memset(hist, 0, sizeof(Codec_Histogram));
+}
+/**
+ * @brief return bucket of value, values less than 4 have own bucket
+ * and each next power of two split into 4 buckets
+ *
+ * @param value
+ * @return uint16_t
+ */
+static uint16_t Codec_Histogram_bucket(Codec_Tick value) {
+    uint16_t index = (uint16_t) value;
+
+    if (value >= 4) {
+        index = 4;
+        while (value >= 8) {
+            value >>= 1;
+            index += 4;
+        }
+        index += (uint16_t) (value - 4);
+    }
+    return index < CODEC_DECODE_LATENCY_BUCKETS ? index : CODEC_DECODE_LATENCY_BUCKETS - 1;
+}
+/**
+ * @brief return biggest value of bucket
+ *
+ * @param index
+ * @return Codec_Tick
+ */
+static Codec_Tick Codec_Histogram_upper(uint16_t index) {
+    if (index < 4) {
+        return index;
+    }
+    index -= 4;
+    return (((Codec_Tick) 5 + (index & 3)) << (index >> 2)) - 1;
+}
+/**
+ * @brief add a value into histogram
+ *
+ * @param hist
+ * @param value
+ */
+void Codec_Histogram_add(Codec_Histogram* hist, Codec_Tick value) {
+    if (hist->Count == 0 || value < hist->Min) {
+        hist->Min = value;
+    }
+    if (value > hist->Max) {
+        hist->Max = value;
+    }
+    hist->Buckets[Codec_Histogram_bucket(value)]++;
+    hist->Count++;
+}
+/**
+ * @brief return value that given part of values are less than or equal to it,
+ * result is upper bound of bucket, so it's precise up to 25% of value
+ *
+ * @param hist
+ * @param permyriad part of values in 1/10000, ex: 9900 for p99
+ * @return Codec_Tick 0 if histogram is empty
+ */
+Codec_Tick Codec_Histogram_percentile(const Codec_Histogram* hist, uint16_t permyriad) {
+    uint64_t rank = ((uint64_t) hist->Count * permyriad + 9999) / 10000;
+    uint64_t sum = 0;
+    Codec_Tick upper;
+    uint16_t i;
+
+    if (hist->Count == 0) {
+        return 0;
+    }
+    if (rank == 0) {
+        return hist->Min;
+    }
+    for (i = 0; i < CODEC_DECODE_LATENCY_BUCKETS - 1; i++) {
+        sum += hist->Buckets[i];
+        if (sum >= rank) {
+            upper = Codec_Histogram_upper(i);
+            return upper < hist->Max ? upper : hist->Max;
+        }
+    }
+    return hist->Max;
+}
+#endif // CODEC_DECODE_LATENCY
+#if CODEC_DECODE_VIEW
+/**
+ * @brief enable or disable view mode, in view mode layers can keep a view of bytes inside
+ * stream buffer instead of copy them, bytes of frame released after onDecode returned,
+ * frames still check length fields against their buffer size, so in view mode size of frame
+ * is max accepted payload length and data buffer can be NULL, e.g. Packet_init(&frame, NULL, maxLen)
+ *
+ * @param codec
+ * @param enabled 0: disabled, !0: enabled
+ */
+void Codec_setDecodeView(Codec* codec, uint8_t enabled) {
+    codec->DecodeView = enabled != 0;
+}
+/**
+ * @brief fill view with next len bytes of stream, read position not changed
+ *
+ * @param view
+ * @param stream
+ * @param len
+ */
+void Codec_view(Codec_View* view, StreamIn* stream, Stream_LenType len) {
+    Stream_LenType direct = Stream_directAvailable(&stream->Buffer);
+    view->Data[0] = Stream_getReadPtr(&stream->Buffer);
+    if (direct >= len) {
+        view->Len[0] = len;
+        view->Data[1] = NULL;
+        view->Len[1] = 0;
+    }
+    else {
+        // bytes wrapped around end of buffer
+        view->Len[0] = direct;
+        view->Data[1] = Stream_getDataPtr(&stream->Buffer);
+        view->Len[1] = len - direct;
+    }
+}
+/**
+ * @brief return total length of view
+ *
+ * @param view
+ * @return Stream_LenType
+ */
+Stream_LenType Codec_viewLen(const Codec_View* view) {
+    return view->Len[0] + view->Len[1];
+}
+/**
+ * @brief copy bytes of view into buffer
+ *
+ * @param view
+ * @param buff must have at least Codec_viewLen bytes
+ */
+void Codec_viewCopy(const Codec_View* view, uint8_t* buff) {
+    memcpy(buff, view->Data[0], view->Len[0]);
+    if (view->Len[1] > 0) {
+        memcpy(buff + view->Len[0], view->Data[1], view->Len[1]);
+    }
+}
+#endif // CODEC_DECODE_VIEW
 #if CODEC_DECODE_ON_BUFFER
 /**
  * @brief decode a frame from a buffer
@@ -141,41 +807,94 @@ Codec_Status Codec_decodeBuffer(Codec* codec, Codec_Frame* frame, uint8_t* buffe
 }
 #endif // CODEC_DECODE_ON_BUFFER
 /**
- * @brief decode a frame from a stream, all of frame bytes must exists
+ * @brief parse layers of a frame from a stream, all of frame bytes must exists
  *
  * @param codec
- * @param stream
  * @param frame
+ * @param stream
+ * @param begin if not null, hold available bytes of stream at begin of last frame candidate
+ * @param synced 1 if stream begin right after end of a decoded frame, so sync is skipped
+ * until base layer fail
  * @return Codec_Status
  */
-Codec_Status Codec_decodeFrame(Codec* codec, Codec_Frame* frame, StreamIn* stream) {
+static Codec_Status Codec_parseFrame(Codec* codec, Codec_Frame* frame, StreamIn* stream, Stream_LenType* begin, uint8_t synced) {
     Codec_LayerImpl* layer = codec->BaseLayer;
     Codec_Error error;
     Codec_Status status = Codec_Status_Error;
     StreamIn lock;
     Stream_LenType layerLen;
+#if CODEC_COMPILE
+    Codec_LayerIndex index = 0;
+#endif
+#if CODEC_DECODE_FILTER
+    Codec_FilterResult filter = Codec_Filter_Accept;
+#endif
 
-    layerLen = layer->getLen(codec, frame, Codec_Phase_Decode);
+    __frameBegin(begin, stream);
+    layerLen = __layerLen(codec, frame, layer, index, Codec_Phase_Decode);
     while (IStream_available(stream) >= layerLen) {
     #if CODEC_DECODE_SYNC
-        if (layer == codec->BaseLayer && codec->sync) {
+        if (layer == codec->BaseLayer && codec->sync && !synced) {
             Stream_LenType available = IStream_available(stream);
             Stream_LenType len = codec->sync(codec, stream);
             if (len > 0) {
                 IStream_ignore(stream, len);
+                __rxStatsAdd(codec, SyncSkipped, len);
+                __trace(codec, Sync, layer, Decode, len);
+                __frameBegin(begin, stream);
                 if (IStream_available(stream) < layerLen) {
                     return Codec_Status_Pending;
                 }
             }
             else if (len == -1) {
                 IStream_ignore(stream, available);
+                __rxStatsAdd(codec, SyncSkipped, available);
+                __trace(codec, Sync, layer, Decode, available);
+                __frameBegin(begin, stream);
                 return Codec_Status_Pending;
             }
         }
     #endif
+        if (layer == codec->BaseLayer) {
+            // first byte of frame
+            __latencyBegin(codec);
+            __rxSumBegin(codec);
+        }
+        __trace(codec, Enter, layer, Decode, layerLen);
         // set limit for read header part
         IStream_lock(stream, &lock, layerLen);
-        if ((error = layer->parse(codec, frame, &lock)) != CODEC_OK) {
+    #if CODEC_DECODE_CHUNK
+        if (layer->parse == NULL) {
+            // whole layer exists, parse it as a single chunk
+            error = layer->parseChunk(codec, frame, &lock, 0, layerLen);
+        }
+        else
+    #endif
+        {
+            error = layer->parse(codec, frame, &lock);
+        }
+    #if CODEC_DECODE_FILTER
+        if (error == CODEC_OK && codec->filter &&
+            (filter = codec->filter(codec, frame, layer)) == Codec_Filter_Abort) {
+            error = CODEC_ERROR_FILTER;
+        }
+    #endif
+        if (error != CODEC_OK) {
+        #if CODEC_DECODE_SYNC
+            if (synced && layer == codec->BaseLayer && codec->sync) {
+                // bytes after previous frame are noise, parse them again after sync
+                synced = 0;
+                IStream_unlockIgnore(stream);
+                __latencyCancel(codec);
+                __trace(codec, Exit, layer, Decode, 0);
+                continue;
+            }
+            synced = 0;
+        #endif
+            __statsError(codec, layer, error, Codec_Phase_Decode);
+            __latencyCancel(codec);
+            __trace(codec, Error, layer, Decode, error);
+            __trace(codec, Exit, layer, Decode, 0);
         #if CODEC_DECODE_ERROR
             if (codec->onDecodeError) {
                 codec->onDecodeError(codec, frame, layer, error);
@@ -183,37 +902,204 @@ Codec_Status Codec_decodeFrame(Codec* codec, Codec_Frame* frame, StreamIn* strea
         #endif
             // back to base layer
             layer = codec->BaseLayer;
+            __layerIndex(index, 0);
             // unlock stream
             IStream_unlockIgnore(stream);
             // ignore one byte
             IStream_ignore(stream, 1);
+            __rxStatsAdd(codec, ErrorDropped, 1);
+        #if CODEC_DECODE_RESYNC
+            // jump to next frame candidate
+            if (codec->resync) {
+                Codec_resync(codec, stream);
+            }
+        #endif
+            __frameBegin(begin, stream);
         }
         else {
+            __rxStatsAdd(codec, Decode.Bytes, layerLen);
+            __trace(codec, Exit, layer, Decode, layerLen);
         #if CODEC_DECODE_PADDING
             if ((layerLen = IStream_availableUncheck(&lock)) > 0) {
                 // add padding
                 IStream_ignore(&lock, layerLen);
             }
         #endif
+            __rxSum(codec, stream, &lock);
             // unlock stream
             IStream_unlock(stream, &lock);
-            if ((layer = __nextLayer(codec, frame, layer, Codec_Phase_Decode)) == CODEC_LAYER_NULL) {
-            #if CODEC_DECODE_CALLBACK
-                // frame received
-                if (codec->onDecode) {
-                    codec->onDecode(codec, frame);
+        #if CODEC_DECODE_FILTER
+            if (filter == Codec_Filter_Skip) {
+                // ignore rest of frame without parse
+                layerLen = __skipLen(codec, frame, layer, index);
+                if (IStream_available(stream) < layerLen) {
+                    return Codec_Status_Pending;
                 }
-            #endif // CODEC_DECODE_CALLBACK
+                IStream_ignore(stream, layerLen);
+                __rxStatsAdd(codec, FilterSkipped, 1);
+                __latencyCancel(codec);
+                filter = Codec_Filter_Accept;
+                // back to base layer
+                layer = codec->BaseLayer;
+                __layerIndex(index, 0);
+                __frameBegin(begin, stream);
+            }
+            else
+        #endif
+            if ((layer = __layerNext(codec, frame, layer, index, Codec_Phase_Decode)) == CODEC_LAYER_NULL) {
+                // frame received
+                __rxStatsAdd(codec, Decode.Frames, 1);
                 status = Codec_Status_Done;
                 break;
             }
         }
         // get layer len
-        layerLen = layer->getLen(codec, frame, Codec_Phase_Decode);
+        layerLen = __layerLen(codec, frame, layer, index, Codec_Phase_Decode);
+    }
+
+    return status;
+}
+/**
+ * @brief call onDecode callback for a parsed frame
+ *
+ * @param codec
+ * @param frame
+ */
+static void Codec_frameDecoded(Codec* codec, Codec_Frame* frame) {
+    __latencyEnd(codec);
+#if CODEC_DECODE_CALLBACK
+    if (codec->onDecode) {
+        codec->onDecode(codec, frame);
+    }
+#endif // CODEC_DECODE_CALLBACK
+}
+#if CODEC_MMAP || CODEC_DECODE_BATCH || (CODEC_DECODE_ASYNC && CODEC_DECODE_VIEW)
+/**
+ * @brief decode frames over held bytes of stream, all frames share a single hold of stream
+ * and frames after first one skip sync because they begin where previous frame ended,
+ * an incomplete frame kept in stream and only bytes before it released
+ *
+ * @param codec
+ * @param frames frame slots, with notify all frames decoded into first slot
+ * @param maxFrames max number of frames
+ * @param notify 1 to call onDecode of each frame, 0 to decode each frame into its own slot for caller
+ * @param stream
+ * @param skipped return number of noise bytes before last frame, NULL if not needed
+ * @return Stream_LenType number of decoded frames
+ */
+static Stream_LenType Codec_decodeHeld(Codec* codec, Codec_Frame* frames[], Stream_LenType maxFrames,
+                                       uint8_t notify, StreamIn* stream, Stream_LenType* skipped) {
+    StreamIn hold;
+    Codec_Frame* frame;
+    Codec_Status status;
+    Stream_LenType available = IStream_available(stream);
+    Stream_LenType remain;
+    Stream_LenType begin;
+    Stream_LenType count = 0;
+
+    if (skipped != NULL) {
+        *skipped = 0;
+    }
+    // hold bytes of all frames, so an incomplete frame can rewind to its begin
+    IStream_lock(stream, &hold, available);
+    while (count < maxFrames && (remain = IStream_available(&hold)) > 0) {
+        frame = notify ? frames[0] : frames[count];
+        status = Codec_parseFrame(codec, frame, &hold, &begin, count > 0);
+        if (skipped != NULL) {
+            *skipped = remain - begin;
+        }
+        if (status != Codec_Status_Done) {
+            // keep incomplete frame, just release decoded frames and noise bytes
+            IStream_unlockIgnore(stream);
+            IStream_ignore(stream, available - begin);
+            __rxStatsAdd(codec, Decode.Pending, begin > 0);
+            return count;
+        }
+        if (notify) {
+            Codec_frameDecoded(codec, frame);
+        }
+        else {
+            __latencyEnd(codec);
+        }
+        count++;
     }
+    // release bytes of decoded frames
+    IStream_unlock(stream, &hold);
 
+    return count;
+}
+#endif
+/**
+ * @brief decode a frame from a stream, all of frame bytes must exists
+ *
+ * @param codec
+ * @param stream
+ * @param frame
+ * @return Codec_Status
+ */
+Codec_Status Codec_decodeFrame(Codec* codec, Codec_Frame* frame, StreamIn* stream) {
+    Codec_Status status;
+#if CODEC_DECODE_VIEW
+    if (codec->DecodeView) {
+        StreamIn hold;
+        // keep frame bytes in stream buffer until onDecode returned
+        IStream_lock(stream, &hold, IStream_available(stream));
+        if ((status = Codec_parseFrame(codec, frame, &hold, NULL, 0)) == Codec_Status_Done) {
+            Codec_frameDecoded(codec, frame);
+        }
+    #if CODEC_STATS
+        else if (status == Codec_Status_Pending) {
+            __rxStats(codec).Decode.Pending++;
+        }
+    #endif
+        IStream_unlock(stream, &hold);
+        return status;
+    }
+#endif
+    if ((status = Codec_parseFrame(codec, frame, stream, NULL, 0)) == Codec_Status_Done) {
+        Codec_frameDecoded(codec, frame);
+    }
+#if CODEC_STATS
+    else if (status == Codec_Status_Pending) {
+        __rxStats(codec).Decode.Pending++;
+    }
+#endif
     return status;
 }
+#if CODEC_MMAP
+/**
+ * @brief decode a frame from a stream like Codec_decodeFrame, but an incomplete frame at end
+ * of stream is kept in stream and only noise bytes before it released, so decode can continue
+ * when rest of frame bytes received, and position of frame in stream is known from skipped
+ *
+ * @param codec
+ * @param frame
+ * @param stream
+ * @param skipped return number of noise bytes that released before begin of frame
+ * @return Codec_Status Codec_Status_Done if a frame decoded, otherwise Codec_Status_Pending
+ */
+Codec_Status Codec_decodeSpan(Codec* codec, Codec_Frame* frame, StreamIn* stream, Stream_LenType* skipped) {
+    return Codec_decodeHeld(codec, &frame, 1, 1, stream, skipped) > 0 ? Codec_Status_Done : Codec_Status_Pending;
+}
+#endif // CODEC_MMAP
+#if CODEC_DECODE_BATCH
+/**
+ * @brief decode up to maxFrames complete frames from stream into frames slots,
+ * frames share a single hold of stream and back to back frames skip sync,
+ * onDecode callback not called for batch frames, returned frames must process by caller,
+ * an incomplete frame keep in stream until rest of bytes received
+ * in view mode, views of returned frames are valid until stream receive new bytes
+ *
+ * @param codec
+ * @param frames array of frame slots
+ * @param maxFrames number of frame slots
+ * @param stream
+ * @return Stream_LenType number of decoded frames
+ */
+Stream_LenType Codec_decodeBatch(Codec* codec, Codec_Frame* frames[], Stream_LenType maxFrames, StreamIn* stream) {
+    return Codec_decodeHeld(codec, frames, maxFrames, 0, stream, NULL);
+}
+#endif // CODEC_DECODE_BATCH
 #if CODEC_DECODE_ASYNC
 /**
  * @brief begin of decode frame over stream
@@ -222,75 +1108,323 @@ Codec_Status Codec_decodeFrame(Codec* codec, Codec_Frame* frame, StreamIn* strea
  * @param frame
  */
 void Codec_beginDecode(Codec* codec, Codec_Frame* frame) {
-    codec->RxLayer = codec->BaseLayer;
-    codec->RxFrame = frame;
+    codec->Rx.Layer = codec->BaseLayer;
+    codec->Rx.Frame = frame;
+    __layerIndex(codec->Rx.Index, 0);
+#if CODEC_DECODE_CHUNK
+    codec->Rx.Offset = 0;
+#endif
+#if CODEC_DECODE_FILTER
+    codec->RxSkip = 0;
+#endif
+    __latencyCancel(codec);
 }
+#if CODEC_DECODE_VIEW
 /**
- * @brief decode frame over input stream
+ * @brief decode frames in view mode, each frame parsed when all of its bytes exists
+ * and bytes of frame released after onDecode returned, an incomplete frame parsed again
+ * from begin when more bytes received
  *
- * @param codec codec to decode
- * @param stream input stream to decode
+ * @param codec
+ * @param stream
  */
-void Codec_decode(Codec* codec, StreamIn* stream) {
-    Codec_Frame* frame = codec->RxFrame;
+static void Codec_decodeView(Codec* codec, StreamIn* stream) {
+    // each frame has at least one byte, so available bytes limit number of frames
+    Codec_decodeHeld(codec, &codec->Rx.Frame, codec->DecodeAll ? IStream_available(stream) : 1, 1, stream, NULL);
+}
+#endif // CODEC_DECODE_VIEW
+#if CODEC_DECODE_QUEUE
+/**
+ * @brief initialize decode queue
+ *
+ * @param queue
+ * @param frames pool of frame slots, one slot always used by decoder
+ * @param size number of slots
+ */
+void Codec_DecodeQueue_init(Codec_DecodeQueue* queue, Codec_Frame** frames, Stream_LenType size) {
+    queue->Frames = frames;
+    queue->Size = size;
+    queue->Head = 0;
+    queue->Tail = 0;
+}
+/**
+ * @brief return oldest decoded frame of queue without remove it, must call only from consumer side
+ *
+ * @param queue
+ * @return Codec_Frame* NULL if queue is empty
+ */
+Codec_Frame* Codec_DecodeQueue_peek(Codec_DecodeQueue* queue) {
+    Stream_LenType tail = queue->Tail;
+
+    if (tail == __queueLoad(&queue->Head)) {
+        return NULL;
+    }
+    return queue->Frames[tail];
+}
+/**
+ * @brief release oldest decoded frame, slot of frame given back to decoder
+ *
+ * @param queue
+ */
+void Codec_DecodeQueue_release(Codec_DecodeQueue* queue) {
+    Stream_LenType tail = queue->Tail;
+
+    if (tail != __queueLoad(&queue->Head)) {
+        __queueStore(&queue->Tail, __queueNext(queue, tail));
+    }
+}
+/**
+ * @brief return number of decoded frames waiting in queue
+ *
+ * @param queue
+ * @return Stream_LenType
+ */
+Stream_LenType Codec_DecodeQueue_available(Codec_DecodeQueue* queue) {
+    Stream_LenType head = __queueLoad(&queue->Head);
+    Stream_LenType tail = __queueLoad(&queue->Tail);
+    return __queueAvailable(queue, head, tail);
+}
+/**
+ * @brief set decode queue of codec, Codec_decode decode frames into free slots of queue
+ * and publish them after decoded, pass NULL to disable, queue is not used in view mode
+ *
+ * @param codec
+ * @param queue
+ */
+void Codec_setDecodeQueue(Codec* codec, Codec_DecodeQueue* queue) {
+    codec->RxQueue = queue;
+    codec->Rx.Layer = codec->BaseLayer;
+    __layerIndex(codec->Rx.Index, 0);
+#if CODEC_DECODE_CHUNK
+    codec->Rx.Offset = 0;
+#endif
+#if CODEC_DECODE_FILTER
+    codec->RxSkip = 0;
+#endif
+    if (queue) {
+        codec->Rx.Frame = queue->Frames[queue->Head];
+    }
+}
+/**
+ * @brief check there is a free slot to publish next frame, decoder wait for consumer
+ * instead of overwrite a frame that not released
+ *
+ * @param queue
+ * @return uint8_t
+ */
+static uint8_t Codec_decodeQueueFull(Codec_DecodeQueue* queue) {
+    return __queueNext(queue, queue->Head) == __queueLoad(&queue->Tail);
+}
+/**
+ * @brief publish decoded frame to consumer and move decoder to next slot
+ *
+ * @param codec
+ */
+static void Codec_decodeQueuePublish(Codec* codec) {
+    Codec_DecodeQueue* queue = codec->RxQueue;
+    Stream_LenType head = __queueNext(queue, queue->Head);
+
+    __queueStore(&queue->Head, head);
+    codec->Rx.Frame = queue->Frames[head];
+}
+#endif // CODEC_DECODE_QUEUE
+#if CODEC_DECODE_FILTER
+/**
+ * @brief ignore received bytes of a frame that skipped by decode filter
+ *
+ * @param codec
+ * @param stream
+ * @return Stream_LenType bytes of skipped frame that not received yet
+ */
+static Stream_LenType Codec_decodeSkip(Codec* codec, StreamIn* stream) {
+    Stream_LenType len = IStream_available(stream);
+
+    if (len > codec->RxSkip) {
+        len = codec->RxSkip;
+    }
+    IStream_ignore(stream, len);
+    codec->RxSkip -= len;
+    return codec->RxSkip;
+}
+#endif // CODEC_DECODE_FILTER
+/**
+ * @brief decode layers of cursor frame as long as stream has bytes of current layer,
+ * codec give sync, callbacks and per-codec features and cursor give position in frame
+ *
+ * @param codec
+ * @param rx position of decoder
+ * @param stream
+ * @return Codec_Status Done if a frame decoded, Pending if wait for more bytes
+ */
+static Codec_Status Codec_decodeLayers(Codec* codec, Codec_RxCursor* rx, StreamIn* stream) {
+    Codec_Frame* frame = rx->Frame;
     StreamIn lock;
     Codec_Error error;
+    Codec_Status status = Codec_Status_Pending;
     Stream_LenType layerLen;
+#if CODEC_DECODE_CHUNK
+    Stream_LenType chunkLen = 0;
+#endif
+#if CODEC_DECODE_FILTER
+    Codec_FilterResult filter;
+#endif
 
-    layerLen = codec->RxLayer->getLen(codec, frame, Codec_Phase_Decode);
-    while (IStream_available(stream) >= layerLen) {
+    layerLen = __layerLen(codec, frame, rx->Layer, rx->Index, Codec_Phase_Decode);
+    while (IStream_available(stream) >= __rxNeedLen(rx, layerLen)) {
     #if CODEC_DECODE_SYNC
-        if (codec->RxLayer == codec->BaseLayer && codec->sync) {
+        if (rx->Layer == codec->BaseLayer && __rxLayerBegin(rx) && codec->sync) {
             Stream_LenType available = IStream_available(stream);
             Stream_LenType len = codec->sync(codec, stream);
             if (len > 0) {
                 IStream_ignore(stream, len);
-                if (IStream_available(stream) < layerLen) {
+                __rxStatsAdd(codec, SyncSkipped, len);
+                __trace(codec, Sync, rx->Layer, Decode, len);
+                if (IStream_available(stream) < __rxNeedLen(rx, layerLen)) {
                     break;
                 }
             }
             else if (len == -1) {
                 if (codec->FreeStream) {
                     IStream_ignore(stream, available);
+                    __rxStatsAdd(codec, SyncSkipped, available);
+                    __trace(codec, Sync, rx->Layer, Decode, available);
                 }
                 break;
             }
         }
     #endif
-        // set limit for read header part
-        IStream_lock(stream, &lock, layerLen);
-        if ((error = codec->RxLayer->parse(codec, frame, &lock)) != CODEC_OK) {
+        if (rx->Layer == codec->BaseLayer && __rxLayerBegin(rx)) {
+            // first byte of frame
+            __latencyBegin(codec);
+            __rxSumBegin(codec);
+        }
+    #if CODEC_DECODE_CHUNK
+        if (rx->Layer->parseChunk) {
+            // parse whatever bytes of layer exists
+            Stream_LenType remaining = layerLen - rx->Offset;
+            if ((chunkLen = IStream_available(stream)) > remaining) {
+                chunkLen = remaining;
+            }
+            __trace(codec, Enter, rx->Layer, Decode, chunkLen);
+            IStream_lock(stream, &lock, chunkLen);
+            error = rx->Layer->parseChunk(codec, frame, &lock, rx->Offset, remaining);
+        }
+        else
+    #endif
+        {
+            __trace(codec, Enter, rx->Layer, Decode, layerLen);
+            // set limit for read header part
+            IStream_lock(stream, &lock, layerLen);
+            error = rx->Layer->parse(codec, frame, &lock);
+        }
+    #if CODEC_DECODE_FILTER
+        // chunk layer filtered after its last chunk
+        filter = Codec_Filter_Accept;
+        if (error == CODEC_OK && codec->filter && __rxLayerEnd(rx, &lock, chunkLen, layerLen) &&
+            (filter = codec->filter(codec, frame, rx->Layer)) == Codec_Filter_Abort) {
+            error = CODEC_ERROR_FILTER;
+        }
+    #endif
+        if (error != CODEC_OK) {
+            __statsError(codec, rx->Layer, error, Codec_Phase_Decode);
+            __latencyCancel(codec);
+            __trace(codec, Error, rx->Layer, Decode, error);
+            __trace(codec, Exit, rx->Layer, Decode, 0);
         #if CODEC_DECODE_ERROR
             if (codec->onDecodeError) {
-                codec->onDecodeError(codec, frame, codec->RxLayer, error);
+                codec->onDecodeError(codec, frame, rx->Layer, error);
             }
         #endif
             // back to base layer
-            codec->RxLayer = codec->BaseLayer;
+            rx->Layer = codec->BaseLayer;
+            __layerIndex(rx->Index, 0);
+        #if CODEC_DECODE_CHUNK
+            rx->Offset = 0;
+        #endif
             // unlock stream
             IStream_unlockIgnore(stream);
             // ignore one byte
             IStream_ignore(stream, 1);
+            __rxStatsAdd(codec, ErrorDropped, 1);
+        #if CODEC_DECODE_RESYNC
+            // jump to next frame candidate
+            if (codec->resync) {
+                Codec_resync(codec, stream);
+            }
+        #endif
         }
         else {
-        #if CODEC_DECODE_PADDING
-            if ((layerLen = IStream_availableUncheck(&lock)) > 0) {
-                // add padding
-                IStream_ignore(&lock, layerLen);
+        #if CODEC_DECODE_CHUNK
+            if (rx->Layer->parseChunk) {
+                chunkLen -= IStream_availableUncheck(&lock);
+                __rxSum(codec, stream, &lock);
+                // unlock stream, just parsed bytes
+                IStream_unlock(stream, &lock);
+                __rxStatsAdd(codec, Decode.Bytes, chunkLen);
+                __trace(codec, Exit, rx->Layer, Decode, chunkLen);
+                rx->Offset += chunkLen;
+                if (rx->Offset < layerLen) {
+                    if (chunkLen == 0) {
+                        // layer wait for more bytes
+                        break;
+                    }
+                    continue;
+                }
+                rx->Offset = 0;
             }
+            else
         #endif
-            // unlock stream
-            IStream_unlock(stream, &lock);
-            if ((codec->RxLayer = __nextLayer(codec, frame, codec->RxLayer, Codec_Phase_Decode)) == CODEC_LAYER_NULL
+            {
+                __rxStatsAdd(codec, Decode.Bytes, layerLen);
+                __trace(codec, Exit, rx->Layer, Decode, layerLen);
+            #if CODEC_DECODE_PADDING
+                if ((layerLen = IStream_availableUncheck(&lock)) > 0) {
+                    // add padding
+                    IStream_ignore(&lock, layerLen);
+                }
+            #endif
+                __rxSum(codec, stream, &lock);
+                // unlock stream
+                IStream_unlock(stream, &lock);
+            }
+        #if CODEC_DECODE_FILTER
+            if (filter == Codec_Filter_Skip) {
+                // ignore rest of frame without parse, it can continue in next calls
+                codec->RxSkip = __skipLen(codec, frame, rx->Layer, rx->Index);
+                __rxStatsAdd(codec, FilterSkipped, 1);
+                __latencyCancel(codec);
+                // back to base layer
+                rx->Layer = codec->BaseLayer;
+                __layerIndex(rx->Index, 0);
+                if (Codec_decodeSkip(codec, stream) > 0) {
+                    break;
+                }
+            }
+            else
+        #endif
+            if ((rx->Layer = __layerNext(codec, frame, rx->Layer, rx->Index, Codec_Phase_Decode)) == CODEC_LAYER_NULL
             ) {
                 // frame received
+                status = Codec_Status_Done;
+                __rxStatsAdd(codec, Decode.Frames, 1);
+                __latencyEnd(codec);
             #if CODEC_DECODE_CALLBACK
                 if (codec->onDecode) {
                     codec->onDecode(codec, frame);
                 }
             #endif // CODEC_DECODE_CALLBACK
                 // back to base layer
-                codec->RxLayer = codec->BaseLayer;
+                rx->Layer = codec->BaseLayer;
+                __layerIndex(rx->Index, 0);
+            #if CODEC_DECODE_QUEUE
+                if (codec->RxQueue) {
+                    Codec_decodeQueuePublish(codec);
+                    frame = rx->Frame;
+                    if (Codec_decodeQueueFull(codec->RxQueue)) {
+                        break;
+                    }
+                }
+            #endif
                 // a single frame detected
                 if (!codec->DecodeAll) {
                     break;
@@ -298,8 +1432,45 @@ void Codec_decode(Codec* codec, StreamIn* stream) {
             }
         }
         // get layer len
-        layerLen = codec->RxLayer->getLen(codec, frame, Codec_Phase_Decode);
+        layerLen = __layerLen(codec, frame, rx->Layer, rx->Index, Codec_Phase_Decode);
+    }
+#if CODEC_STATS
+    if (rx->Layer != codec->BaseLayer || !__rxLayerBegin(rx) || __rxSkip(codec) > 0) {
+        // frame wait for more bytes
+        __rxStats(codec).Decode.Pending++;
+    }
+#endif
+    return status;
+}
+/**
+ * @brief decode frame over input stream
+ *
+ * @param codec codec to decode
+ * @param stream input stream to decode
+ */
+void Codec_decode(Codec* codec, StreamIn* stream) {
+#if CODEC_DECODE_VIEW
+    if (codec->DecodeView) {
+        Codec_decodeView(codec, stream);
+        return;
+    }
+#endif
+#if CODEC_DECODE_FILTER
+    if (codec->RxSkip > 0 && Codec_decodeSkip(codec, stream) > 0) {
+        // rest of skipped frame not received yet
+        __rxStatsAdd(codec, Decode.Pending, 1);
+        return;
+    }
+#endif
+#if CODEC_DECODE_QUEUE
+    if (codec->RxQueue && codec->Rx.Layer == codec->BaseLayer && __rxLayerBegin(&codec->Rx) &&
+        Codec_decodeQueueFull(codec->RxQueue)) {
+        // no free slot for next frame
+        return;
     }
+#endif
+
+    Codec_decodeLayers(codec, &codec->Rx, stream);
 }
 #endif // CODEC_DECODE_ASYNC
 #endif // CODEC_DECODE
@@ -326,6 +1497,39 @@ void Codec_onEncodeError(Codec* codec, Codec_OnErrorFn fn) {
     codec->onEncodeError = fn;
 }
 #endif // CODEC_ENCODE_ERROR
+#if CODEC_CHECKSUM
+/**
+ * @brief set checksum that encoder run over bytes of layers, checksum restart on first layer
+ * of each frame and bytes of a layer added after its write succeeded,
+ * so a footer layer write checksum of previous layers with Codec_encodeChecksum
+ *
+ * @param codec
+ * @param impl NULL to disable checksum
+ */
+void Codec_setEncodeChecksum(Codec* codec, const Codec_ChecksumImpl* impl) {
+    codec->TxChecksum = impl;
+    codec->TxSum = impl != NULL ? impl->Init : 0;
+}
+/**
+ * @brief add bytes that written after end of stream into encode checksum,
+ * it's called before unlock so bytes are still after write position of stream
+ *
+ * @param codec
+ * @param stream
+ * @param len
+ */
+static void Codec_sumOut(Codec* codec, StreamOut* stream, Stream_LenType len) {
+    Stream_LenType direct = Stream_directSpace(&stream->Buffer);
+
+    if (direct > len) {
+        direct = len;
+    }
+    codec->TxSum = codec->TxChecksum->update(codec->TxSum, Stream_getWritePtr(&stream->Buffer), direct);
+    if (len > direct) {
+        codec->TxSum = codec->TxChecksum->update(codec->TxSum, Stream_getDataPtr(&stream->Buffer), len - direct);
+    }
+}
+#endif // CODEC_CHECKSUM
 #if CODEC_ENCODE_ON_BUFFER
 /**
  * @brief encode a frame to a buffer
@@ -356,11 +1560,19 @@ Codec_Status Codec_encodeFrame(Codec* codec, Codec_Frame* frame, StreamOut* stre
     Codec_Status status = Codec_Status_Pending;
     StreamOut lock;
     Codec_Error error;
+#if CODEC_COMPILE
+    Codec_LayerIndex index = 0;
+#endif
 
+    __txSumBegin(codec);
     while (layer != CODEC_LAYER_NULL &&
-            (layerLen = layer->getLen(codec, frame, Codec_Phase_Encode)) <= OStream_space(stream)) {
+            (layerLen = __layerLen(codec, frame, layer, index, Codec_Phase_Encode)) <= OStream_space(stream)) {
+        __trace(codec, Enter, layer, Encode, layerLen);
         OStream_lock(stream, &lock, layerLen);
         if((error = layer->write(codec, frame, &lock)) != CODEC_OK) {
+            __statsError(codec, layer, error, Codec_Phase_Encode);
+            __trace(codec, Error, layer, Encode, error);
+            __trace(codec, Exit, layer, Encode, 0);
         #if CODEC_ENCODE_ERROR
             if (codec->onEncodeError) {
                 codec->onEncodeError(codec, frame, layer, error);
@@ -370,6 +1582,8 @@ Codec_Status Codec_encodeFrame(Codec* codec, Codec_Frame* frame, StreamOut* stre
             return Codec_Status_Error;
         }
         else {
+            __txStatsAdd(codec, Encode.Bytes, layerLen);
+            __trace(codec, Exit, layer, Encode, layerLen);
         #if CODEC_ENCODE_PADDING
             if ((layerLen = OStream_spaceUncheck(&lock)) > 0) {
             #if CODEC_ENCODE_PADDING_MODE == CODEC_ENCODE_PADDING_IGNORE
@@ -379,16 +1593,18 @@ Codec_Status Codec_encodeFrame(Codec* codec, Codec_Frame* frame, StreamOut* stre
             #endif
             }
         #endif // CODEC_ENCODE_PADDING
+            __txSum(codec, stream, &lock);
             OStream_unlock(stream, &lock);
             if (Codec_EncodeMode_FlushLayer == mode) {
                 OStream_flush(stream);
             }
-            layer = __nextLayer(codec, frame, layer, Codec_Phase_Encode);
+            layer = __layerNext(codec, frame, layer, index, Codec_Phase_Encode);
         }
     }
 
     if (layer == CODEC_LAYER_NULL) {
         // done
+        __txStatsAdd(codec, Encode.Frames, 1);
     #if CODEC_ENCODE_CALLBACK
         if (codec->onEncode) {
             codec->onEncode(codec, frame);
@@ -400,9 +1616,256 @@ Codec_Status Codec_encodeFrame(Codec* codec, Codec_Frame* frame, StreamOut* stre
         }
         status = Codec_Status_Done;
     }
+#if CODEC_STATS
+    else {
+        __txStats(codec).Encode.Pending++;
+    }
+#endif
 
     return status;
 }
+#if CODEC_ENCODE_GATHER
+/**
+ * @brief initialize gather
+ *
+ * @param gather
+ * @param vec array of vectors
+ * @param size number of vectors
+ * @param scratch buffer for bytes of layers that not referenced
+ * @param scratchSize size of scratch buffer
+ */
+void Codec_Gather_init(Codec_Gather* gather, Codec_IoVec* vec, uint16_t size, uint8_t* scratch, Stream_LenType scratchSize) {
+    gather->Vec = vec;
+    gather->Size = size;
+    gather->Scratch = scratch;
+    gather->ScratchSize = scratchSize;
+    Codec_Gather_reset(gather);
+}
+/**
+ * @brief remove all vectors of gather
+ *
+ * @param gather
+ */
+void Codec_Gather_reset(Codec_Gather* gather) {
+    gather->ScratchLen = 0;
+    gather->Mark = 0;
+    gather->RefLen = 0;
+    gather->Count = 0;
+    gather->Index = 0;
+}
+/**
+ * @brief return number of bytes that not consumed yet
+ *
+ * @param gather
+ * @return Stream_LenType
+ */
+Stream_LenType Codec_Gather_len(const Codec_Gather* gather) {
+    Stream_LenType len = 0;
+    uint16_t i;
+
+    for (i = gather->Index; i < gather->Count; i++) {
+        len += gather->Vec[i].Len;
+    }
+    return len;
+}
+/**
+ * @brief consume sent bytes from begin of vectors, useful for partial writes
+ *
+ * @param gather
+ * @param len number of sent bytes
+ */
+void Codec_Gather_consume(Codec_Gather* gather, Stream_LenType len) {
+    Codec_IoVec* vec;
+
+    while (len > 0 && gather->Index < gather->Count) {
+        vec = &gather->Vec[gather->Index];
+        if (len < vec->Len) {
+            vec->Data += len;
+            vec->Len -= len;
+            break;
+        }
+        len -= vec->Len;
+        gather->Index++;
+    }
+}
+/**
+ * @brief add scratch bytes from mark to end into vectors, merge with last vector if they are contiguous
+ *
+ * @param gather
+ * @param end end of scratch bytes
+ * @return Codec_Error
+ */
+static Codec_Error Codec_gatherCut(Codec_Gather* gather, Stream_LenType end) {
+    Codec_IoVec* last = gather->Count > 0 ? &gather->Vec[gather->Count - 1] : NULL;
+
+    if (end > gather->Mark) {
+        if (last != NULL && last->Data + last->Len == gather->Scratch + gather->Mark) {
+            last->Len += end - gather->Mark;
+        }
+        else {
+            if (gather->Count >= gather->Size) {
+                return CODEC_ERROR_GATHER;
+            }
+            last = &gather->Vec[gather->Count++];
+            last->Data = gather->Scratch + gather->Mark;
+            last->Len = end - gather->Mark;
+        }
+        gather->Mark = end;
+    }
+    return CODEC_OK;
+}
+#if CODEC_CHECKSUM
+/**
+ * @brief add scratch bytes of current layer that written after last call into encode checksum
+ *
+ * @param codec
+ * @param gather
+ * @param stream stream of layer
+ */
+static void Codec_sumGather(Codec* codec, Codec_Gather* gather, StreamOut* stream) {
+    Stream_LenType pending = OStream_pendingBytes(stream);
+
+    if (pending > codec->TxSumMark) {
+        codec->TxSum = codec->TxChecksum->update(codec->TxSum, gather->Scratch + gather->ScratchLen + codec->TxSumMark, pending - codec->TxSumMark);
+        codec->TxSumMark = pending;
+    }
+}
+#endif // CODEC_CHECKSUM
+/**
+ * @brief write bytes that must not copy, in gather encode data referenced as separate vector
+ * otherwise it's written into stream, use it inside write function of layers
+ *
+ * @param codec
+ * @param stream stream of layer
+ * @param data
+ * @param len
+ * @return Codec_Error
+ */
+Codec_Error Codec_writeRef(Codec* codec, StreamOut* stream, const uint8_t* data, Stream_LenType len) {
+    Codec_Gather* gather = codec->TxGather;
+    Codec_Error error;
+
+    if (gather == NULL) {
+        error = OStream_writeBytes(stream, (uint8_t*) data, len);
+        return error != Stream_Ok ? error | CODEC_ERROR_STREAM : CODEC_OK;
+    }
+    if (len == 0) {
+        return CODEC_OK;
+    }
+#if CODEC_CHECKSUM
+    if (codec->TxChecksum != NULL) {
+        // keep order of layer bytes and referenced bytes in checksum
+        Codec_sumGather(codec, gather, stream);
+        codec->TxSum = codec->TxChecksum->update(codec->TxSum, data, len);
+    }
+#endif
+    // layer stream begin at end of used scratch
+    if ((error = Codec_gatherCut(gather, gather->ScratchLen + OStream_pendingBytes(stream))) != CODEC_OK) {
+        return error;
+    }
+    if (gather->Count >= gather->Size) {
+        return CODEC_ERROR_GATHER;
+    }
+    gather->Vec[gather->Count].Data = data;
+    gather->Vec[gather->Count].Len = len;
+    gather->Count++;
+    gather->RefLen += len;
+    return CODEC_OK;
+}
+/**
+ * @brief encode a frame into vectors of gather, bytes of layers written in scratch buffer
+ * and bytes that written with Codec_writeRef referenced directly,
+ * frames can append to gather until send all of them at once
+ *
+ * @param codec
+ * @param frame
+ * @param gather
+ * @return Codec_Status Done if frame encoded, Error if layer failed or gather is full
+ */
+Codec_Status Codec_encodeGather(Codec* codec, Codec_Frame* frame, Codec_Gather* gather) {
+    Codec_LayerImpl* layer = codec->BaseLayer;
+    Stream_LenType layerLen;
+    Stream_LenType lockLen;
+    Stream_LenType scratchLen = gather->ScratchLen;
+    uint16_t count = gather->Count;
+    Stream_LenType lastLen = count > 0 ? gather->Vec[count - 1].Len : 0;
+    StreamOut lock;
+    Codec_Error error = CODEC_OK;
+#if CODEC_COMPILE
+    Codec_LayerIndex index = 0;
+#endif
+
+    codec->TxGather = gather;
+    __txSumBegin(codec);
+    while (layer != CODEC_LAYER_NULL) {
+        layerLen = __layerLen(codec, frame, layer, index, Codec_Phase_Encode);
+        // referenced bytes don't need scratch, so layer can be bigger than scratch space
+        lockLen = gather->ScratchSize - gather->ScratchLen;
+        if (lockLen > layerLen) {
+            lockLen = layerLen;
+        }
+        OStream_init(&lock, NULL, gather->Scratch + gather->ScratchLen, lockLen);
+        gather->RefLen = 0;
+    #if CODEC_CHECKSUM
+        codec->TxSumMark = 0;
+    #endif
+        if ((error = layer->write(codec, frame, &lock)) != CODEC_OK) {
+            break;
+        }
+        __txStatsAdd(codec, Encode.Bytes, layerLen);
+        layerLen -= OStream_pendingBytes(&lock) + gather->RefLen;
+    #if CODEC_ENCODE_PADDING
+        if (layerLen > 0) {
+            if (layerLen > OStream_space(&lock)) {
+                error = CODEC_ERROR_GATHER;
+                break;
+            }
+        #if CODEC_ENCODE_PADDING_MODE == CODEC_ENCODE_PADDING_IGNORE
+            OStream_ignore(&lock, layerLen);
+        #else
+            OStream_writePadding(&lock, (uint8_t) CODEC_ENCODE_PADDING_VALUE, layerLen);
+        #endif
+        }
+    #endif // CODEC_ENCODE_PADDING
+    #if CODEC_CHECKSUM
+        if (codec->TxChecksum != NULL) {
+            Codec_sumGather(codec, gather, &lock);
+        }
+    #endif
+        gather->ScratchLen += OStream_pendingBytes(&lock);
+        layer = __layerNext(codec, frame, layer, index, Codec_Phase_Encode);
+    }
+    if (error == CODEC_OK) {
+        error = Codec_gatherCut(gather, gather->ScratchLen);
+    }
+    codec->TxGather = NULL;
+
+    if (error != CODEC_OK) {
+        __statsError(codec, layer, error, Codec_Phase_Encode);
+    #if CODEC_ENCODE_ERROR
+        if (codec->onEncodeError) {
+            codec->onEncodeError(codec, frame, layer, error);
+        }
+    #endif
+        // remove vectors of failed frame, last vector may be extended by frame
+        gather->ScratchLen = scratchLen;
+        gather->Mark = scratchLen;
+        gather->Count = count;
+        if (count > 0) {
+            gather->Vec[count - 1].Len = lastLen;
+        }
+        return Codec_Status_Error;
+    }
+
+    __txStatsAdd(codec, Encode.Frames, 1);
+#if CODEC_ENCODE_CALLBACK
+    if (codec->onEncode) {
+        codec->onEncode(codec, frame);
+    }
+#endif // CODEC_ENCODE_CALLBACK
+    return Codec_Status_Done;
+}
+#endif // CODEC_ENCODE_GATHER
 #if CODEC_ENCODE_ASYNC
 /**
  * @brief set encode mode
@@ -420,41 +1883,53 @@ void Codec_encodeMode(Codec* codec, Codec_EncodeMode mode) {
  * @param frame
  */
 void Codec_beginEncode(Codec* codec, Codec_Frame* frame, Codec_EncodeMode mode) {
-    codec->TxLayer = codec->BaseLayer;
-    codec->TxFrame = frame;
+    codec->Tx.Layer = codec->BaseLayer;
+    codec->Tx.Frame = frame;
     codec->EncodeMode = mode;
+    __layerIndex(codec->Tx.Index, 0);
 }
 /**
- * @brief encode a frame to output stream
+ * @brief encode layers of cursor frame as long as output stream has space,
+ * codec give callbacks and per-codec features and cursor give position in frame
  *
  * @param codec
- * @param frame
+ * @param tx position of encoder
  * @param stream
- * @param mode encode mode
- * @return Codec_Error
+ * @return Codec_Status Done when frame encoded, Pending when need more space
  */
-void Codec_encode(Codec* codec, StreamOut* stream) {
-    Codec_Frame* frame = codec->TxFrame;
+static Codec_Status Codec_encodeLayers(Codec* codec, Codec_TxCursor* tx, StreamOut* stream) {
+    Codec_Frame* frame = tx->Frame;
     StreamOut lock;
     Codec_Error error;
     Stream_LenType layerLen;
 
-    while (codec->TxLayer != CODEC_LAYER_NULL &&
-            (layerLen = codec->TxLayer->getLen(codec, frame, Codec_Phase_Encode)) <= OStream_space(stream)) {
+    while (tx->Layer != CODEC_LAYER_NULL &&
+            (layerLen = __layerLen(codec, frame, tx->Layer, tx->Index, Codec_Phase_Encode)) <= OStream_space(stream)) {
+        if (tx->Layer == codec->BaseLayer) {
+            // first byte of frame
+            __txSumBegin(codec);
+        }
+        __trace(codec, Enter, tx->Layer, Encode, layerLen);
         OStream_lock(stream, &lock, layerLen);
-        if((error = codec->TxLayer->write(codec, frame, &lock)) != CODEC_OK) {
+        if((error = tx->Layer->write(codec, frame, &lock)) != CODEC_OK) {
+            __statsError(codec, tx->Layer, error, Codec_Phase_Encode);
+            __trace(codec, Error, tx->Layer, Encode, error);
+            __trace(codec, Exit, tx->Layer, Encode, 0);
         #if CODEC_ENCODE_ERROR
             if (codec->onEncodeError) {
-                codec->onEncodeError(codec, frame, codec->TxLayer, error);
+                codec->onEncodeError(codec, frame, tx->Layer, error);
             }
         #endif
             // unlock stream
             OStream_unlockIgnore(stream);
             // back to base layer
-            codec->TxLayer = codec->BaseLayer;
-            return;
+            tx->Layer = codec->BaseLayer;
+            __layerIndex(tx->Index, 0);
+            return Codec_Status_Error;
         }
         else {
+            __txStatsAdd(codec, Encode.Bytes, layerLen);
+            __trace(codec, Exit, tx->Layer, Encode, layerLen);
         #if CODEC_ENCODE_PADDING
             if ((layerLen = OStream_spaceUncheck(&lock)) > 0) {
             #if CODEC_ENCODE_PADDING_MODE == CODEC_ENCODE_PADDING_IGNORE
@@ -464,16 +1939,18 @@ void Codec_encode(Codec* codec, StreamOut* stream) {
             #endif
             }
         #endif // CODEC_ENCODE_PADDING
+            __txSum(codec, stream, &lock);
             OStream_unlock(stream, &lock);
             if (Codec_EncodeMode_FlushLayer == codec->EncodeMode) {
                 OStream_flush(stream);
             }
-            codec->TxLayer = __nextLayer(codec, frame, codec->TxLayer, Codec_Phase_Encode);
+            tx->Layer = __layerNext(codec, frame, tx->Layer, tx->Index, Codec_Phase_Encode);
         }
     }
 
-    if (codec->TxLayer == NULL) {
+    if (tx->Layer == NULL) {
         // done
+        __txStatsAdd(codec, Encode.Frames, 1);
     #if CODEC_ENCODE_CALLBACK
         if (codec->onEncode) {
             codec->onEncode(codec, frame);
@@ -483,7 +1960,125 @@ void Codec_encode(Codec* codec, StreamOut* stream) {
         if ((codec->EncodeMode & Codec_EncodeMode_Flush) != 0) {
             OStream_flush(stream);
         }
+        return Codec_Status_Done;
     }
+
+    __txStatsAdd(codec, Encode.Pending, 1);
+    return Codec_Status_Pending;
+}
+#if CODEC_ENCODE_QUEUE
+/**
+ * @brief initialize encode queue
+ *
+ * @param queue
+ * @param frames array of frame slots, one slot always kept empty
+ * @param size number of slots
+ */
+void Codec_EncodeQueue_init(Codec_EncodeQueue* queue, Codec_Frame** frames, Stream_LenType size) {
+    queue->Frames = frames;
+    queue->Size = size;
+    queue->Head = 0;
+    queue->Tail = 0;
+}
+/**
+ * @brief push a frame into encode queue, must call only from producer side,
+ * frame must not change until onEncode callback for it called
+ *
+ * @param queue
+ * @param frame
+ * @return Codec_Status Done if frame pushed, Pending if queue is full
+ */
+Codec_Status Codec_EncodeQueue_push(Codec_EncodeQueue* queue, Codec_Frame* frame) {
+    Stream_LenType head = queue->Head;
+    Stream_LenType next = __queueNext(queue, head);
+
+    if (next == __queueLoad(&queue->Tail)) {
+        return Codec_Status_Pending;
+    }
+    queue->Frames[head] = frame;
+    // publish frame to consumer
+    __queueStore(&queue->Head, next);
+    return Codec_Status_Done;
+}
+/**
+ * @brief return number of frames waiting in queue
+ *
+ * @param queue
+ * @return Stream_LenType
+ */
+Stream_LenType Codec_EncodeQueue_available(Codec_EncodeQueue* queue) {
+    Stream_LenType head = __queueLoad(&queue->Head);
+    Stream_LenType tail = __queueLoad(&queue->Tail);
+    return __queueAvailable(queue, head, tail);
+}
+/**
+ * @brief return number of free slots in queue
+ *
+ * @param queue
+ * @return Stream_LenType
+ */
+Stream_LenType Codec_EncodeQueue_space(Codec_EncodeQueue* queue) {
+    return queue->Size - Codec_EncodeQueue_available(queue) - 1;
+}
+/**
+ * @brief set encode queue of codec, Codec_encode drain queue into output stream
+ * without need to call Codec_beginEncode, pass NULL to disable
+ *
+ * @param codec
+ * @param queue
+ */
+void Codec_setEncodeQueue(Codec* codec, Codec_EncodeQueue* queue) {
+    codec->TxQueue = queue;
+    codec->Tx.Frame = NULL;
+    codec->Tx.Layer = codec->BaseLayer;
+    __layerIndex(codec->Tx.Index, 0);
+}
+/**
+ * @brief encode frames of queue until queue is empty or output stream is full,
+ * slot of frame released after frame encoded or failed
+ *
+ * @param codec
+ * @param stream
+ */
+static void Codec_encodeQueue(Codec* codec, StreamOut* stream) {
+    Codec_EncodeQueue* queue = codec->TxQueue;
+    Stream_LenType tail = queue->Tail;
+
+    for (;;) {
+        if (codec->Tx.Frame == NULL) {
+            if (tail == __queueLoad(&queue->Head)) {
+                // queue is empty
+                break;
+            }
+            codec->Tx.Frame = queue->Frames[tail];
+            codec->Tx.Layer = codec->BaseLayer;
+            __layerIndex(codec->Tx.Index, 0);
+        }
+        if (Codec_encodeLayers(codec, &codec->Tx, stream) == Codec_Status_Pending) {
+            break;
+        }
+        // release slot to producer
+        codec->Tx.Frame = NULL;
+        tail = __queueNext(queue, tail);
+        __queueStore(&queue->Tail, tail);
+    }
+}
+#endif // CODEC_ENCODE_QUEUE
+/**
+ * @brief encode frame to output stream, if encode queue is set
+ * encode frames of queue one after another
+ *
+ * @param codec
+ * @param stream
+ */
+void Codec_encode(Codec* codec, StreamOut* stream) {
+#if CODEC_ENCODE_QUEUE
+    if (codec->TxQueue) {
+        Codec_encodeQueue(codec, stream);
+        return;
+    }
+#endif
+    Codec_encodeLayers(codec, &codec->Tx, stream);
 }
 #endif // CODEC_ENCODE_ASYNC
 #endif // CODEC_ENCODE
@@ -508,6 +2103,240 @@ void Codec_setDecodeAll(Codec* codec, uint8_t enabled) {
     codec->DecodeAll = enabled != 0;
 }
 
+#if CODEC_PROTOCOL
+/**
+ * @brief initialize protocol, base codec initialized and layers table filled by walking
+ * fixed next layers from base layer, layers with dynamic next layer must be added
+ * with Codec_Protocol_addLayer, configure sync and callbacks on Codec_Protocol_codec
+ *
+ * @param proto
+ * @param baseLayer
+ * @param layers table of layers
+ * @param size size of layers table
+ * @return Codec_LayerIndex number of layers in table
+ */
+Codec_LayerIndex Codec_Protocol_init(Codec_Protocol* proto, Codec_LayerImpl* baseLayer, Codec_LayerImpl** layers, Codec_LayerIndex size) {
+    Codec_LayerImpl* layer = baseLayer;
+
+    Codec_init(&proto->Base, baseLayer);
+    proto->Layers = layers;
+    proto->Size = size;
+    proto->LayersLen = 0;
+    while (layer != CODEC_LAYER_NULL && Codec_Protocol_addLayer(proto, layer) != CODEC_LAYER_INDEX_END) {
+    #if CODEC_LAYER_FIXED
+        if ((layer->Flags & CODEC_LAYER_FIXED_NEXT) == 0) {
+            break;
+        }
+        layer = layer->FixedNext;
+    #else
+        break;
+    #endif
+    }
+    return proto->LayersLen;
+}
+/**
+ * @brief add a layer into protocol layers table, layer that returned by a nextLayer function
+ * must exists in table
+ *
+ * @param proto
+ * @param layer
+ * @return Codec_LayerIndex index of layer, CODEC_LAYER_INDEX_END if table is full
+ */
+Codec_LayerIndex Codec_Protocol_addLayer(Codec_Protocol* proto, Codec_LayerImpl* layer) {
+    Codec_LayerIndex index = Codec_Protocol_indexOf(proto, layer);
+
+    if (index == CODEC_LAYER_INDEX_END && proto->LayersLen < proto->Size) {
+        index = proto->LayersLen++;
+        proto->Layers[index] = layer;
+    }
+    return index;
+}
+/**
+ * @brief return index of layer in protocol
+ *
+ * @param proto
+ * @param layer
+ * @return Codec_LayerIndex CODEC_LAYER_INDEX_END if layer not found
+ */
+Codec_LayerIndex Codec_Protocol_indexOf(const Codec_Protocol* proto, const Codec_LayerImpl* layer) {
+    Codec_LayerIndex index;
+
+    for (index = 0; index < proto->LayersLen; index++) {
+        if (proto->Layers[index] == layer) {
+            return index;
+        }
+    }
+    return CODEC_LAYER_INDEX_END;
+}
+/**
+ * @brief return index of layer, layers usually added in order so check current and next entry first
+ *
+ * @param proto
+ * @param index index of previous layer
+ * @param layer
+ * @return Codec_LayerIndex CODEC_LAYER_INDEX_END if layer not found
+ */
+static Codec_LayerIndex Codec_Protocol_seek(const Codec_Protocol* proto, Codec_LayerIndex index, const Codec_LayerImpl* layer) {
+    if (proto->Layers[index] == layer) {
+        return index;
+    }
+    if (index + 1 < proto->LayersLen && proto->Layers[index + 1] == layer) {
+        return index + 1;
+    }
+    return Codec_Protocol_indexOf(proto, layer);
+}
+/**
+ * @brief initialize connection state, ready to decode and nothing to encode
+ *
+ * @param state
+ */
+void Codec_State_init(Codec_State* state) {
+#if CODEC_DECODE && CODEC_DECODE_ASYNC
+    Codec_State_beginDecode(state);
+#endif
+#if CODEC_ENCODE && CODEC_ENCODE_ASYNC
+    state->TxLayer = CODEC_LAYER_INDEX_END;
+#endif
+}
+#if CODEC_DECODE && CODEC_DECODE_ASYNC
+/**
+ * @brief check base codec don't use decode features that keep state of current frame in codec
+ *
+ * @param codec
+ * @return uint8_t 1 if connections can decode with codec
+ */
+static uint8_t Codec_Protocol_canDecode(const Codec* codec) {
+#if CODEC_DECODE_VIEW
+    if (codec->DecodeView) {
+        return 0;
+    }
+#endif
+#if CODEC_DECODE_QUEUE
+    if (codec->RxQueue) {
+        return 0;
+    }
+#endif
+#if CODEC_DECODE_FILTER
+    if (codec->filter) {
+        return 0;
+    }
+#endif
+#if CODEC_CHECKSUM
+    if (codec->RxChecksum) {
+        return 0;
+    }
+#endif
+#if CODEC_DECODE_LATENCY
+    if (codec->clock) {
+        return 0;
+    }
+#endif
+    return 1;
+}
+/**
+ * @brief decode frames of a connection with Codec_decode loop, can be called again with more bytes
+ * until frame completed, frame must be same between calls, sync, resync, chunk layers
+ * and DecodeAll of base codec are supported
+ *
+ * @param proto shared protocol, its Base codec passed to layers and callbacks
+ * @param state state of connection
+ * @param frame frame of connection
+ * @param stream input stream of connection
+ * @return Codec_Status Done when a frame decoded and onDecode called, Pending when need more bytes,
+ * Error if base codec use a rejected feature or decoder wait on a layer that does not exists in protocol
+ */
+Codec_Status Codec_State_decode(Codec_Protocol* proto, Codec_State* state, Codec_Frame* frame, StreamIn* stream) {
+    Codec* codec = &proto->Base;
+    Codec_RxCursor rx;
+    Codec_Status status;
+
+    if (state->RxLayer >= proto->LayersLen || !Codec_Protocol_canDecode(codec)) {
+        Codec_State_beginDecode(state);
+        return Codec_Status_Error;
+    }
+    rx.Layer = proto->Layers[state->RxLayer];
+    rx.Frame = frame;
+    // only base layer has a known place in compiled chain, other layers read their fixed fields
+    __layerIndex(rx.Index, state->RxLayer == 0 ? 0 : codec->ChainLen);
+#if CODEC_DECODE_CHUNK
+    rx.Offset = state->RxOffset;
+#endif
+
+    status = Codec_decodeLayers(codec, &rx, stream);
+    if ((state->RxLayer = Codec_Protocol_seek(proto, state->RxLayer, rx.Layer)) == CODEC_LAYER_INDEX_END) {
+        // layer is not part of protocol
+        Codec_State_beginDecode(state);
+        return Codec_Status_Error;
+    }
+#if CODEC_DECODE_CHUNK
+    state->RxOffset = rx.Offset;
+#endif
+    return status;
+}
+#endif // CODEC_DECODE && CODEC_DECODE_ASYNC
+#if CODEC_ENCODE && CODEC_ENCODE_ASYNC
+/**
+ * @brief check base codec don't use encode features that keep state of current frame in codec
+ *
+ * @param codec
+ * @return uint8_t 1 if connections can encode with codec
+ */
+static uint8_t Codec_Protocol_canEncode(const Codec* codec) {
+#if CODEC_ENCODE_GATHER
+    if (codec->TxGather) {
+        return 0;
+    }
+#endif
+#if CODEC_CHECKSUM
+    if (codec->TxChecksum) {
+        return 0;
+    }
+#endif
+    return 1;
+}
+/**
+ * @brief encode a frame of a connection with Codec_encode loop, start with Codec_State_beginEncode
+ * then call again while it's pending and output stream has more space, frame must be same between calls
+ *
+ * @param proto shared protocol, its Base codec passed to layers and callbacks
+ * @param state state of connection
+ * @param frame frame of connection
+ * @param stream output stream of connection
+ * @return Codec_Status Done when frame encoded or no frame to encode, Pending when need more space,
+ * Error if base codec use a rejected feature, a layer failed or encoder wait on a layer
+ * that does not exists in protocol, encode restart from base layer
+ */
+Codec_Status Codec_State_encode(Codec_Protocol* proto, Codec_State* state, Codec_Frame* frame, StreamOut* stream) {
+    Codec* codec = &proto->Base;
+    Codec_TxCursor tx;
+    Codec_Status status;
+
+    if (state->TxLayer == CODEC_LAYER_INDEX_END) {
+        return Codec_Status_Done;
+    }
+    if (state->TxLayer >= proto->LayersLen || !Codec_Protocol_canEncode(codec)) {
+        state->TxLayer = 0;
+        return Codec_Status_Error;
+    }
+    tx.Layer = proto->Layers[state->TxLayer];
+    tx.Frame = frame;
+    // only base layer has a known place in compiled chain, other layers read their fixed fields
+    __layerIndex(tx.Index, state->TxLayer == 0 ? 0 : codec->ChainLen);
+
+    status = Codec_encodeLayers(codec, &tx, stream);
+    if (status == Codec_Status_Done) {
+        state->TxLayer = CODEC_LAYER_INDEX_END;
+    }
+    else if ((state->TxLayer = Codec_Protocol_seek(proto, state->TxLayer, tx.Layer)) == CODEC_LAYER_INDEX_END) {
+        // layer is not part of protocol
+        state->TxLayer = 0;
+        return Codec_Status_Error;
+    }
+    return status;
+}
+#endif // CODEC_ENCODE && CODEC_ENCODE_ASYNC
+#endif // CODEC_PROTOCOL
+
 #if !CODEC_SUPPORT_NEXT_LAYER_NULL
 /**
  * @brief return next layer of packet, return null if it's last layer
@@ -38,6 +38,14 @@ extern "C" {
 #endif
 #endif // CODEC_DECODE
 
+#if CODEC_COMPILE && !CODEC_LAYER_FIXED
+    #error "CODEC_COMPILE use CODEC_LAYER_FIXED, you must enable it"
+#endif
+
+#if CODEC_PROTOCOL && CODEC_STATS
+    #error "CODEC_PROTOCOL connections share base codec and can't count into its stats, you must disable one of them"
+#endif
+
 #if CODEC_SUPPORT_MACRO
     #include "CodecMacro.h"
 #endif // CODEC_SUPPORT_MACRO
@@ -60,10 +68,34 @@ extern "C" {
  * @brief return base stream errors
  */
 #define CODEC_ERROR_STREAM      ((Codec_Error) 0x1000)
+/**
+ * @brief return when vectors or scratch buffer of gather is full
+ */
+#define CODEC_ERROR_GATHER      ((Codec_Error) 0x2000)
+/**
+ * @brief return when decode filter aborted a frame
+ */
+#define CODEC_ERROR_FILTER      ((Codec_Error) 0x3000)
 /**
  * @brief return null when it's last layer
  */
 #define CODEC_LAYER_NULL        ((void*) 0)
+/**
+ * @brief layer flag, length of layer is FixedLen for all frames and phases, getLen not called
+ */
+#define CODEC_LAYER_FIXED_LEN   0x01
+/**
+ * @brief layer flag, next layer of layer is FixedNext for all frames and phases, nextLayer not called
+ */
+#define CODEC_LAYER_FIXED_NEXT  0x02
+/**
+ * @brief layer flag, both length and next layer of layer are fixed
+ */
+#define CODEC_LAYER_STATIC      (CODEC_LAYER_FIXED_LEN | CODEC_LAYER_FIXED_NEXT)
+/**
+ * @brief length of compiled layer that must get from getLen
+ */
+#define CODEC_LAYER_LEN_DYNAMIC ((Stream_LenType) -1)
 
 /* Pre-define data types */
 struct __Codec;
@@ -84,16 +116,73 @@ typedef enum {
 } Codec_Phase;
 
 #if CODEC_DECODE
+#if CODEC_DECODE_VIEW
+/**
+ * @brief hold a view of bytes inside stream buffer,
+ * second segment is used when bytes wrapped around end of buffer
+ */
+typedef struct {
+    uint8_t*                Data[2];
+    Stream_LenType          Len[2];
+} Codec_View;
+#endif
 /**
  * @brief this function parse layer from input stream
  */
 typedef Codec_Error (*Codec_ParseFn)(Codec* codec, Codec_Frame* frame, StreamIn* stream);
+#if CODEC_DECODE_CHUNK
+/**
+ * @brief this function parse a chunk of layer from input stream, stream hold bytes of layer
+ * that received so far, offset is number of layer bytes parsed before and remaining is number
+ * of layer bytes that not parsed yet, unread bytes of chunk are passed again in next call
+ */
+typedef Codec_Error (*Codec_ParseChunkFn)(Codec* codec, Codec_Frame* frame, StreamIn* stream, Stream_LenType offset, Stream_LenType remaining);
+#endif
+#if CODEC_DECODE_FILTER
+/**
+ * @brief result of decode filter
+ */
+typedef enum {
+    Codec_Filter_Accept         = 0,            /**< continue decode of frame */
+    Codec_Filter_Skip           = 1,            /**< frame not wanted, rest of frame ignored without parse */
+    Codec_Filter_Abort          = 2,            /**< frame is not valid, handled like a failed layer */
+} Codec_FilterResult;
+/**
+ * @brief this function is called after a layer parsed, it decide frame is wanted or not
+ * from layers that parsed so far
+ */
+typedef Codec_FilterResult (*Codec_FilterFn)(Codec* codec, Codec_Frame* frame, Codec_LayerImpl* layer);
+#endif
 #endif // CODEC_DECODE
 #if CODEC_ENCODE
 /**
  * @brief this function write layer into output stream
  */
 typedef Codec_Error (*Codec_WriteFn)(Codec* codec, Codec_Frame* frame, StreamOut* stream);
+#if CODEC_ENCODE_GATHER
+/**
+ * @brief hold a segment of encoded frame
+ */
+typedef struct {
+    const uint8_t*          Data;
+    Stream_LenType          Len;
+} Codec_IoVec;
+/**
+ * @brief hold vectors of scatter-gather encode, layers bytes written in scratch buffer
+ * and referenced payloads added as separate vectors
+ */
+typedef struct {
+    Codec_IoVec*            Vec;
+    uint8_t*                Scratch;
+    Stream_LenType          ScratchSize;
+    Stream_LenType          ScratchLen;     /**< used bytes of scratch */
+    Stream_LenType          Mark;           /**< begin of scratch bytes that not added into vectors yet */
+    Stream_LenType          RefLen;         /**< referenced bytes of current layer */
+    uint16_t                Size;
+    uint16_t                Count;
+    uint16_t                Index;          /**< first vector that not consumed yet */
+} Codec_Gather;
+#endif
 #endif // CODEC_ENCODE
 /**
  * @brief this function return size of layer in bytes
@@ -115,6 +204,34 @@ typedef void (*Codec_OnErrorFn)(Codec* codec, Codec_Frame* frame, Codec_LayerImp
  * @brief this function used to sync frame with stream in decoding
  */
 typedef Stream_LenType (*Codec_SyncFn)(Codec* codec, StreamIn* stream);
+#if CODEC_CHECKSUM
+/**
+ * @brief this function update checksum with bytes, return checksum of previous bytes and data
+ */
+typedef uint32_t (*Codec_ChecksumFn)(uint32_t sum, const uint8_t* data, Stream_LenType len);
+/**
+ * @brief checksum algorithm that codec run over bytes of layers of a frame
+ */
+typedef struct {
+    Codec_ChecksumFn        update;
+    uint32_t                Init;           /**< checksum of no bytes */
+} Codec_ChecksumImpl;
+#endif
+#if CODEC_DECODE && CODEC_DECODE_LATENCY
+/**
+ * @brief this function return current time in ticks, unit of ticks is chosen by user
+ */
+typedef Codec_Tick (*Codec_ClockFn)(Codec* codec);
+/**
+ * @brief log-bucketed histogram of ticks, each power of two split into 4 buckets
+ */
+typedef struct {
+    Codec_StatsCounter      Buckets[CODEC_DECODE_LATENCY_BUCKETS];
+    Codec_StatsCounter      Count;
+    Codec_Tick              Min;
+    Codec_Tick              Max;
+} Codec_Histogram;
+#endif
 /**
  * @brief decode/encode states
  */
@@ -144,19 +261,153 @@ struct __Codec_LayerImpl {
 #endif
     Codec_GetLenFn          getLen;
     Codec_NextLayerFn       nextLayer;
+#if CODEC_DECODE && CODEC_DECODE_CHUNK
+    Codec_ParseChunkFn      parseChunk;     /**< optional, parse layer incrementally in async decode */
+#endif
+#if CODEC_LAYER_FIXED
+    uint8_t                 Flags;          /**< optional, CODEC_LAYER_FIXED_LEN and CODEC_LAYER_FIXED_NEXT */
+    Stream_LenType          FixedLen;       /**< length of layer when CODEC_LAYER_FIXED_LEN is set */
+    Codec_LayerImpl*        FixedNext;      /**< next layer when CODEC_LAYER_FIXED_NEXT is set, NULL for last layer */
+#endif
+};
+#if CODEC_COMPILE
+/**
+ * @brief entry of compiled layer chain, next entry is fixed next layer of entry
+ */
+typedef struct {
+    Codec_LayerImpl*        Layer;          /**< NULL at end of chain */
+    Stream_LenType          Len;            /**< fixed length or CODEC_LAYER_LEN_DYNAMIC */
+} Codec_CompiledLayer;
+#endif
+#if CODEC_DECODE && CODEC_DECODE_ASYNC
+/**
+ * @brief position of async decoder in current frame, decode loop run over it
+ * for a codec and for connections of a protocol
+ */
+typedef struct {
+    Codec_LayerImpl*        Layer;          /**< layer that wait for bytes */
+    Codec_Frame*            Frame;
+#if CODEC_COMPILE
+    Codec_LayerIndex        Index;          /**< index of layer in compiled chain */
+#endif
+#if CODEC_DECODE_CHUNK
+    Stream_LenType          Offset;         /**< parsed bytes of chunk layer */
+#endif
+} Codec_RxCursor;
+#endif
+#if CODEC_ENCODE && CODEC_ENCODE_ASYNC
+/**
+ * @brief position of async encoder in current frame, encode loop run over it
+ * for a codec and for connections of a protocol
+ */
+typedef struct {
+    Codec_LayerImpl*        Layer;          /**< layer that wait for space, NULL when frame encoded */
+    Codec_Frame*            Frame;
+#if CODEC_COMPILE
+    Codec_LayerIndex        Index;          /**< index of layer in compiled chain */
+#endif
+} Codec_TxCursor;
+#endif
+#if CODEC_ENCODE && CODEC_ENCODE_ASYNC && CODEC_ENCODE_QUEUE
+/**
+ * @brief bounded single-producer/single-consumer queue of frames for async encode
+ */
+struct __Codec_EncodeQueue {
+    Codec_Frame**           Frames;
+    Stream_LenType          Size;
+    volatile Stream_LenType Head;           /**< written only by producer */
+    volatile Stream_LenType Tail;           /**< written only by consumer */
+};
+#endif
+#if CODEC_DECODE && CODEC_DECODE_ASYNC && CODEC_DECODE_QUEUE
+/**
+ * @brief pool of frame slots with single-producer/single-consumer ring for async decode,
+ * decoder fill slots and consumer release them
+ */
+struct __Codec_DecodeQueue {
+    Codec_Frame**           Frames;
+    Stream_LenType          Size;
+    volatile Stream_LenType Head;           /**< written only by decoder, slot of Head is in decode */
+    volatile Stream_LenType Tail;           /**< written only by consumer */
 };
+#endif
+#if CODEC_STATS
 /**
- * @brief hold codec parameters
+ * @brief counters of decode or encode phase
+ */
+typedef struct {
+    Codec_StatsCounter      Frames;         /**< completed frames */
+    Codec_StatsCounter      Bytes;          /**< bytes parsed or written by layers */
+    Codec_StatsCounter      Errors;         /**< failed layers */
+    Codec_StatsCounter      Pending;        /**< returns in middle of a frame, wait for bytes or space */
+} Codec_PhaseStats;
+/**
+ * @brief error counters of a layer
+ */
+typedef struct {
+    const Codec_LayerImpl*  Layer;          /**< NULL if entry is free */
+    Codec_StatsCounter      DecodeErrors;
+    Codec_StatsCounter      EncodeErrors;
+} Codec_LayerStats;
+/**
+ * @brief counter of an error code
+ */
+typedef struct {
+    Codec_Error             Error;
+    Codec_StatsCounter      Count;          /**< 0 if entry is free */
+} Codec_ErrorStats;
+/**
+ * @brief statistics of codec, errors of layers and codes that not fit in tables
+ * only counted in phase errors
+ */
+typedef struct {
+#if CODEC_DECODE
+    Codec_PhaseStats        Decode;
+    Codec_StatsCounter      SyncSkipped;    /**< bytes skipped by sync function */
+    Codec_StatsCounter      ResyncSkipped;  /**< bytes skipped by resync function */
+    Codec_StatsCounter      ErrorDropped;   /**< bytes dropped by one byte recovery after errors */
+#if CODEC_DECODE_FILTER
+    Codec_StatsCounter      FilterSkipped;  /**< frames skipped by decode filter */
+#endif
+#endif
+#if CODEC_ENCODE
+    Codec_PhaseStats        Encode;
+#endif
+    Codec_LayerStats        Layers[CODEC_STATS_LAYERS];
+    Codec_ErrorStats        Errors[CODEC_STATS_ERRORS];
+} Codec_Stats;
+#endif // CODEC_STATS
+/**
+ * @brief hold codec parameters, in CODEC_FULL_DUPLEX layout decode fields start from FreeStream
+ * and encode fields start from TxReserved and each side begin a new cache line,
+ * decoder and encoder can run in two threads if each side configured before they start
  */
 struct __Codec {
 #if CODEC_ARGS
     void*                   Args;
 #endif
     Codec_LayerImpl*        BaseLayer;
+#if CODEC_COMPILE
+    const Codec_CompiledLayer* Chain;
+    Codec_LayerIndex        ChainLen;
+#endif
+#if CODEC_FULL_DUPLEX
+    // decoder side, flags are separate bytes, decode only read and write them
+    CODEC_CACHE_ALIGN
+    uint8_t                 FreeStream;
+    uint8_t                 DecodeAll;
+    uint8_t                 DecodeView;
+    uint8_t                 RxTimed;
+#endif
 #if CODEC_DECODE
 #if CODEC_DECODE_ASYNC
-    Codec_LayerImpl*        RxLayer;
-    Codec_Frame*            RxFrame;
+    Codec_RxCursor          Rx;
+#if CODEC_DECODE_QUEUE
+    Codec_DecodeQueue*      RxQueue;
+#endif
+#if CODEC_DECODE_FILTER
+    Stream_LenType          RxSkip;         /**< bytes of skipped frame that not received yet */
+#endif
 #endif
 #if CODEC_DECODE_CALLBACK
     Codec_OnFrameFn         onDecode;
@@ -164,15 +415,40 @@ struct __Codec {
 #if CODEC_DECODE_ERROR
     Codec_OnErrorFn         onDecodeError;
 #endif
+#if CODEC_DECODE_FILTER
+    Codec_FilterFn          filter;
+#endif
 #if CODEC_DECODE_SYNC
     Codec_SyncFn            sync;
 #endif
+#if CODEC_DECODE_RESYNC
+    Codec_SyncFn            resync;
+#endif
+#if CODEC_DECODE_LATENCY
+    Codec_ClockFn           clock;
+    Codec_Tick              RxBegin;        /**< time of first byte of current frame */
+    Codec_Histogram         RxLatency;
+#endif
+#if CODEC_CHECKSUM
+    const Codec_ChecksumImpl* RxChecksum;
+    uint32_t                RxSum;          /**< checksum of committed layers of current frame */
+#endif
+#if CODEC_FULL_DUPLEX && CODEC_STATS
+    Codec_Stats             RxStats;
+#endif
 #endif // CODEC_DECODE
+#if CODEC_FULL_DUPLEX
+    // encoder side
+    CODEC_CACHE_ALIGN
+    uint8_t                 TxReserved;     /**< start of encoder side */
+#endif
 #if CODEC_ENCODE
 #if CODEC_ENCODE_ASYNC
-    Codec_LayerImpl*        TxLayer;
-    Codec_Frame*            TxFrame;
+    Codec_TxCursor          Tx;
     Codec_EncodeMode        EncodeMode;
+#if CODEC_ENCODE_QUEUE
+    Codec_EncodeQueue*      TxQueue;
+#endif
 #endif
 #if CODEC_ENCODE_CALLBACK
     Codec_OnFrameFn         onEncode;
@@ -180,11 +456,63 @@ struct __Codec {
 #if CODEC_ENCODE_ERROR
     Codec_OnErrorFn         onEncodeError;
 #endif
+#if CODEC_ENCODE_GATHER
+    Codec_Gather*           TxGather;
+#endif
+#if CODEC_CHECKSUM
+    const Codec_ChecksumImpl* TxChecksum;
+    uint32_t                TxSum;          /**< checksum of committed layers of current frame */
+#if CODEC_ENCODE_GATHER
+    Stream_LenType          TxSumMark;      /**< scratch bytes of current layer that added into checksum */
+#endif
+#endif
+#if CODEC_FULL_DUPLEX && CODEC_STATS
+    Codec_Stats             TxStats;
+#endif
 #endif // CODEC_ENCODE
+#if !CODEC_FULL_DUPLEX
+#if CODEC_STATS
+    Codec_Stats             Stats;
+#endif
     uint8_t                 FreeStream      : 1;
     uint8_t                 DecodeAll       : 1;
-    uint8_t                 Reserved        : 6;
+    uint8_t                 DecodeView      : 1;
+    uint8_t                 RxTimed         : 1;
+    uint8_t                 Reserved        : 4;
+#endif
 };
+#if CODEC_PROTOCOL
+/**
+ * @brief layer index that point to no layer
+ */
+#define CODEC_LAYER_INDEX_END                   ((Codec_LayerIndex) -1)
+/**
+ * @brief protocol definition that shared between connections, it's read-only after setup,
+ * Base codec hold sync, resync and callbacks and it's passed to layers and callbacks, so they must not change it,
+ * connections run same decode/encode loops as a codec over their own cursor, features that keep state
+ * of current frame in codec are rejected: view, decode queue, filter, checksum, latency clock and gather
+ */
+typedef struct {
+    Codec                   Base;
+    Codec_LayerImpl**       Layers;         /**< layers of protocol, index 0 is base layer */
+    Codec_LayerIndex        LayersLen;
+    Codec_LayerIndex        Size;
+} Codec_Protocol;
+/**
+ * @brief per-connection state of a protocol, index of current layer in each direction
+ */
+typedef struct {
+#if CODEC_DECODE && CODEC_DECODE_ASYNC
+    Codec_LayerIndex        RxLayer;
+#endif
+#if CODEC_ENCODE && CODEC_ENCODE_ASYNC
+    Codec_LayerIndex        TxLayer;        /**< CODEC_LAYER_INDEX_END when there is no frame to encode */
+#endif
+#if CODEC_DECODE && CODEC_DECODE_ASYNC && CODEC_DECODE_CHUNK
+    Stream_LenType          RxOffset;       /**< parsed bytes of chunk layer */
+#endif
+} Codec_State;
+#endif // CODEC_PROTOCOL
 
 void Codec_init(Codec* codec, Codec_LayerImpl* baseLayer);
 Stream_LenType Codec_frameSize(Codec* codec, Codec_Frame* frame, Codec_Phase phase);
@@ -196,6 +524,17 @@ Stream_LenType Codec_frameSize(Codec* codec, Codec_Frame* frame, Codec_Phase pha
     void* Codec_getArgs(Codec* codec);
 #endif
 
+#if CODEC_COMPILE
+    Codec_LayerIndex Codec_compile(Codec* codec, Codec_CompiledLayer* chain, Codec_LayerIndex size);
+#endif
+
+#if CODEC_STATS
+    void Codec_getStats(Codec* codec, Codec_Stats* stats);
+    void Codec_resetStats(Codec* codec);
+    const Codec_LayerStats* Codec_Stats_layer(const Codec_Stats* stats, const Codec_LayerImpl* layer);
+    Codec_StatsCounter Codec_Stats_error(const Codec_Stats* stats, Codec_Error error);
+#endif
+
 /* Decode Functions */
 #if CODEC_DECODE
 
@@ -207,19 +546,69 @@ Stream_LenType Codec_frameSize(Codec* codec, Codec_Frame* frame, Codec_Phase pha
     void Codec_onDecodeError(Codec* codec, Codec_OnErrorFn fn);
 #endif
 
+#if CODEC_DECODE_FILTER
+    void Codec_setDecodeFilter(Codec* codec, Codec_FilterFn fn);
+#endif
+
 #if CODEC_DECODE_SYNC
     void Codec_setDecodeSync(Codec* codec, Codec_SyncFn fn);
 #endif
 
+#if CODEC_DECODE_RESYNC
+    void Codec_setDecodeResync(Codec* codec, Codec_SyncFn fn);
+#endif
+
+#if CODEC_CHECKSUM
+    void Codec_setDecodeChecksum(Codec* codec, const Codec_ChecksumImpl* impl);
+
+    #define Codec_decodeChecksum(CODEC)                                 ((CODEC)->RxSum)
+#endif
+
+#if CODEC_DECODE_LATENCY
+    void Codec_setClock(Codec* codec, Codec_ClockFn fn);
+    void Codec_Histogram_reset(Codec_Histogram* hist);
+    void Codec_Histogram_add(Codec_Histogram* hist, Codec_Tick value);
+    Codec_Tick Codec_Histogram_percentile(const Codec_Histogram* hist, uint16_t permyriad);
+
+    #define Codec_decodeLatency(CODEC)                                  (&(CODEC)->RxLatency)
+    #define Codec_Histogram_p50(HIST)                                   Codec_Histogram_percentile((HIST), 5000)
+    #define Codec_Histogram_p99(HIST)                                   Codec_Histogram_percentile((HIST), 9900)
+    #define Codec_Histogram_p999(HIST)                                  Codec_Histogram_percentile((HIST), 9990)
+#endif
+
+#if CODEC_DECODE_VIEW
+    void Codec_setDecodeView(Codec* codec, uint8_t enabled);
+    void Codec_view(Codec_View* view, StreamIn* stream, Stream_LenType len);
+    Stream_LenType Codec_viewLen(const Codec_View* view);
+    void Codec_viewCopy(const Codec_View* view, uint8_t* buff);
+
+    #define Codec_isDecodeView(CODEC)                                   ((CODEC)->DecodeView)
+#endif
+
 #if CODEC_DECODE_ON_BUFFER
     Codec_Status Codec_decodeBuffer(Codec* codec, Codec_Frame* frame, uint8_t* buffer, Stream_LenType size);
 #endif
 
     Codec_Status Codec_decodeFrame(Codec* codec, Codec_Frame* frame, StreamIn* stream);
+#if CODEC_MMAP
+    Codec_Status Codec_decodeSpan(Codec* codec, Codec_Frame* frame, StreamIn* stream, Stream_LenType* skipped);
+#endif
+
+#if CODEC_DECODE_BATCH
+    Stream_LenType Codec_decodeBatch(Codec* codec, Codec_Frame* frames[], Stream_LenType maxFrames, StreamIn* stream);
+#endif
 
 #if CODEC_DECODE_ASYNC
     void Codec_beginDecode(Codec* codec, Codec_Frame* frame);
     void Codec_decode(Codec* codec, StreamIn* stream);
+
+#if CODEC_DECODE_QUEUE
+    void Codec_DecodeQueue_init(Codec_DecodeQueue* queue, Codec_Frame** frames, Stream_LenType size);
+    Codec_Frame* Codec_DecodeQueue_peek(Codec_DecodeQueue* queue);
+    void Codec_DecodeQueue_release(Codec_DecodeQueue* queue);
+    Stream_LenType Codec_DecodeQueue_available(Codec_DecodeQueue* queue);
+    void Codec_setDecodeQueue(Codec* codec, Codec_DecodeQueue* queue);
+#endif
 #endif
 
 #endif
@@ -234,16 +623,42 @@ Stream_LenType Codec_frameSize(Codec* codec, Codec_Frame* frame, Codec_Phase pha
     void Codec_onEncodeError(Codec* codec, Codec_OnErrorFn fn);
 #endif
 
+#if CODEC_CHECKSUM
+    void Codec_setEncodeChecksum(Codec* codec, const Codec_ChecksumImpl* impl);
+
+    #define Codec_encodeChecksum(CODEC)                                 ((CODEC)->TxSum)
+#endif
+
 #if CODEC_ENCODE_ON_BUFFER
     Codec_Status Codec_encodeBuffer(Codec* codec, Codec_Frame* frame, uint8_t* buffer, Stream_LenType size);
 #endif
 
     Codec_Status Codec_encodeFrame(Codec* codec, Codec_Frame* frame, StreamOut* stream, Codec_EncodeMode mode);
 
+#if CODEC_ENCODE_GATHER
+    void Codec_Gather_init(Codec_Gather* gather, Codec_IoVec* vec, uint16_t size, uint8_t* scratch, Stream_LenType scratchSize);
+    void Codec_Gather_reset(Codec_Gather* gather);
+    Stream_LenType Codec_Gather_len(const Codec_Gather* gather);
+    void Codec_Gather_consume(Codec_Gather* gather, Stream_LenType len);
+    Codec_Status Codec_encodeGather(Codec* codec, Codec_Frame* frame, Codec_Gather* gather);
+    Codec_Error Codec_writeRef(Codec* codec, StreamOut* stream, const uint8_t* data, Stream_LenType len);
+
+    #define Codec_Gather_vec(GATHER)                                    (&(GATHER)->Vec[(GATHER)->Index])
+    #define Codec_Gather_count(GATHER)                                  ((GATHER)->Count - (GATHER)->Index)
+#endif
+
 #if CODEC_ENCODE_ASYNC
     void Codec_encodeMode(Codec* codec, Codec_EncodeMode mode);
     void Codec_beginEncode(Codec* codec, Codec_Frame* frame, Codec_EncodeMode mode);
     void Codec_encode(Codec* codec, StreamOut* stream);
+
+#if CODEC_ENCODE_QUEUE
+    void Codec_EncodeQueue_init(Codec_EncodeQueue* queue, Codec_Frame** frames, Stream_LenType size);
+    Codec_Status Codec_EncodeQueue_push(Codec_EncodeQueue* queue, Codec_Frame* frame);
+    Stream_LenType Codec_EncodeQueue_available(Codec_EncodeQueue* queue);
+    Stream_LenType Codec_EncodeQueue_space(Codec_EncodeQueue* queue);
+    void Codec_setEncodeQueue(Codec* codec, Codec_EncodeQueue* queue);
+#endif
 #endif
 
 #endif
@@ -251,6 +666,31 @@ Stream_LenType Codec_frameSize(Codec* codec, Codec_Frame* frame, Codec_Phase pha
 void Codec_setFreeStream(Codec* codec, uint8_t enabled);
 void Codec_setDecodeAll(Codec* codec, uint8_t enabled);
 
+#if CODEC_PROTOCOL
+    Codec_LayerIndex Codec_Protocol_init(Codec_Protocol* proto, Codec_LayerImpl* baseLayer, Codec_LayerImpl** layers, Codec_LayerIndex size);
+    Codec_LayerIndex Codec_Protocol_addLayer(Codec_Protocol* proto, Codec_LayerImpl* layer);
+    Codec_LayerIndex Codec_Protocol_indexOf(const Codec_Protocol* proto, const Codec_LayerImpl* layer);
+    void Codec_State_init(Codec_State* state);
+
+    #define Codec_Protocol_codec(PROTO)                                 (&(PROTO)->Base)
+
+#if CODEC_DECODE && CODEC_DECODE_ASYNC
+    Codec_Status Codec_State_decode(Codec_Protocol* proto, Codec_State* state, Codec_Frame* frame, StreamIn* stream);
+
+#if CODEC_DECODE_CHUNK
+    #define Codec_State_beginDecode(STATE)                              ((STATE)->RxLayer = 0, (STATE)->RxOffset = 0)
+#else
+    #define Codec_State_beginDecode(STATE)                              ((STATE)->RxLayer = 0)
+#endif
+#endif
+#if CODEC_ENCODE && CODEC_ENCODE_ASYNC
+    Codec_Status Codec_State_encode(Codec_Protocol* proto, Codec_State* state, Codec_Frame* frame, StreamOut* stream);
+
+    #define Codec_State_beginEncode(STATE)                              ((STATE)->TxLayer = 0)
+    #define Codec_State_isEncoding(STATE)                               ((STATE)->TxLayer != CODEC_LAYER_INDEX_END)
+#endif
+#endif // CODEC_PROTOCOL
+
 // ----------------------------------- Macros -----------------------------------
 #if CODEC_DECODE && CODEC_ENCODE
     #define CODEC_LAYER_IMPL(parse, write, getLen, nextLayer) { .parse = parse, .write = write, .getLen = getLen, .nextLayer = nextLayer }
@@ -0,0 +1,399 @@
+/**
+ * @file Codec.hpp
+ * @author Ali Mirghasemi (ali.mirghasemi1376@gmail.com)
+ * @brief header-only C++17 front end of codec library, layers are types and pipeline of layers
+ * resolved at compile time, so layer calls are direct and can be inlined,
+ * frames are same as C frames, so pipelines are wire compatible with C layers
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _CODEC_HPP_
+#define _CODEC_HPP_
+
+#if !defined(__cplusplus) || (__cplusplus < 201703L && !(defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+    #error "Codec.hpp need C++17"
+#endif
+
+#include "Codec.h"
+#include "Frame/Packet.h"
+#include "Frame/BasicFrame.h"
+
+#include <type_traits>
+#include <utility>
+
+namespace codec {
+
+namespace detail {
+
+template <typename Layer, typename = void>
+struct HasFixedLen : std::false_type {};
+template <typename Layer>
+struct HasFixedLen<Layer, std::void_t<decltype(Layer::Len)>> : std::true_type {};
+
+template <typename Layer, typename = void>
+struct HasSync : std::false_type {};
+template <typename Layer>
+struct HasSync<Layer, std::void_t<decltype(Layer::sync(std::declval<StreamIn*>()))>> : std::true_type {};
+
+template <typename First, typename... Rest>
+struct Front {
+    using Type = First;
+};
+
+template <typename Layer>
+constexpr Stream_LenType fixedLen() {
+    if constexpr (HasFixedLen<Layer>::value) {
+        return Layer::Len;
+    }
+    else {
+        return 0;
+    }
+}
+
+template <typename Layer, typename Frame>
+inline Stream_LenType layerLen(const Frame& frame) {
+    if constexpr (HasFixedLen<Layer>::value) {
+        (void) frame;
+        return Layer::Len;
+    }
+    else {
+        return Layer::len(frame);
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief pipeline of layers, first layer is base layer, each layer is a type with:
+ * - `using Frame = ...` type of frame, same for all layers
+ * - `static constexpr Stream_LenType Len` for fixed length layers
+ *   or `static Stream_LenType len(const Frame&)` for other layers
+ * - `static Codec_Error parse(Frame&, StreamIn*)` when CODEC_DECODE enabled
+ * - `static Codec_Error write(const Frame&, StreamOut*)` when CODEC_ENCODE enabled
+ * - optional `static Stream_LenType sync(StreamIn*)` on base layer, same as Codec_SyncFn
+ *
+ * @tparam Layers
+ */
+template <typename... Layers>
+class Pipeline {
+public:
+    static_assert(sizeof...(Layers) > 0, "pipeline need at least one layer");
+
+    using Base = typename detail::Front<Layers...>::Type;
+    using Frame = typename Base::Frame;
+
+    static_assert((std::is_same_v<Frame, typename Layers::Frame> && ...), "all layers must use same frame type");
+
+    /**
+     * @brief all layers have fixed length
+     */
+    static constexpr bool Fixed = (detail::HasFixedLen<Layers>::value && ...);
+    /**
+     * @brief sum of fixed length layers, full frame size when Fixed is true
+     */
+    static constexpr Stream_LenType FixedLen = (detail::fixedLen<Layers>() + ...);
+
+    /**
+     * @brief return full frame size, same as Codec_frameSize
+     *
+     * @param frame
+     * @return Stream_LenType
+     */
+    static inline Stream_LenType frameSize(const Frame& frame) {
+        return (detail::layerLen<Layers>(frame) + ...);
+    }
+
+#if CODEC_ENCODE
+    /**
+     * @brief encode frame into stream, unlike Codec_encodeFrame nothing written
+     * when whole frame does not fit in stream space
+     *
+     * @param frame
+     * @param stream
+     * @return Codec_Status Done, Pending if stream has not enough space, Error if a layer failed
+     */
+    static inline Codec_Status encode(const Frame& frame, StreamOut* stream) {
+        if (frameSize(frame) > OStream_space(stream)) {
+            return Codec_Status_Pending;
+        }
+        return (writeLayer<Layers>(frame, stream) && ...) ? Codec_Status_Done : Codec_Status_Error;
+    }
+    /**
+     * @brief encode frame into buffer
+     *
+     * @param frame
+     * @param buffer
+     * @param size
+     * @return Codec_Status
+     */
+    static inline Codec_Status encode(const Frame& frame, uint8_t* buffer, Stream_LenType size) {
+        StreamOut stream;
+        OStream_init(&stream, NULL, buffer, size);
+        return encode(frame, &stream);
+    }
+#endif // CODEC_ENCODE
+
+#if CODEC_DECODE
+    /**
+     * @brief decode a frame from stream, same as Codec_decodeFrame,
+     * base layer sync called if exists and a failed layer drop one byte and retry from base layer
+     *
+     * @param frame
+     * @param stream
+     * @return Codec_Status Done, Pending when sync drop all bytes or frame is incomplete after sync,
+     * Error when there is not enough bytes for frame
+     */
+    static inline Codec_Status decode(Frame& frame, StreamIn* stream) {
+        bool failed;
+
+        while (IStream_available(stream) >= detail::layerLen<Base>(frame)) {
+        #if CODEC_DECODE_SYNC
+            if constexpr (detail::HasSync<Base>::value) {
+                Stream_LenType len = Base::sync(stream);
+                if (len > 0) {
+                    IStream_ignore(stream, len);
+                    if (IStream_available(stream) < detail::layerLen<Base>(frame)) {
+                        return Codec_Status_Pending;
+                    }
+                }
+                else if (len == -1) {
+                    IStream_ignore(stream, IStream_available(stream));
+                    return Codec_Status_Pending;
+                }
+            }
+        #endif
+            failed = false;
+            if ((parseLayer<Layers>(frame, stream, failed) && ...)) {
+                return Codec_Status_Done;
+            }
+            if (!failed) {
+                // frame is incomplete
+                break;
+            }
+        }
+        return Codec_Status_Error;
+    }
+    /**
+     * @brief decode a frame from buffer
+     *
+     * @param frame
+     * @param buffer
+     * @param size
+     * @return Codec_Status
+     */
+    static inline Codec_Status decode(Frame& frame, uint8_t* buffer, Stream_LenType size) {
+        StreamIn stream;
+        IStream_init(&stream, NULL, buffer, size);
+        Stream_moveWritePos(&stream.Buffer, size);
+        return decode(frame, &stream);
+    }
+#endif // CODEC_DECODE
+
+private:
+#if CODEC_ENCODE
+    template <typename Layer>
+    static inline bool writeLayer(const Frame& frame, StreamOut* stream) {
+        Stream_LenType len = detail::layerLen<Layer>(frame);
+        StreamOut lock;
+
+        OStream_lock(stream, &lock, len);
+        if (Layer::write(frame, &lock) != CODEC_OK) {
+            OStream_unlockIgnore(stream);
+            return false;
+        }
+    #if CODEC_ENCODE_PADDING
+        if ((len = OStream_spaceUncheck(&lock)) > 0) {
+        #if CODEC_ENCODE_PADDING_MODE == CODEC_ENCODE_PADDING_IGNORE
+            OStream_ignore(&lock, len);
+        #else
+            OStream_writePadding(&lock, (uint8_t) CODEC_ENCODE_PADDING_VALUE, len);
+        #endif
+        }
+    #endif // CODEC_ENCODE_PADDING
+        OStream_unlock(stream, &lock);
+        return true;
+    }
+#endif // CODEC_ENCODE
+
+#if CODEC_DECODE
+    template <typename Layer>
+    static inline bool parseLayer(Frame& frame, StreamIn* stream, bool& failed) {
+        Stream_LenType len = detail::layerLen<Layer>(frame);
+        StreamIn lock;
+
+        if (IStream_available(stream) < len) {
+            return false;
+        }
+        IStream_lock(stream, &lock, len);
+        if (Layer::parse(frame, &lock) != CODEC_OK) {
+            IStream_unlockIgnore(stream);
+            // ignore one byte
+            IStream_ignore(stream, 1);
+            failed = true;
+            return false;
+        }
+    #if CODEC_DECODE_PADDING
+        if ((len = IStream_availableUncheck(&lock)) > 0) {
+            IStream_ignore(&lock, len);
+        }
+    #endif
+        IStream_unlock(stream, &lock);
+        return true;
+    }
+#endif // CODEC_DECODE
+};
+
+/**
+ * @brief layers of Packet frame, same wire format as Packet_baseLayer
+ */
+namespace packet {
+
+struct Header {
+    using Frame = Packet;
+    static constexpr Stream_LenType Len = PACKET_HEADER_SIZE;
+
+#if CODEC_DECODE
+    static inline Stream_LenType sync(StreamIn* stream) {
+        return Packet_sync(NULL, stream);
+    }
+    static inline Codec_Error parse(Packet& frame, StreamIn* stream) {
+    #if STREAM_BYTE_ORDER
+        IStream_setByteOrder(stream, PACKET_BYTE_ORDER);
+    #endif
+        if (IStream_readUInt16(stream) != (uint16_t) PACKET_FIRST_SIGN) {
+            return (Codec_Error) Packet_Error_FirstSign;
+        }
+        frame.Len = IStream_readUInt32(stream);
+        if (frame.Len >= PACKET_MAX_SIZE || frame.Len > frame.Size) {
+            return (Codec_Error) Packet_Error_PacketSize;
+        }
+        if (IStream_readUInt16(stream) != (uint16_t) PACKET_SECOND_SIGN) {
+            return (Codec_Error) Packet_Error_SecondSign;
+        }
+        return CODEC_OK;
+    }
+#endif
+#if CODEC_ENCODE
+    static inline Codec_Error write(const Packet& frame, StreamOut* stream) {
+    #if STREAM_BYTE_ORDER
+        OStream_setByteOrder(stream, PACKET_BYTE_ORDER);
+    #endif
+        OStream_writeUInt16(stream, (uint16_t) PACKET_FIRST_SIGN);
+        OStream_writeUInt32(stream, frame.Len);
+        OStream_writeUInt16(stream, (uint16_t) PACKET_SECOND_SIGN);
+        return CODEC_OK;
+    }
+#endif
+};
+
+struct Data {
+    using Frame = Packet;
+
+    static inline Stream_LenType len(const Packet& frame) {
+        return (Stream_LenType) frame.Len;
+    }
+#if CODEC_DECODE
+    static inline Codec_Error parse(Packet& frame, StreamIn* stream) {
+        if (frame.Data == NULL) {
+            return (Codec_Error) Packet_Error_DataPtr;
+        }
+        IStream_readBytes(stream, frame.Data, frame.Len);
+        return CODEC_OK;
+    }
+#endif
+#if CODEC_ENCODE
+    static inline Codec_Error write(const Packet& frame, StreamOut* stream) {
+        if (frame.Data == NULL) {
+            return (Codec_Error) Packet_Error_DataPtr;
+        }
+        OStream_writeBytes(stream, frame.Data, frame.Len);
+        return CODEC_OK;
+    }
+#endif
+};
+
+struct Footer {
+    using Frame = Packet;
+    static constexpr Stream_LenType Len = PACKET_FOOTER_SIZE;
+
+#if CODEC_DECODE
+    static inline Codec_Error parse(Packet& frame, StreamIn* stream) {
+        (void) frame;
+    #if STREAM_BYTE_ORDER
+        IStream_setByteOrder(stream, PACKET_BYTE_ORDER);
+    #endif
+        if (IStream_readUInt32(stream) != (uint32_t) PACKET_FOOTER_SIGN) {
+            return (Codec_Error) Packet_Error_FooterSign;
+        }
+        return CODEC_OK;
+    }
+#endif
+#if CODEC_ENCODE
+    static inline Codec_Error write(const Packet& frame, StreamOut* stream) {
+        (void) frame;
+    #if STREAM_BYTE_ORDER
+        OStream_setByteOrder(stream, PACKET_BYTE_ORDER);
+    #endif
+        OStream_writeUInt32(stream, (uint32_t) PACKET_FOOTER_SIGN);
+        return CODEC_OK;
+    }
+#endif
+};
+
+using Codec = Pipeline<Header, Data, Footer>;
+
+} // namespace packet
+
+/**
+ * @brief layers of BasicFrame, same wire format as BasicFrame_baseLayer
+ */
+namespace basic_frame {
+
+struct Header {
+    using Frame = BasicFrame;
+    static constexpr Stream_LenType Len = sizeof(BasicFrame_Header);
+
+#if CODEC_DECODE
+    static inline Codec_Error parse(BasicFrame& frame, StreamIn* stream) {
+        frame.Header.PacketSize = IStream_readUInt32(stream);
+        return CODEC_OK;
+    }
+#endif
+#if CODEC_ENCODE
+    static inline Codec_Error write(const BasicFrame& frame, StreamOut* stream) {
+        OStream_writeUInt32(stream, frame.Header.PacketSize);
+        return CODEC_OK;
+    }
+#endif
+};
+
+struct Data {
+    using Frame = BasicFrame;
+
+    static inline Stream_LenType len(const BasicFrame& frame) {
+        return (Stream_LenType) frame.Header.PacketSize;
+    }
+#if CODEC_DECODE
+    static inline Codec_Error parse(BasicFrame& frame, StreamIn* stream) {
+        IStream_readBytes(stream, frame.Data.Data, frame.Header.PacketSize);
+        return CODEC_OK;
+    }
+#endif
+#if CODEC_ENCODE
+    static inline Codec_Error write(const BasicFrame& frame, StreamOut* stream) {
+        OStream_writeBytes(stream, frame.Data.Data, frame.Header.PacketSize);
+        return CODEC_OK;
+    }
+#endif
+};
+
+using Codec = Pipeline<Header, Data>;
+
+} // namespace basic_frame
+
+} // namespace codec
+
+#endif // _CODEC_HPP_
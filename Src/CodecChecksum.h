@@ -0,0 +1,58 @@
+/**
+ * @file CodecChecksum.h
+ * @author Ali Mirghasemi (ali.mirghasemi1376@gmail.com)
+ * @brief checksum algorithms for running checksum of codec, set them with
+ * Codec_setDecodeChecksum/Codec_setEncodeChecksum and read result in footer layers
+ * with Codec_decodeChecksum/Codec_encodeChecksum
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _CODEC_CHECKSUM_H_
+#define _CODEC_CHECKSUM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "Codec.h"
+
+#if CODEC_CHECKSUM
+
+/**
+ * @brief XOR of all bytes (LRC), 8-bit result
+ */
+extern const Codec_ChecksumImpl CODEC_CHECKSUM_XOR;
+/**
+ * @brief Fletcher-16, 16-bit result, second sum in high byte
+ */
+extern const Codec_ChecksumImpl CODEC_CHECKSUM_FLETCHER16;
+/**
+ * @brief CRC-16/CCITT-FALSE, poly 0x1021, init 0xFFFF
+ */
+extern const Codec_ChecksumImpl CODEC_CHECKSUM_CRC16;
+/**
+ * @brief CRC-32 (IEEE 802.3), same as zlib crc32
+ */
+extern const Codec_ChecksumImpl CODEC_CHECKSUM_CRC32;
+#if CODEC_CRC
+/**
+ * @brief CRC-32C (Castagnoli), hardware accelerated by CodecCrc.h
+ */
+extern const Codec_ChecksumImpl CODEC_CHECKSUM_CRC32C;
+#endif
+
+uint32_t Codec_xor8(uint32_t sum, const uint8_t* data, Stream_LenType len);
+uint32_t Codec_fletcher16(uint32_t sum, const uint8_t* data, Stream_LenType len);
+uint32_t Codec_crc16(uint32_t sum, const uint8_t* data, Stream_LenType len);
+uint32_t Codec_crc32(uint32_t sum, const uint8_t* data, Stream_LenType len);
+
+#endif // CODEC_CHECKSUM
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* _CODEC_CHECKSUM_H_ */
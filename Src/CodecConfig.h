@@ -59,6 +59,178 @@
 #ifndef CODEC_SUPPORT_MACRO
     #define CODEC_SUPPORT_MACRO                     (1 || CODEC_LIB_MACRO)
 #endif
+/**
+ * @brief enable fixed length and fixed next layer fields of layers,
+ * decode/encode loops read them instead of call getLen/nextLayer of layer
+ */
+#ifndef CODEC_LAYER_FIXED
+    #define CODEC_LAYER_FIXED                       1
+#endif
+/**
+ * @brief enable compile of layer chain, fixed lengths and next layers of chain
+ * are flattened into a table once, require CODEC_LAYER_FIXED,
+ * table hold same values as FixedLen/FixedNext of layers, it only help when layer descriptors
+ * are slow to reach, ex: spread over flash with wait states, or long chains that walk
+ * many descriptors, when descriptors are in cache it walk as fast as fixed fields and add
+ * a chain check to codecs that not compiled, compare "frameSize" rows of Codec-Bench
+ */
+#ifndef CODEC_COMPILE
+    #define CODEC_COMPILE                           0
+#endif
+/**
+ * @brief enable shared protocol and per-connection state, one read-only Codec_Protocol
+ * serve many connections and each connection keep only indexes of its current layers,
+ * connections can't count into stats of shared codec, so it's disabled with CODEC_STATS
+ */
+#ifndef CODEC_PROTOCOL
+    #define CODEC_PROTOCOL                          (1 && !CODEC_STATS)
+#endif
+/**
+ * @brief enable full-duplex layout of codec, decode and encode fields are placed in separate
+ * cache lines and each side has its own flags and statistics, so a thread can decode
+ * while another thread encode on same codec without false sharing
+ */
+#ifndef CODEC_FULL_DUPLEX
+    #define CODEC_FULL_DUPLEX                       0
+#endif
+/* Codec Full-Duplex Options */
+#if CODEC_FULL_DUPLEX
+    /**
+     * @brief cache line size of target in bytes
+     */
+    #ifndef CODEC_CACHE_LINE
+        #define CODEC_CACHE_LINE                    64
+    #endif
+    /**
+     * @brief alignment specifier that start a new cache line, placed before a struct member
+     */
+    #ifndef CODEC_CACHE_ALIGN
+        #if defined(__GNUC__) || defined(__clang__)
+            #define CODEC_CACHE_ALIGN               __attribute__((aligned(CODEC_CACHE_LINE)))
+        #elif defined(_MSC_VER)
+            #define CODEC_CACHE_ALIGN               __declspec(align(CODEC_CACHE_LINE))
+        #elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+            #define CODEC_CACHE_ALIGN               _Alignas(CODEC_CACHE_LINE)
+        #else
+            #error "CODEC_FULL_DUPLEX need CODEC_CACHE_ALIGN for this compiler"
+        #endif
+    #endif
+#endif
+/**
+ * @brief enable file descriptor streams, streams filled with readv and drained with writev,
+ * only on posix platforms
+ */
+#ifndef CODEC_FD_STREAM
+    #if defined(__unix__) || defined(__APPLE__)
+        #define CODEC_FD_STREAM                     1
+    #else
+        #define CODEC_FD_STREAM                     0
+    #endif
+#endif
+/**
+ * @brief enable epoll reactor that drive many connections with fd streams, only on Linux,
+ * require CODEC_DECODE_ASYNC
+ */
+#ifndef CODEC_REACTOR
+    #if defined(__linux__)
+        #define CODEC_REACTOR                       (1 && CODEC_FD_STREAM && CODEC_DECODE_ASYNC)
+    #else
+        #define CODEC_REACTOR                       0
+    #endif
+#endif
+/**
+ * @brief enable memory-mapped file input streams and frame index of capture files,
+ * only on posix platforms
+ */
+#ifndef CODEC_MMAP
+    #if defined(__unix__) || defined(__APPLE__)
+        #define CODEC_MMAP                          (1 && CODEC_DECODE)
+    #else
+        #define CODEC_MMAP                          0
+    #endif
+#endif
+#if CODEC_MMAP
+    /**
+     * @brief bytes of mapping that kernel asked to read ahead of stream window
+     */
+    #ifndef CODEC_MMAP_READAHEAD
+        #define CODEC_MMAP_READAHEAD                (4UL * 1024UL * 1024UL)
+    #endif
+#endif
+/**
+ * @brief enable parallel decode of mapped files with posix threads
+ */
+#ifndef CODEC_PARALLEL
+    #define CODEC_PARALLEL                          CODEC_MMAP
+#endif
+#if CODEC_PARALLEL
+    /**
+     * @brief max number of worker threads of a parallel decode
+     */
+    #ifndef CODEC_PARALLEL_MAX_WORKERS
+        #define CODEC_PARALLEL_MAX_WORKERS          64
+    #endif
+#endif
+/**
+ * @brief enable CRC32C checksum functions and PacketCrc frame
+ */
+#ifndef CODEC_CRC
+    #define CODEC_CRC                               1
+#endif
+#if CODEC_CRC
+    /**
+     * @brief use checksum instructions of cpu, SSE4.2 crc32 and PCLMUL on x86-64 detected at runtime,
+     * CRC extension on ARM when compiler target it, otherwise slice-by-8 tables
+     */
+    #ifndef CODEC_CRC_HW
+        #define CODEC_CRC_HW                        1
+    #endif
+#endif
+/**
+ * @brief enable running checksum of codec, bytes of each layer added into checksum when layer
+ * committed, so footer layers can verify or write it without read frame again
+ */
+#ifndef CODEC_CHECKSUM
+    #define CODEC_CHECKSUM                          0
+#endif
+/**
+ * @brief enable statistics counters of codec, frames, bytes, skipped bytes, pending returns
+ * and errors per layer and per error code, disabled by default because it cost on each layer
+ */
+#ifndef CODEC_STATS
+    #define CODEC_STATS                             0
+#endif
+/* Codec Stats Options */
+#if CODEC_STATS
+    /**
+     * @brief max number of layers that have separate error counters
+     */
+    #ifndef CODEC_STATS_LAYERS
+        #define CODEC_STATS_LAYERS                  8
+    #endif
+    /**
+     * @brief max number of error codes that have separate counters
+     */
+    #ifndef CODEC_STATS_ERRORS
+        #define CODEC_STATS_ERRORS                  8
+    #endif
+#endif // CODEC_STATS
+/**
+ * @brief enable trace hooks of codec, layer enter/exit, lock length, sync skip and errors
+ * recorded into per-thread trace rings, hooks compile to nothing when disabled
+ */
+#ifndef CODEC_TRACE
+    #define CODEC_TRACE                             0
+#endif
+/* Codec Trace Options */
+#if CODEC_TRACE
+    /**
+     * @brief number of records of each trace ring, must be power of two
+     */
+    #ifndef CODEC_TRACE_SIZE
+        #define CODEC_TRACE_SIZE                    1024
+    #endif
+#endif // CODEC_TRACE
 
 /* Codec Encode Options */
 #if CODEC_ENCODE
@@ -76,11 +248,29 @@
         #define CODEC_ENCODE_ASYNC                  1
     #endif
     /**
-     * @brief enable queue for encode async feature, !*this feature is not working yet*!
+     * @brief enable queue for encode async feature, lock-free single-producer/single-consumer
+     * queue of frames that Codec_encode drain into output stream, require CODEC_ENCODE_ASYNC
      */
     #ifndef CODEC_ENCODE_QUEUE
         #define CODEC_ENCODE_QUEUE                  1
     #endif
+    /**
+     * @brief enable scatter-gather encode, frame encoded into list of vectors,
+     * layers can reference their payload instead of copy it
+     */
+    #ifndef CODEC_ENCODE_GATHER
+        #define CODEC_ENCODE_GATHER                 1
+    #endif
+    /**
+     * @brief enable writev/sendmsg sink for scatter-gather encode, only on posix platforms
+     */
+    #ifndef CODEC_ENCODE_GATHER_POSIX
+        #if defined(__unix__) || defined(__APPLE__)
+            #define CODEC_ENCODE_GATHER_POSIX       1
+        #else
+            #define CODEC_ENCODE_GATHER_POSIX       0
+        #endif
+    #endif
     /**
      * @brief enable callback feature for when encode completed
      */
@@ -131,10 +321,31 @@
         #define CODEC_DECODE_ASYNC                  1
     #endif
     /**
-     * @brief enable queue for decode async feature, !*this feature is not working yet*!
+     * @brief enable chunk parse for layers that implement parseChunk,
+     * in async decode layer parsed as bytes received, so layer can be bigger than stream buffer
+     */
+    #ifndef CODEC_DECODE_CHUNK
+        #define CODEC_DECODE_CHUNK                  1
+    #endif
+    /**
+     * @brief enable view mode for decode, layers can keep view of bytes in stream buffer
+     * instead of copy them, frame bytes released after onDecode returned
+     */
+    #ifndef CODEC_DECODE_VIEW
+        #define CODEC_DECODE_VIEW                   1
+    #endif
+    /**
+     * @brief enable batch decode, decode multiple complete frames into caller frame slots in single call
+     */
+    #ifndef CODEC_DECODE_BATCH
+        #define CODEC_DECODE_BATCH                  1
+    #endif
+    /**
+     * @brief enable queue for decode async feature, decoded frames published through
+     * lock-free single-producer/single-consumer ring of frame slots, require CODEC_DECODE_ASYNC
      */
     #ifndef CODEC_DECODE_QUEUE
-        #define CODEC_DECODE_QUEUE                  1
+        #define CODEC_DECODE_QUEUE                  (1 && CODEC_DECODE_ASYNC)
     #endif
     /**
      * @brief enable sync options for decode
@@ -142,6 +353,35 @@
     #ifndef CODEC_DECODE_SYNC
         #define CODEC_DECODE_SYNC                   1
     #endif
+    /**
+     * @brief enable decode latency histogram, time from first byte of frame (after sync)
+     * until onDecode measured with user clock, disabled by default
+     */
+    #ifndef CODEC_DECODE_LATENCY
+        #define CODEC_DECODE_LATENCY                0
+    #endif
+    #if CODEC_DECODE_LATENCY
+        /**
+         * @brief number of latency histogram buckets, each power of two split into 4 buckets,
+         * bigger values counted in last bucket, 120 buckets cover 32-bit ticks
+         */
+        #ifndef CODEC_DECODE_LATENCY_BUCKETS
+            #define CODEC_DECODE_LATENCY_BUCKETS    120
+        #endif
+    #endif
+    /**
+     * @brief enable SIMD instructions (SSE2/AVX2/NEON) in pattern scanner when target support them
+     */
+    #ifndef CODEC_SCAN_SIMD
+        #define CODEC_SCAN_SIMD                     1
+    #endif
+    /**
+     * @brief enable resync options for decode,
+     * when a layer parse failed codec jump to next frame candidate instead of ignore one byte
+     */
+    #ifndef CODEC_DECODE_RESYNC
+        #define CODEC_DECODE_RESYNC                 1
+    #endif
     /**
      * @brief enable callback feature for when decode completed
      */
@@ -154,6 +394,13 @@
     #ifndef CODEC_DECODE_ERROR
         #define CODEC_DECODE_ERROR                  1
     #endif
+    /**
+     * @brief enable decode filter callback, it's called after parse of each layer
+     * and can skip rest of frame without parse it or abort frame
+     */
+    #ifndef CODEC_DECODE_FILTER
+        #define CODEC_DECODE_FILTER                 1
+    #endif
     /**
      * @brief enable decode padding for keep layer size fixed
      */
@@ -179,6 +426,18 @@
 #ifndef CODEC_LAYER_INDEX
     typedef uint16_t Codec_LayerIndex;
 #endif
+/**
+ * @brief choose what type use for codec statistics counters
+ */
+#ifndef CODEC_STATS_COUNTER
+    typedef uint32_t Codec_StatsCounter;
+#endif
+/**
+ * @brief choose what type use for clock ticks of decode latency
+ */
+#ifndef CODEC_TICK
+    typedef uint32_t Codec_Tick;
+#endif
 
 /************************************************************************/
 
@@ -0,0 +1,302 @@
+/**
+ * @file CodecCoro.hpp
+ * @author Ali Mirghasemi (ali.mirghasemi1376@gmail.com)
+ * @brief header-only C++20 coroutine front end of async decode/encode,
+ * `co_await codec.decodeNext(stream)` and `co_await codec.encode(frame, stream)` suspend
+ * while codec is pending and resume when executor notify stream of new bytes or space
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _CODEC_CORO_HPP_
+#define _CODEC_CORO_HPP_
+
+#if !defined(__cplusplus) || (__cplusplus < 202002L && !(defined(_MSVC_LANG) && _MSVC_LANG >= 202002L))
+    #error "CodecCoro.hpp need C++20"
+#endif
+
+#include "Codec.h"
+
+#include <coroutine>
+#include <exception>
+
+namespace codec::coro {
+
+/**
+ * @brief detached coroutine, start immediately and free itself when finished,
+ * executors multiplex tasks on stream notifications so there is no join
+ */
+class Task {
+public:
+    struct promise_type {
+        Task get_return_object() noexcept {
+            return Task {};
+        }
+        std::suspend_never initial_suspend() noexcept {
+            return {};
+        }
+        std::suspend_never final_suspend() noexcept {
+            return {};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept {
+            std::terminate();
+        }
+    };
+};
+
+/**
+ * @brief hold a single waiting coroutine, waiter resumed on notify when its poll function
+ * report that it can continue, otherwise it keep waiting for next notify
+ */
+class Signal {
+public:
+    using PollFn = bool (*)(void* args);
+
+    /**
+     * @brief park coroutine until next notify that poll function return true
+     *
+     * @param handle
+     * @param poll if NULL waiter resumed on first notify
+     * @param args arguments of poll function
+     */
+    void wait(std::coroutine_handle<> handle, PollFn poll, void* args) noexcept {
+        Waiter = handle;
+        poll_ = poll;
+        Args = args;
+    }
+    /**
+     * @brief check waiter and resume it if it can continue
+     */
+    void notify() {
+        if (Waiter && (poll_ == NULL || poll_(Args))) {
+            std::coroutine_handle<> handle = Waiter;
+            Waiter = NULL;
+            handle.resume();
+        }
+    }
+    bool waiting() const noexcept {
+        return (bool) Waiter;
+    }
+private:
+    std::coroutine_handle<>     Waiter;
+    PollFn                      poll_ = NULL;
+    void*                       Args = NULL;
+};
+
+class InStream;
+class OutStream;
+
+/**
+ * @brief called when a coroutine start to wait on input stream, executor can resume reading
+ */
+typedef void (*InStream_WaitFn)(InStream* stream);
+/**
+ * @brief called when bytes written into output stream, executor should transmit them
+ */
+typedef void (*OutStream_FlushFn)(OutStream* stream);
+
+/**
+ * @brief input stream that coroutines can wait on, executor fill it and notify Readable
+ */
+class InStream : public StreamIn {
+public:
+    InStream(uint8_t* buffer, Stream_LenType size) {
+        IStream_init(this, NULL, buffer, size);
+    }
+    InStream(const InStream&) = delete;
+    InStream& operator=(const InStream&) = delete;
+
+    Signal                      Readable;
+    InStream_WaitFn             onWait = NULL;
+    void*                       Owner = NULL;       /**< executor data */
+    bool                        Closed = false;     /**< no more bytes will come */
+};
+/**
+ * @brief output stream that coroutines can wait on, executor drain it and notify Writable
+ */
+class OutStream : public StreamOut {
+public:
+    OutStream(uint8_t* buffer, Stream_LenType size) {
+        OStream_init(this, NULL, buffer, size);
+    }
+    OutStream(const OutStream&) = delete;
+    OutStream& operator=(const OutStream&) = delete;
+
+    /**
+     * @brief ask executor to transmit pending bytes
+     */
+    void flush() {
+        if (onFlush && OStream_pendingBytes(this) > 0) {
+            onFlush(this);
+        }
+    }
+
+    Signal                      Writable;
+    OutStream_FlushFn           onFlush = NULL;
+    void*                       Owner = NULL;       /**< executor data */
+    bool                        Closed = false;     /**< bytes can't be transmitted anymore */
+};
+
+/**
+ * @brief codec with awaitable decode and encode, it own onDecode, onEncode and onEncodeError
+ * callbacks of codec, so don't replace them
+ *
+ * @tparam Frame type of frame
+ */
+template <typename Frame = Codec_Frame>
+class AsyncCodec : public ::Codec {
+public:
+    explicit AsyncCodec(Codec_LayerImpl* baseLayer) {
+        Codec_init(this, baseLayer);
+    #if CODEC_DECODE && CODEC_DECODE_CALLBACK
+        Codec_onDecode(this, onFrameDecoded);
+    #endif
+    #if CODEC_ENCODE && CODEC_ENCODE_CALLBACK
+        Codec_onEncode(this, onFrameEncoded);
+    #endif
+    #if CODEC_ENCODE && CODEC_ENCODE_ERROR
+        Codec_onEncodeError(this, onFrameEncodeError);
+    #endif
+    }
+    AsyncCodec(const AsyncCodec&) = delete;
+    AsyncCodec& operator=(const AsyncCodec&) = delete;
+
+#if CODEC_DECODE && CODEC_DECODE_ASYNC && CODEC_DECODE_CALLBACK
+    /**
+     * @brief awaiter of decodeNext
+     */
+    class DecodeAwaiter {
+    public:
+        DecodeAwaiter(AsyncCodec& codec, InStream& stream) : codec_(codec), stream_(stream) {}
+
+        bool await_ready() {
+            return poll(this);
+        }
+        void await_suspend(std::coroutine_handle<> handle) {
+            stream_.Readable.wait(handle, poll, this);
+            if (stream_.onWait) {
+                stream_.onWait(&stream_);
+            }
+        }
+        /**
+         * @brief return decoded frame, NULL if stream closed before a frame completed
+         */
+        Frame* await_resume() noexcept {
+            return codec_.Decoded ? (Frame*) codec_.Rx.Frame : NULL;
+        }
+    private:
+        static bool poll(void* args) {
+            DecodeAwaiter* self = (DecodeAwaiter*) args;
+            self->codec_.Decoded = false;
+            Codec_decode(&self->codec_, &self->stream_);
+            return self->codec_.Decoded || self->stream_.Closed;
+        }
+
+        AsyncCodec&     codec_;
+        InStream&       stream_;
+    };
+    /**
+     * @brief set frame that next frames decoded into, frame reused for each decoded frame
+     *
+     * @param frame
+     */
+    void beginDecode(Frame* frame) {
+        Codec_beginDecode(this, (Codec_Frame*) frame);
+    }
+    /**
+     * @brief wait for next frame, `Frame* frame = co_await codec.decodeNext(stream)`
+     *
+     * @param stream
+     * @return DecodeAwaiter
+     */
+    DecodeAwaiter decodeNext(InStream& stream) {
+        return DecodeAwaiter(*this, stream);
+    }
+#endif // CODEC_DECODE && CODEC_DECODE_ASYNC && CODEC_DECODE_CALLBACK
+
+#if CODEC_ENCODE && CODEC_ENCODE_ASYNC && CODEC_ENCODE_CALLBACK
+    /**
+     * @brief awaiter of encode
+     */
+    class EncodeAwaiter {
+    public:
+        EncodeAwaiter(AsyncCodec& codec, Frame* frame, OutStream& stream) : codec_(codec), stream_(stream) {
+            codec_.Encoded = false;
+            codec_.EncodeFailed = false;
+            Codec_beginEncode(&codec_, (Codec_Frame*) frame, Codec_EncodeMode_Normal);
+        }
+
+        bool await_ready() {
+            return poll(this);
+        }
+        void await_suspend(std::coroutine_handle<> handle) {
+            stream_.Writable.wait(handle, poll, this);
+        }
+        /**
+         * @brief return Done if whole frame written into stream, Error if a layer failed
+         * or stream closed
+         */
+        Codec_Status await_resume() noexcept {
+            return codec_.Encoded ? Codec_Status_Done : Codec_Status_Error;
+        }
+    private:
+        static bool poll(void* args) {
+            EncodeAwaiter* self = (EncodeAwaiter*) args;
+            if (self->stream_.Closed) {
+                return true;
+            }
+            Codec_encode(&self->codec_, &self->stream_);
+            // transmit what written, pending frame need free space
+            self->stream_.flush();
+            return self->codec_.Encoded || self->codec_.EncodeFailed || self->stream_.Closed;
+        }
+
+        AsyncCodec&     codec_;
+        OutStream&      stream_;
+    };
+    /**
+     * @brief write frame into stream, `co_await codec.encode(&frame, stream)`,
+     * coroutine suspended until whole frame fit in stream
+     *
+     * @param frame
+     * @param stream
+     * @return EncodeAwaiter
+     */
+    EncodeAwaiter encode(Frame* frame, OutStream& stream) {
+        return EncodeAwaiter(*this, frame, stream);
+    }
+#endif // CODEC_ENCODE && CODEC_ENCODE_ASYNC && CODEC_ENCODE_CALLBACK
+
+private:
+#if CODEC_DECODE && CODEC_DECODE_CALLBACK
+    static void onFrameDecoded(::Codec* codec, Codec_Frame* frame) {
+        (void) frame;
+        static_cast<AsyncCodec*>(codec)->Decoded = true;
+    }
+#endif
+#if CODEC_ENCODE && CODEC_ENCODE_CALLBACK
+    static void onFrameEncoded(::Codec* codec, Codec_Frame* frame) {
+        (void) frame;
+        static_cast<AsyncCodec*>(codec)->Encoded = true;
+    }
+#endif
+#if CODEC_ENCODE && CODEC_ENCODE_ERROR
+    static void onFrameEncodeError(::Codec* codec, Codec_Frame* frame, Codec_LayerImpl* layer, Codec_Error error) {
+        (void) frame;
+        (void) layer;
+        (void) error;
+        static_cast<AsyncCodec*>(codec)->EncodeFailed = true;
+    }
+#endif
+
+    bool                        Decoded = false;
+    bool                        Encoded = false;
+    bool                        EncodeFailed = false;
+};
+
+} // namespace codec::coro
+
+#endif // _CODEC_CORO_HPP_
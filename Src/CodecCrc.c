@@ -0,0 +1,386 @@
+#include "CodecCrc.h"
+#include <string.h>
+
+#if CODEC_CRC
+
+#if CODEC_CRC_HW
+    #if (defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))) || defined(_M_X64)
+        #include <nmmintrin.h>
+        #include <wmmintrin.h>
+        #define CODEC_CRC_X86           1
+    #endif
+    #if defined(__ARM_FEATURE_CRC32) && defined(__aarch64__) && !defined(__ARM_BIG_ENDIAN)
+        #include <arm_acle.h>
+        #define CODEC_CRC_ARM           1
+    #endif
+#endif // CODEC_CRC_HW
+
+#ifndef CODEC_CRC_X86
+    #define CODEC_CRC_X86               0
+#endif
+#ifndef CODEC_CRC_ARM
+    #define CODEC_CRC_ARM               0
+#endif
+
+#if CODEC_CRC_X86
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+        #define __crcTarget
+    #else
+        #define __crcTarget             __attribute__((target("sse4.2,pclmul")))
+    #endif
+#endif
+
+/**
+ * @brief reflected CRC32C (Castagnoli) polynomial
+ */
+#define CODEC_CRC32C_POLY               0x82F63B78
+/**
+ * @brief length of each lane in folded hardware loop, three lanes are computed in parallel
+ * to hide latency of crc32 instruction then merged with carry-less multiply
+ */
+#define CODEC_CRC_FOLD_BLOCK            256
+
+typedef enum {
+    Codec_CrcHw_None        = 0,
+    Codec_CrcHw_Sse42       = 1,
+    Codec_CrcHw_Fold        = 2,
+} Codec_CrcHw;
+
+static uint32_t         __crcTable[8][256];
+static uint32_t         __crcFold[2];           /**< x^(8 * 2 * BLOCK - 33), x^(8 * BLOCK - 33) */
+static Codec_CrcHw      __crcHw;
+static volatile uint8_t __crcReady;
+
+/**
+ * @brief return x^n modulo polynomial in reflected form
+ */
+static uint32_t Codec_crcPow(uint32_t n) {
+    uint32_t p = 0x80000000;
+    while (n-- > 0) {
+        p = (p & 1) ? (p >> 1) ^ CODEC_CRC32C_POLY : p >> 1;
+    }
+    return p;
+}
+/**
+ * @brief fill slice-by-8 tables, fold constants and detect checksum instructions of cpu,
+ * it called on first use automatically, call it once before threads use checksum functions
+ */
+void Codec_crcInit(void) {
+    uint32_t crc;
+    uint32_t n;
+    uint32_t k;
+
+    for (n = 0; n < 256; n++) {
+        crc = n;
+        for (k = 0; k < 8; k++) {
+            crc = (crc & 1) ? (crc >> 1) ^ CODEC_CRC32C_POLY : crc >> 1;
+        }
+        __crcTable[0][n] = crc;
+    }
+    for (n = 0; n < 256; n++) {
+        crc = __crcTable[0][n];
+        for (k = 1; k < 8; k++) {
+            crc = (crc >> 8) ^ __crcTable[0][crc & 0xFF];
+            __crcTable[k][n] = crc;
+        }
+    }
+    __crcFold[0] = Codec_crcPow(8 * 2 * CODEC_CRC_FOLD_BLOCK - 33);
+    __crcFold[1] = Codec_crcPow(8 * CODEC_CRC_FOLD_BLOCK - 33);
+
+    __crcHw = Codec_CrcHw_None;
+#if CODEC_CRC_X86
+    #if defined(_MSC_VER) && !defined(__clang__)
+    {
+        int info[4];
+        __cpuid(info, 1);
+        if (info[2] & (1 << 20)) {
+            __crcHw = (info[2] & (1 << 1)) ? Codec_CrcHw_Fold : Codec_CrcHw_Sse42;
+        }
+    }
+    #else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.2")) {
+        __crcHw = __builtin_cpu_supports("pclmul") ? Codec_CrcHw_Fold : Codec_CrcHw_Sse42;
+    }
+    #endif
+#endif
+    __crcReady = 1;
+}
+/**
+ * @brief return name of checksum implementation that used on this cpu
+ *
+ * @return const char*
+ */
+const char* Codec_crcImpl(void) {
+    if (!__crcReady) {
+        Codec_crcInit();
+    }
+#if CODEC_CRC_ARM
+    return "arm-crc";
+#else
+    switch (__crcHw) {
+        case Codec_CrcHw_Fold:
+            return "sse4.2+pclmul";
+        case Codec_CrcHw_Sse42:
+            return "sse4.2";
+        default:
+            return "slice-by-8";
+    }
+#endif
+}
+
+/**
+ * @brief update raw checksum register with slice-by-8 tables, bytes copied into dst if it's not NULL
+ */
+static uint32_t Codec_crcTable(uint32_t crc, uint8_t* dst, const uint8_t* src, size_t len) {
+    while (len >= 8) {
+        crc ^= (uint32_t) src[0] | ((uint32_t) src[1] << 8) | ((uint32_t) src[2] << 16) | ((uint32_t) src[3] << 24);
+        crc = __crcTable[7][crc & 0xFF] ^ __crcTable[6][(crc >> 8) & 0xFF] ^
+              __crcTable[5][(crc >> 16) & 0xFF] ^ __crcTable[4][crc >> 24] ^
+              __crcTable[3][src[4]] ^ __crcTable[2][src[5]] ^
+              __crcTable[1][src[6]] ^ __crcTable[0][src[7]];
+        if (dst != NULL) {
+            memcpy(dst, src, 8);
+            dst += 8;
+        }
+        src += 8;
+        len -= 8;
+    }
+    while (len-- > 0) {
+        if (dst != NULL) {
+            *dst++ = *src;
+        }
+        crc = (crc >> 8) ^ __crcTable[0][(crc ^ *src++) & 0xFF];
+    }
+    return crc;
+}
+
+#if CODEC_CRC_X86
+/**
+ * @brief multiply raw checksum by x^(8 * len) with constant of Codec_crcPow(8 * len - 33)
+ */
+__crcTarget static uint64_t Codec_crcShift(uint64_t crc, uint32_t k) {
+    __m128i r = _mm_clmulepi64_si128(_mm_cvtsi32_si128((int) (uint32_t) crc), _mm_cvtsi32_si128((int) k), 0x00);
+    return _mm_crc32_u64(0, (uint64_t) _mm_cvtsi128_si64(r));
+}
+/**
+ * @brief update raw checksum register with crc32 instruction, bytes copied into dst if it's not NULL,
+ * big buffers computed in three lanes and merged with carry-less multiply
+ */
+__crcTarget static uint32_t Codec_crcSse42(uint32_t crc, uint8_t* dst, const uint8_t* src, size_t len) {
+    uint64_t c0 = crc;
+    uint64_t c1;
+    uint64_t c2;
+    uint64_t w0;
+    uint64_t w1;
+    uint64_t w2;
+    size_t i;
+
+    // align source for word loads
+    while (len > 0 && ((uintptr_t) src & 7) != 0) {
+        if (dst != NULL) {
+            *dst++ = *src;
+        }
+        c0 = _mm_crc32_u8((uint32_t) c0, *src++);
+        len--;
+    }
+    if (__crcHw == Codec_CrcHw_Fold) {
+        while (len >= 3 * CODEC_CRC_FOLD_BLOCK) {
+            c1 = 0;
+            c2 = 0;
+            for (i = 0; i < CODEC_CRC_FOLD_BLOCK; i += 8) {
+                memcpy(&w0, src + i, 8);
+                memcpy(&w1, src + CODEC_CRC_FOLD_BLOCK + i, 8);
+                memcpy(&w2, src + 2 * CODEC_CRC_FOLD_BLOCK + i, 8);
+                c0 = _mm_crc32_u64(c0, w0);
+                c1 = _mm_crc32_u64(c1, w1);
+                c2 = _mm_crc32_u64(c2, w2);
+                if (dst != NULL) {
+                    memcpy(dst + i, &w0, 8);
+                    memcpy(dst + CODEC_CRC_FOLD_BLOCK + i, &w1, 8);
+                    memcpy(dst + 2 * CODEC_CRC_FOLD_BLOCK + i, &w2, 8);
+                }
+            }
+            c0 = Codec_crcShift(c0, __crcFold[0]) ^ Codec_crcShift(c1, __crcFold[1]) ^ c2;
+            if (dst != NULL) {
+                dst += 3 * CODEC_CRC_FOLD_BLOCK;
+            }
+            src += 3 * CODEC_CRC_FOLD_BLOCK;
+            len -= 3 * CODEC_CRC_FOLD_BLOCK;
+        }
+    }
+    while (len >= 8) {
+        memcpy(&w0, src, 8);
+        c0 = _mm_crc32_u64(c0, w0);
+        if (dst != NULL) {
+            memcpy(dst, &w0, 8);
+            dst += 8;
+        }
+        src += 8;
+        len -= 8;
+    }
+    while (len-- > 0) {
+        if (dst != NULL) {
+            *dst++ = *src;
+        }
+        c0 = _mm_crc32_u8((uint32_t) c0, *src++);
+    }
+    return (uint32_t) c0;
+}
+#endif // CODEC_CRC_X86
+
+#if CODEC_CRC_ARM
+/**
+ * @brief update raw checksum register with CRC extension, bytes copied into dst if it's not NULL
+ */
+static uint32_t Codec_crcArm(uint32_t crc, uint8_t* dst, const uint8_t* src, size_t len) {
+    uint64_t w;
+
+    while (len >= 8) {
+        memcpy(&w, src, 8);
+        crc = __crc32cd(crc, w);
+        if (dst != NULL) {
+            memcpy(dst, &w, 8);
+            dst += 8;
+        }
+        src += 8;
+        len -= 8;
+    }
+    while (len-- > 0) {
+        if (dst != NULL) {
+            *dst++ = *src;
+        }
+        crc = __crc32cb(crc, *src++);
+    }
+    return crc;
+}
+#endif // CODEC_CRC_ARM
+
+/**
+ * @brief update raw checksum register with best implementation of cpu
+ */
+static uint32_t Codec_crcUpdate(uint32_t crc, uint8_t* dst, const uint8_t* src, size_t len) {
+#if CODEC_CRC_ARM
+    return Codec_crcArm(crc, dst, src, len);
+#else
+    if (!__crcReady) {
+        Codec_crcInit();
+    }
+#if CODEC_CRC_X86
+    if (__crcHw != Codec_CrcHw_None) {
+        return Codec_crcSse42(crc, dst, src, len);
+    }
+#endif
+    return Codec_crcTable(crc, dst, src, len);
+#endif
+}
+/**
+ * @brief compute CRC32C of bytes, it can continue from checksum of previous bytes
+ *
+ * @param crc checksum of previous bytes, CODEC_CRC32C_INIT for first bytes
+ * @param data
+ * @param len
+ * @return uint32_t checksum of previous bytes and data
+ */
+uint32_t Codec_crc32c(uint32_t crc, const uint8_t* data, Stream_LenType len) {
+    return ~Codec_crcUpdate(~crc, NULL, data, (size_t) len);
+}
+/**
+ * @brief copy bytes and compute their CRC32C in same pass
+ *
+ * @param crc checksum of previous bytes, CODEC_CRC32C_INIT for first bytes
+ * @param dst
+ * @param src
+ * @param len
+ * @return uint32_t checksum of previous bytes and src
+ */
+uint32_t Codec_crc32cCopy(uint32_t crc, uint8_t* dst, const uint8_t* src, Stream_LenType len) {
+    return ~Codec_crcUpdate(~crc, dst, src, (size_t) len);
+}
+
+#if CODEC_DECODE
+/**
+ * @brief read bytes from stream and update their CRC32C in same pass
+ *
+ * @param stream
+ * @param data
+ * @param len
+ * @param crc checksum of previous bytes, updated with read bytes
+ * @return Codec_Error
+ */
+Codec_Error Codec_crc32cRead(StreamIn* stream, uint8_t* data, Stream_LenType len, uint32_t* crc) {
+    Stream_LenType direct;
+    uint32_t c;
+
+    if (IStream_available(stream) < len) {
+        return Stream_NoAvailable | CODEC_ERROR_STREAM;
+    }
+    c = ~*crc;
+    direct = IStream_directAvailable(stream);
+    if (direct > len) {
+        direct = len;
+    }
+    c = Codec_crcUpdate(c, data, IStream_getReadPtr(stream), (size_t) direct);
+    IStream_moveReadPos(stream, direct);
+    if (len > direct) {
+        // bytes wrapped around end of buffer
+        c = Codec_crcUpdate(c, data + direct, IStream_getReadPtr(stream), (size_t) (len - direct));
+        IStream_moveReadPos(stream, len - direct);
+    }
+    *crc = ~c;
+    return CODEC_OK;
+}
+#if CODEC_DECODE_VIEW
+/**
+ * @brief compute CRC32C of bytes of view
+ *
+ * @param crc checksum of previous bytes, CODEC_CRC32C_INIT for first bytes
+ * @param view
+ * @return uint32_t checksum of previous bytes and view
+ */
+uint32_t Codec_crc32cView(uint32_t crc, const Codec_View* view) {
+    uint32_t c = Codec_crcUpdate(~crc, NULL, view->Data[0], (size_t) view->Len[0]);
+    if (view->Len[1] > 0) {
+        c = Codec_crcUpdate(c, NULL, view->Data[1], (size_t) view->Len[1]);
+    }
+    return ~c;
+}
+#endif // CODEC_DECODE_VIEW
+#endif // CODEC_DECODE
+
+#if CODEC_ENCODE
+/**
+ * @brief write bytes into stream and update their CRC32C in same pass
+ *
+ * @param stream
+ * @param data
+ * @param len
+ * @param crc checksum of previous bytes, updated with written bytes
+ * @return Codec_Error
+ */
+Codec_Error Codec_crc32cWrite(StreamOut* stream, const uint8_t* data, Stream_LenType len, uint32_t* crc) {
+    Stream_LenType direct;
+    uint32_t c;
+
+    if (OStream_space(stream) < len) {
+        return Stream_NoSpace | CODEC_ERROR_STREAM;
+    }
+    c = ~*crc;
+    direct = OStream_directSpace(stream);
+    if (direct > len) {
+        direct = len;
+    }
+    c = Codec_crcUpdate(c, OStream_getWritePtr(stream), data, (size_t) direct);
+    OStream_moveWritePos(stream, direct);
+    if (len > direct) {
+        // space wrapped around end of buffer
+        c = Codec_crcUpdate(c, OStream_getWritePtr(stream), data + direct, (size_t) (len - direct));
+        OStream_moveWritePos(stream, len - direct);
+    }
+    *crc = ~c;
+    return CODEC_OK;
+}
+#endif // CODEC_ENCODE
+
+#endif // CODEC_CRC
@@ -0,0 +1,53 @@
+/**
+ * @file CodecCrc.h
+ * @author Ali Mirghasemi (ali.mirghasemi1376@gmail.com)
+ * @brief this library implement CRC32C (Castagnoli) checksum for frames,
+ * it use SSE4.2 crc32 with PCLMUL folding on x86-64 and CRC extension on ARM when they are
+ * available, otherwise slice-by-8 tables, copy variants compute checksum while bytes are
+ * copied into/out of streams so payload is touched only once
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _CODEC_CRC_H_
+#define _CODEC_CRC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "Codec.h"
+
+#if CODEC_CRC
+
+/**
+ * @brief initial value of checksum, pass it as crc of first call
+ */
+#define CODEC_CRC32C_INIT               0
+
+void Codec_crcInit(void);
+const char* Codec_crcImpl(void);
+
+uint32_t Codec_crc32c(uint32_t crc, const uint8_t* data, Stream_LenType len);
+uint32_t Codec_crc32cCopy(uint32_t crc, uint8_t* dst, const uint8_t* src, Stream_LenType len);
+
+#if CODEC_DECODE
+Codec_Error Codec_crc32cRead(StreamIn* stream, uint8_t* data, Stream_LenType len, uint32_t* crc);
+#if CODEC_DECODE_VIEW
+uint32_t Codec_crc32cView(uint32_t crc, const Codec_View* view);
+#endif
+#endif // CODEC_DECODE
+
+#if CODEC_ENCODE
+Codec_Error Codec_crc32cWrite(StreamOut* stream, const uint8_t* data, Stream_LenType len, uint32_t* crc);
+#endif // CODEC_ENCODE
+
+#endif // CODEC_CRC
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* _CODEC_CRC_H_ */
@@ -0,0 +1,304 @@
+/**
+ * @file CodecEpoll.hpp
+ * @author Ali Mirghasemi (ali.mirghasemi1376@gmail.com)
+ * @brief reference epoll executor for CodecCoro.hpp on Linux, each channel is a pair of
+ * awaitable streams over a non-blocking fd, all channels driven by a single thread
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _CODEC_EPOLL_HPP_
+#define _CODEC_EPOLL_HPP_
+
+#include "CodecCoro.hpp"
+
+#if !defined(__linux__)
+    #error "CodecEpoll.hpp need Linux"
+#endif
+
+#include <sys/epoll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+namespace codec::coro {
+
+class EpollExecutor;
+
+/**
+ * @brief connection of epoll executor, input and output stream of a fd,
+ * channel must stay alive until it removed and current run iteration returned
+ */
+class Channel {
+public:
+    Channel(int fd, uint8_t* rxBuff, Stream_LenType rxSize, uint8_t* txBuff, Stream_LenType txSize) :
+        In(rxBuff, rxSize), Out(txBuff, txSize), Fd(fd) {
+        In.Owner = this;
+        Out.Owner = this;
+    }
+    Channel(const Channel&) = delete;
+    Channel& operator=(const Channel&) = delete;
+
+    InStream                    In;
+    OutStream                   Out;
+    int                         Fd;
+private:
+    friend class EpollExecutor;
+
+    EpollExecutor*              Executor = NULL;
+    Channel*                    NextDirty = NULL;
+    uint32_t                    Events = 0;         /**< armed epoll events */
+    bool                        Dirty = false;      /**< output waits in dirty list */
+};
+
+/**
+ * @brief single thread executor, read ready fds into input streams, resume waiting decoders
+ * then transmit output streams that coroutines wrote into
+ */
+class EpollExecutor {
+public:
+    /**
+     * @brief max number of events that handled in a run iteration
+     */
+    static constexpr int MaxEvents = 256;
+
+    EpollExecutor() {
+        Fd = epoll_create1(EPOLL_CLOEXEC);
+    }
+    ~EpollExecutor() {
+        if (Fd >= 0) {
+            ::close(Fd);
+        }
+    }
+    EpollExecutor(const EpollExecutor&) = delete;
+    EpollExecutor& operator=(const EpollExecutor&) = delete;
+
+    /**
+     * @brief return true if epoll instance created
+     */
+    bool valid() const noexcept {
+        return Fd >= 0;
+    }
+    /**
+     * @brief add channel into executor, fd switched to non-blocking mode
+     *
+     * @param channel
+     * @return bool false if fd can't be added
+     */
+    bool add(Channel& channel) {
+        struct epoll_event ev;
+        int flags = fcntl(channel.Fd, F_GETFL, 0);
+
+        if (flags < 0 || fcntl(channel.Fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+            return false;
+        }
+        ev.events = EPOLLIN;
+        ev.data.ptr = &channel;
+        if (epoll_ctl(Fd, EPOLL_CTL_ADD, channel.Fd, &ev) < 0) {
+            return false;
+        }
+        channel.Executor = this;
+        channel.Events = EPOLLIN;
+        channel.In.onWait = onWait;
+        channel.Out.onFlush = onFlush;
+        Channels++;
+        return true;
+    }
+    /**
+     * @brief remove channel from executor, streams closed and waiters resumed,
+     * fd is not closed
+     *
+     * @param channel
+     */
+    void remove(Channel& channel) {
+        if (channel.Executor != this) {
+            return;
+        }
+        epoll_ctl(Fd, EPOLL_CTL_DEL, channel.Fd, NULL);
+        channel.Executor = NULL;
+        channel.In.onWait = NULL;
+        channel.Out.onFlush = NULL;
+        Channels--;
+        close(channel);
+    }
+    /**
+     * @brief return number of channels in executor
+     */
+    uint32_t channels() const noexcept {
+        return Channels;
+    }
+    /**
+     * @brief wait for events and handle them once
+     *
+     * @param timeout in milliseconds, -1 wait forever
+     * @return int number of handled events, -1 on error
+     */
+    int runOnce(int timeout) {
+        struct epoll_event events[MaxEvents];
+        Channel* channel;
+        int n;
+        int i;
+
+        // transmit bytes that written before run
+        transmitDirty();
+        n = epoll_wait(Fd, events, MaxEvents, timeout);
+        if (n < 0) {
+            return errno == EINTR ? 0 : -1;
+        }
+        for (i = 0; i < n; i++) {
+            channel = (Channel*) events[i].data.ptr;
+            if (channel->Executor != this) {
+                // removed by a coroutine in this iteration
+                continue;
+            }
+            if ((events[i].events & EPOLLOUT) != 0) {
+                transmit(*channel);
+            }
+            if ((events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0 && channel->Executor == this) {
+                receive(*channel);
+            }
+            transmitDirty();
+        }
+        return n;
+    }
+    /**
+     * @brief run until stop called or all channels removed
+     */
+    void run() {
+        Running = true;
+        while (Running && Channels > 0) {
+            if (runOnce(-1) < 0) {
+                break;
+            }
+        }
+        Running = false;
+    }
+    /**
+     * @brief stop run loop after current iteration
+     */
+    void stop() noexcept {
+        Running = false;
+    }
+
+private:
+    static void onWait(InStream* stream) {
+        Channel* channel = (Channel*) stream->Owner;
+        if ((channel->Events & EPOLLIN) == 0 && IStream_space(stream) > 0) {
+            // consumer made space, read again
+            channel->Executor->arm(*channel, channel->Events | EPOLLIN);
+        }
+    }
+    static void onFlush(OutStream* stream) {
+        Channel* channel = (Channel*) stream->Owner;
+        EpollExecutor* executor = channel->Executor;
+        if (!channel->Dirty) {
+            // transmit later, writer may still run inside poll of its awaiter
+            channel->Dirty = true;
+            channel->NextDirty = executor->DirtyHead;
+            executor->DirtyHead = channel;
+        }
+    }
+
+    void arm(Channel& channel, uint32_t events) {
+        struct epoll_event ev;
+        if (channel.Events != events) {
+            ev.events = events;
+            ev.data.ptr = &channel;
+            epoll_ctl(Fd, EPOLL_CTL_MOD, channel.Fd, &ev);
+            channel.Events = events;
+        }
+    }
+    void close(Channel& channel) {
+        channel.In.Closed = true;
+        channel.Out.Closed = true;
+        channel.In.Readable.notify();
+        channel.Out.Writable.notify();
+    }
+    /**
+     * @brief read fd into input stream and notify waiting decoder
+     */
+    void receive(Channel& channel) {
+        StreamIn* stream = &channel.In;
+        Stream_LenType space;
+        ssize_t len;
+
+        while ((space = Stream_directSpace(&stream->Buffer)) > 0) {
+            len = ::read(channel.Fd, Stream_getWritePtr(&stream->Buffer), (size_t) space);
+            if (len > 0) {
+                Stream_moveWritePos(&stream->Buffer, (Stream_LenType) len);
+            }
+            else if (len < 0 && errno == EINTR) {
+                continue;
+            }
+            else if (len < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;
+            }
+            else {
+                // end of stream or fd failed
+                channel.In.Closed = true;
+                arm(channel, channel.Events & ~EPOLLIN);
+                break;
+            }
+        }
+        if (!channel.In.Closed && IStream_space(stream) == 0) {
+            // stream is full, stop read until decoder wait again
+            arm(channel, channel.Events & ~EPOLLIN);
+        }
+        channel.In.Readable.notify();
+    }
+    /**
+     * @brief write pending bytes of output stream into fd and notify waiting encoder
+     */
+    void transmit(Channel& channel) {
+        StreamOut* stream = &channel.Out;
+        Stream_LenType pending;
+        Stream_LenType sent = 0;
+        ssize_t len;
+
+        while ((pending = Stream_directAvailable(&stream->Buffer)) > 0) {
+            len = ::write(channel.Fd, Stream_getReadPtr(&stream->Buffer), (size_t) pending);
+            if (len > 0) {
+                Stream_moveReadPos(&stream->Buffer, (Stream_LenType) len);
+                sent += (Stream_LenType) len;
+            }
+            else if (len < 0 && errno == EINTR) {
+                continue;
+            }
+            else if (len < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;
+            }
+            else {
+                channel.Out.Closed = true;
+                break;
+            }
+        }
+        if (channel.Executor == this) {
+            arm(channel, OStream_pendingBytes(stream) > 0 && !channel.Out.Closed ?
+                (channel.Events | EPOLLOUT) : (channel.Events & ~EPOLLOUT));
+        }
+        if (sent > 0 || channel.Out.Closed) {
+            channel.Out.Writable.notify();
+        }
+    }
+    void transmitDirty() {
+        Channel* channel;
+        while ((channel = DirtyHead) != NULL) {
+            DirtyHead = channel->NextDirty;
+            channel->Dirty = false;
+            if (channel->Executor == this && (channel->Events & EPOLLOUT) == 0) {
+                transmit(*channel);
+            }
+        }
+    }
+
+    int                         Fd;
+    Channel*                    DirtyHead = NULL;
+    uint32_t                    Channels = 0;
+    bool                        Running = false;
+};
+
+} // namespace codec::coro
+
+#endif // _CODEC_EPOLL_HPP_
@@ -0,0 +1,173 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+    #define _POSIX_C_SOURCE             200112L
+#endif
+
+#include "CodecFd.h"
+
+#if CODEC_FD_STREAM
+
+#include <errno.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if CODEC_DECODE
+/**
+ * @brief initialize input stream over file descriptor, fd must be non-blocking
+ * for use in event loops, bytes read with Codec_FdIn_read or Codec_FdIn_decode
+ *
+ * @param stream
+ * @param fd
+ * @param buff buffer of stream
+ * @param size size of buffer
+ */
+void Codec_FdIn_init(StreamIn* stream, int fd, uint8_t* buff, Stream_LenType size) {
+    IStream_init(stream, NULL, buff, size);
+    IStream_setArgs(stream, (void*) (intptr_t) fd);
+}
+/**
+ * @brief read file descriptor into free space of stream, space after write position
+ * and wrapped space at begin of buffer filled with a single readv
+ *
+ * @param stream
+ * @return ssize_t number of read bytes, 0 if fd has no bytes or stream is full,
+ * CODEC_FD_CLOSED if peer closed fd, -1 on error
+ */
+ssize_t Codec_FdIn_read(StreamIn* stream) {
+    struct iovec iov[2];
+    Stream_LenType space = IStream_space(stream);
+    Stream_LenType direct;
+    ssize_t len;
+    int count = 1;
+
+    if (space == 0) {
+        return 0;
+    }
+    direct = IStream_directSpace(stream);
+    iov[0].iov_base = IStream_getWritePtr(stream);
+    iov[0].iov_len = (size_t) direct;
+    if (space > direct) {
+        // free space wrapped around end of buffer
+        iov[1].iov_base = IStream_getDataPtr(stream);
+        iov[1].iov_len = (size_t) (space - direct);
+        count = 2;
+    }
+    do {
+        len = readv(Codec_Fd_get(stream), iov, count);
+    } while (len < 0 && errno == EINTR);
+
+    if (len > 0) {
+        IStream_moveWritePos(stream, (Stream_LenType) len);
+    }
+    else if (len == 0) {
+        return CODEC_FD_CLOSED;
+    }
+    else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        return 0;
+    }
+    return len;
+}
+#if CODEC_DECODE_ASYNC
+/**
+ * @brief read file descriptor until it has no more bytes and decode after each read,
+ * caller must enable Codec_setDecodeAll, otherwise each read decode only one frame
+ * and rest of frames stay in stream after fd drained
+ *
+ * @param codec
+ * @param stream input stream that initialized with Codec_FdIn_init
+ * @return ssize_t number of read bytes, CODEC_FD_CLOSED if peer closed fd, -1 on error
+ */
+ssize_t Codec_FdIn_decode(Codec* codec, StreamIn* stream) {
+    ssize_t total = 0;
+    ssize_t len;
+
+    while ((len = Codec_FdIn_read(stream)) > 0) {
+        total += len;
+        Codec_decode(codec, stream);
+    }
+
+    return len < 0 ? len : total;
+}
+#endif // CODEC_DECODE_ASYNC
+#endif // CODEC_DECODE
+
+#if CODEC_ENCODE
+/**
+ * @brief write pending bytes of stream with a single writev
+ *
+ * @param stream
+ * @return ssize_t number of written bytes, 0 if fd is not writable, -1 on error
+ */
+static ssize_t Codec_FdOut_writev(StreamOut* stream) {
+    struct iovec iov[2];
+    Stream_LenType pending = OStream_pendingBytes(stream);
+    Stream_LenType direct;
+    ssize_t len;
+    int count = 1;
+
+    if (pending == 0) {
+        return 0;
+    }
+    direct = OStream_directAvailable(stream);
+    iov[0].iov_base = OStream_getReadPtr(stream);
+    iov[0].iov_len = (size_t) direct;
+    if (pending > direct) {
+        // pending bytes wrapped around end of buffer
+        iov[1].iov_base = OStream_getDataPtr(stream);
+        iov[1].iov_len = (size_t) (pending - direct);
+        count = 2;
+    }
+    do {
+        len = writev(Codec_Fd_get(stream), iov, count);
+    } while (len < 0 && errno == EINTR);
+
+    if (len < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return 0;
+    }
+    return len;
+}
+/**
+ * @brief transmit function of stream, called by OStream_flush, so Codec_EncodeMode_Flush
+ * and Codec_EncodeMode_FlushLayer write bytes directly into fd, when fd is not writable
+ * stream stay in transmit until Codec_FdOut_flush called
+ */
+static Stream_LenType Codec_FdOut_transmit(StreamOut* stream, uint8_t* buff, Stream_LenType len) {
+    ssize_t sent = Codec_FdOut_writev(stream);
+
+    (void) buff;
+    (void) len;
+    if (sent > 0) {
+        OStream_handle(stream, (Stream_LenType) sent);
+    }
+    return sent > 0 ? (Stream_LenType) sent : 0;
+}
+/**
+ * @brief initialize output stream over file descriptor, fd must be non-blocking
+ * for use in event loops
+ *
+ * @param stream
+ * @param fd
+ * @param buff buffer of stream
+ * @param size size of buffer
+ */
+void Codec_FdOut_init(StreamOut* stream, int fd, uint8_t* buff, Stream_LenType size) {
+    OStream_init(stream, Codec_FdOut_transmit, buff, size);
+    OStream_setArgs(stream, (void*) (intptr_t) fd);
+}
+/**
+ * @brief write pending bytes of stream into fd, call it when fd become writable
+ * or after encode in Codec_EncodeMode_Normal
+ *
+ * @param stream output stream that initialized with Codec_FdOut_init
+ * @return ssize_t number of written bytes, 0 if fd is not writable, -1 on error
+ */
+ssize_t Codec_FdOut_flush(StreamOut* stream) {
+    ssize_t sent = Codec_FdOut_writev(stream);
+
+    if (sent > 0) {
+        OStream_handle(stream, (Stream_LenType) sent);
+    }
+    return sent;
+}
+#endif // CODEC_ENCODE
+
+#endif // CODEC_FD_STREAM
@@ -0,0 +1,55 @@
+/**
+ * @file CodecFd.h
+ * @author Ali Mirghasemi (ali.mirghasemi1376@gmail.com)
+ * @brief this library bind streams to non-blocking file descriptors on posix platforms,
+ * both ring segments of a stream filled with one readv and drained with one writev
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _CODEC_FD_H_
+#define _CODEC_FD_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "Codec.h"
+
+#if CODEC_FD_STREAM
+
+#include <stdint.h>
+#include <sys/types.h>
+
+/**
+ * @brief returned by read functions when peer closed file descriptor
+ */
+#define CODEC_FD_CLOSED                 (-2)
+
+/**
+ * @brief return file descriptor that bound to stream
+ */
+#define Codec_Fd_get(STREAM)            ((int) (intptr_t) (STREAM)->Args)
+
+#if CODEC_DECODE
+void Codec_FdIn_init(StreamIn* stream, int fd, uint8_t* buff, Stream_LenType size);
+ssize_t Codec_FdIn_read(StreamIn* stream);
+#if CODEC_DECODE_ASYNC
+ssize_t Codec_FdIn_decode(Codec* codec, StreamIn* stream);
+#endif // CODEC_DECODE_ASYNC
+#endif // CODEC_DECODE
+
+#if CODEC_ENCODE
+void Codec_FdOut_init(StreamOut* stream, int fd, uint8_t* buff, Stream_LenType size);
+ssize_t Codec_FdOut_flush(StreamOut* stream);
+#endif // CODEC_ENCODE
+
+#endif // CODEC_FD_STREAM
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* _CODEC_FD_H_ */
@@ -67,6 +67,30 @@
 #define CODEC_VALUE_LEN_VAL(VAL)                sizeof(VAL)
 #define CODEC_VALUE_LEN_TYPE(TYPE, VAL)         sizeof(STREAM_VALUE_TYPE(TYPE))
 #define CODEC_VALUE_LEN_ARR(TYPE, VAL, LEN)     sizeof(STREAM_VALUE_TYPE(TYPE)) * (LEN)
+
+// -------------------------------------- Fixed Length APIs -------------------------------------
+// typed values have fixed size, raw values and arrays need frame to get their size
+#define CODEC_FIXED_LEN_0(...)
+#define CODEC_FIXED_LEN_1(VAL)
+#define CODEC_FIXED_LEN_2(TYPE, VAL)            + sizeof(STREAM_VALUE_TYPE(TYPE))
+#define CODEC_FIXED_LEN_3(TYPE, VAL, LEN)
+
+#define CODEC_FIXED_DYNAMIC_0(...)
+#define CODEC_FIXED_DYNAMIC_1(VAL)              | 1
+#define CODEC_FIXED_DYNAMIC_2(TYPE, VAL)
+#define CODEC_FIXED_DYNAMIC_3(TYPE, VAL, LEN)   | 1
+
+#define CODEC_IMPL_FIXED_LEN(...)               (0 MACRO_FOR_MAP((CODEC_FIXED_LEN_3, CODEC_FIXED_LEN_2, CODEC_FIXED_LEN_1, CODEC_FIXED_LEN_0), __VA_ARGS__))
+#define CODEC_IMPL_FIXED_FLAGS(...)             ((0 MACRO_FOR_MAP((CODEC_FIXED_DYNAMIC_3, CODEC_FIXED_DYNAMIC_2, CODEC_FIXED_DYNAMIC_1, CODEC_FIXED_DYNAMIC_0), __VA_ARGS__)) ? 0 : CODEC_LAYER_FIXED_LEN)
+
+#if CODEC_LAYER_FIXED
+    #define CODEC_IMPL_LAYER_FIXED(FLAGS, LEN, NEXT) \
+        .Flags = (FLAGS), \
+        .FixedLen = (LEN), \
+        .FixedNext = (Codec_LayerImpl*) (NEXT),
+#else
+    #define CODEC_IMPL_LAYER_FIXED(FLAGS, LEN, NEXT)
+#endif
     
 // ------------------------------------ Implementation Macros ----------------------------------
 
@@ -98,12 +122,27 @@
         return len; \
     }
 
+#define CODEC_IMPL_NEXT_LAYER(NAME, FN_PREFIX, NEXT) \
+    FN_PREFIX Codec_LayerImpl* NAME(Codec* codec, Codec_Frame* frame, Codec_Phase phase) { \
+        return (Codec_LayerImpl*) (NEXT); \
+    }
+
 #define CODEC_IMPL_LAYER_OBJ(NAME, OBJ_PREFIX, NEXT_LAYER, ...) \
     OBJ_PREFIX Codec_LayerImpl NAME = { \
         .parse = NAME ## _parse, \
         .write = NAME ## _write, \
         .getLen = NAME ## _getLen, \
         .nextLayer = NEXT_LAYER, \
+        CODEC_IMPL_LAYER_FIXED(CODEC_IMPL_FIXED_FLAGS(__VA_ARGS__), CODEC_IMPL_FIXED_LEN(__VA_ARGS__), CODEC_LAYER_NULL) \
+    };
+
+#define CODEC_IMPL_LAYER_NEXT_OBJ(NAME, OBJ_PREFIX, NEXT, ...) \
+    OBJ_PREFIX Codec_LayerImpl NAME = { \
+        .parse = NAME ## _parse, \
+        .write = NAME ## _write, \
+        .getLen = NAME ## _getLen, \
+        .nextLayer = NAME ## _nextLayer, \
+        CODEC_IMPL_LAYER_FIXED(CODEC_IMPL_FIXED_FLAGS(__VA_ARGS__) | CODEC_LAYER_FIXED_NEXT, CODEC_IMPL_FIXED_LEN(__VA_ARGS__), NEXT) \
     };
 
 #define CODEC_IMPL_LAYER(NAME, PACKET_TYPE, FN_PREFIX, OBJ_PREFIX, NEXT_LAYER, ...) \
@@ -112,4 +151,15 @@
     CODEC_IMPL_GET_LEN(NAME ## _getLen, FN_PREFIX, PACKET_TYPE, __VA_ARGS__) \
     CODEC_IMPL_LAYER_OBJ(NAME, OBJ_PREFIX, NEXT_LAYER, __VA_ARGS__)
 
+/**
+ * @brief same as CODEC_IMPL_LAYER but next layer is fixed, NEXT is address of next layer object
+ * or CODEC_LAYER_NULL for last layer, next layer object must be declared before
+ */
+#define CODEC_IMPL_LAYER_NEXT(NAME, PACKET_TYPE, FN_PREFIX, OBJ_PREFIX, NEXT, ...) \
+    CODEC_IMPL_ENCODE(NAME ## _write, FN_PREFIX, PACKET_TYPE, __VA_ARGS__) \
+    CODEC_IMPL_DECODE(NAME ## _parse, FN_PREFIX,PACKET_TYPE, __VA_ARGS__) \
+    CODEC_IMPL_GET_LEN(NAME ## _getLen, FN_PREFIX, PACKET_TYPE, __VA_ARGS__) \
+    CODEC_IMPL_NEXT_LAYER(NAME ## _nextLayer, FN_PREFIX, NEXT) \
+    CODEC_IMPL_LAYER_NEXT_OBJ(NAME, OBJ_PREFIX, NEXT, __VA_ARGS__)
+
 #endif // _CODEC_MACRO_H_
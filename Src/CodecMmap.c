@@ -0,0 +1,261 @@
+#if !defined(_WIN32) && !defined(_DEFAULT_SOURCE)
+    #define _DEFAULT_SOURCE
+#endif
+#if !defined(_FILE_OFFSET_BITS)
+    #define _FILE_OFFSET_BITS           64
+#endif
+
+#include "CodecMmap.h"
+
+#if CODEC_MMAP
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#ifndef NULL
+    #define NULL          ((void*) 0)
+#endif
+
+/**
+ * @brief give advice for a range of mapping, range extended to page boundaries
+ *
+ * @param file
+ * @param offset file offset of range
+ * @param len length of range
+ * @param advice madvise advice
+ * @return int result of madvise
+ */
+static int Codec_MmapFile_advise(Codec_MmapFile* file, uint64_t offset, uint64_t len, int advice) {
+    uint64_t page = (uint64_t) sysconf(_SC_PAGESIZE);
+    uint64_t begin = offset & ~(page - 1);
+
+    if (file->Data == NULL || offset >= file->Size) {
+        return 0;
+    }
+    if (len > file->Size - offset) {
+        len = file->Size - offset;
+    }
+    return madvise((void*) (file->Data + begin), (size_t) (offset + len - begin), advice);
+}
+/**
+ * @brief map a file read-only for sequential decode, kernel read ahead aggressively
+ * and pages are backed by huge pages when file system support them
+ *
+ * @param file
+ * @param path
+ * @param window max bytes of stream window, must be bigger than biggest frame
+ * @return int 0 on success, -1 on error and errno is set
+ */
+int Codec_MmapFile_open(Codec_MmapFile* file, const char* path, Stream_LenType window) {
+    struct stat st;
+    void* data;
+
+    file->Data = NULL;
+    file->Size = 0;
+    file->Offset = 0;
+    file->Window = window;
+    file->Len = 0;
+    file->Advised = 0;
+    file->HugeAdvised = 0;
+    if ((file->Fd = open(path, O_RDONLY | O_CLOEXEC)) < 0) {
+        return -1;
+    }
+    if (fstat(file->Fd, &st) < 0) {
+        close(file->Fd);
+        file->Fd = -1;
+        return -1;
+    }
+    file->Size = (uint64_t) st.st_size;
+    if (file->Size == 0) {
+        // nothing to map
+        return 0;
+    }
+    data = mmap(NULL, (size_t) file->Size, PROT_READ, MAP_PRIVATE, file->Fd, 0);
+    if (data == MAP_FAILED) {
+        close(file->Fd);
+        file->Fd = -1;
+        return -1;
+    }
+    file->Data = (const uint8_t*) data;
+#ifdef MADV_HUGEPAGE
+    // only advice, kernel may still map file with normal pages
+    file->HugeAdvised = madvise(data, (size_t) file->Size, MADV_HUGEPAGE) == 0;
+#endif
+    madvise(data, (size_t) file->Size, MADV_SEQUENTIAL);
+#if defined(POSIX_FADV_SEQUENTIAL)
+    posix_fadvise(file->Fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    return 0;
+}
+/**
+ * @brief unmap file and close its file descriptor
+ *
+ * @param file
+ */
+void Codec_MmapFile_close(Codec_MmapFile* file) {
+    if (file->Data != NULL) {
+        munmap((void*) file->Data, (size_t) file->Size);
+        file->Data = NULL;
+    }
+    if (file->Fd >= 0) {
+        close(file->Fd);
+        file->Fd = -1;
+    }
+}
+/**
+ * @brief switch mapping to random access, call it before decode frames by index,
+ * so kernel stop read ahead
+ *
+ * @param file
+ */
+void Codec_MmapFile_random(Codec_MmapFile* file) {
+    Codec_MmapFile_advise(file, 0, file->Size, MADV_RANDOM);
+}
+/**
+ * @brief initialize input stream over window of mapping at offset,
+ * stream buffer is the mapping itself, so stream must be only read
+ *
+ * @param file
+ * @param stream
+ * @param offset file offset of first byte of window
+ */
+void Codec_MmapIn_init(Codec_MmapFile* file, StreamIn* stream, uint64_t offset) {
+    uint64_t remaining = offset < file->Size ? file->Size - offset : 0;
+
+    file->Offset = offset < file->Size ? offset : file->Size;
+    file->Len = remaining < (uint64_t) file->Window ? (Stream_LenType) remaining : file->Window;
+    IStream_init(stream, NULL, (uint8_t*) file->Data + file->Offset, file->Len);
+    IStream_moveWritePos(stream, file->Len);
+    if (file->Offset + (uint64_t) file->Len > file->Advised) {
+        // read ahead of window while current window decoding
+        file->Advised = file->Offset + (uint64_t) file->Len;
+        Codec_MmapFile_advise(file, file->Advised, CODEC_MMAP_READAHEAD, MADV_WILLNEED);
+        file->Advised += CODEC_MMAP_READAHEAD;
+    }
+}
+/**
+ * @brief slide window of stream after bytes that consumed from stream,
+ * unconsumed bytes like an incomplete frame stay at begin of next window,
+ * when a frame candidate fill whole window it can't be a valid frame and its first byte dropped
+ *
+ * @param file
+ * @param stream stream that initialized with Codec_MmapIn_init
+ * @return uint8_t 1 if stream has a new window, 0 at end of file
+ */
+uint8_t Codec_MmapIn_next(Codec_MmapFile* file, StreamIn* stream) {
+    uint64_t offset = Codec_MmapIn_offset(file, stream);
+
+    if (file->Offset + (uint64_t) file->Len >= file->Size) {
+        // window reached end of file, rest of bytes never complete
+        return 0;
+    }
+    if (offset == file->Offset) {
+        offset++;
+    }
+    Codec_MmapIn_init(file, stream, offset);
+    return 1;
+}
+/**
+ * @brief decode next frame of mapped file from offset, stream window always begin at offset,
+ * so result only depend on offset and decode of a file can start from any offset
+ * and continue same as a decode that started from begin of file when it reach same offset
+ *
+ * @param codec
+ * @param frame
+ * @param file mapped file
+ * @param offset file offset to decode from, return offset after decoded frame or dropped noise,
+ * size of file when rest of file has no complete frame
+ * @param entry return index entry of decoded frame
+ * @return int8_t 1 if a frame decoded, 0 if only noise dropped, -1 if frame doesn't fit in an index entry
+ */
+int8_t Codec_indexNext(Codec* codec, Codec_Frame* frame, Codec_MmapFile* file, uint64_t* offset, Codec_IndexEntry* entry) {
+    StreamIn stream;
+    Stream_LenType skipped;
+    uint64_t begin;
+    uint64_t len;
+
+    Codec_MmapIn_init(file, &stream, *offset);
+    if (Codec_decodeSpan(codec, frame, &stream, &skipped) == Codec_Status_Done) {
+        begin = *offset + (uint64_t) skipped;
+        len = Codec_MmapIn_offset(file, &stream) - begin;
+        if (begin > CODEC_INDEX_MAX_OFFSET || len > CODEC_INDEX_MAX_LEN) {
+            return -1;
+        }
+        *entry = Codec_IndexEntry_new(begin, len);
+        *offset = begin + len;
+        return 1;
+    }
+    if (file->Offset + (uint64_t) file->Len >= file->Size) {
+        // window reached end of file, rest of bytes never complete
+        *offset = file->Size;
+    }
+    else if (skipped > 0) {
+        // noise dropped, incomplete frame candidate begin next window
+        *offset += (uint64_t) skipped;
+    }
+    else {
+        // frame candidate fill whole window, so it's not a valid frame
+        *offset += 1;
+    }
+    return 0;
+}
+/**
+ * @brief decode all frames of a mapped file with sync of codec and store position of each frame,
+ * noise between frames skipped, so later passes decode frame N with Codec_decodeIndex
+ * without scan file again, frame is overwritten by each decoded frame,
+ * decode view mode of codec avoid copy of payloads
+ *
+ * @param codec
+ * @param frame
+ * @param file mapped file
+ * @param index array of entries, NULL to only count frames
+ * @param size number of entries of index
+ * @return int64_t number of frames in file, can be bigger than size and extra entries not stored,
+ * -1 if a frame doesn't fit in an index entry
+ */
+int64_t Codec_indexFile(Codec* codec, Codec_Frame* frame, Codec_MmapFile* file, Codec_IndexEntry* index, uint64_t size) {
+    Codec_IndexEntry entry;
+    uint64_t offset = 0;
+    int64_t count = 0;
+    int8_t result;
+
+    while (offset < file->Size) {
+        if ((result = Codec_indexNext(codec, frame, file, &offset, &entry)) < 0) {
+            return -1;
+        }
+        else if (result > 0) {
+            if (index != NULL && (uint64_t) count < size) {
+                index[count] = entry;
+            }
+            count++;
+        }
+    }
+
+    return count;
+}
+/**
+ * @brief decode a frame of mapped file by its index entry
+ *
+ * @param codec
+ * @param frame
+ * @param file mapped file
+ * @param entry index entry of frame that returned by Codec_indexFile
+ * @return Codec_Status
+ */
+Codec_Status Codec_decodeIndex(Codec* codec, Codec_Frame* frame, Codec_MmapFile* file, Codec_IndexEntry entry) {
+    StreamIn stream;
+    uint64_t offset = Codec_IndexEntry_offset(entry);
+    Stream_LenType len = Codec_IndexEntry_len(entry);
+
+    if (offset + (uint64_t) len > file->Size || len == 0) {
+        return Codec_Status_Error;
+    }
+    IStream_init(&stream, NULL, (uint8_t*) file->Data + offset, len);
+    IStream_moveWritePos(&stream, len);
+    return Codec_decodeFrame(codec, frame, &stream);
+}
+
+#endif // CODEC_MMAP
@@ -0,0 +1,83 @@
+/**
+ * @file CodecMmap.h
+ * @author Ali Mirghasemi (ali.mirghasemi1376@gmail.com)
+ * @brief this library decode capture files through a read-only memory mapping,
+ * input stream is a window over the mapping that slide forward without copy,
+ * Codec_indexFile build a compact frame index, so a frame can decoded again in O(1)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _CODEC_MMAP_H_
+#define _CODEC_MMAP_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "Codec.h"
+
+#if CODEC_MMAP
+
+#include <stdint.h>
+
+/**
+ * @brief number of bits of file offset in an index entry, rest of bits hold frame length
+ */
+#define CODEC_INDEX_OFFSET_BITS         40
+/**
+ * @brief max length of a frame that can stored in an index entry
+ */
+#define CODEC_INDEX_MAX_LEN             ((1ULL << (64 - CODEC_INDEX_OFFSET_BITS)) - 1)
+/**
+ * @brief max file offset of a frame that can stored in an index entry
+ */
+#define CODEC_INDEX_MAX_OFFSET          ((1ULL << CODEC_INDEX_OFFSET_BITS) - 1)
+/**
+ * @brief index entry, file offset of frame in low bits and length of frame in high bits
+ */
+typedef uint64_t Codec_IndexEntry;
+
+#define Codec_IndexEntry_new(OFFSET, LEN)   ((uint64_t) (OFFSET) | ((uint64_t) (LEN) << CODEC_INDEX_OFFSET_BITS))
+#define Codec_IndexEntry_offset(ENTRY)      ((ENTRY) & CODEC_INDEX_MAX_OFFSET)
+#define Codec_IndexEntry_len(ENTRY)         ((Stream_LenType) ((ENTRY) >> CODEC_INDEX_OFFSET_BITS))
+
+/**
+ * @brief read-only mapping of a file and current stream window over it
+ */
+typedef struct {
+    const uint8_t*          Data;           /**< begin of mapping, NULL for empty file */
+    uint64_t                Size;           /**< size of file */
+    uint64_t                Offset;         /**< file offset of current window */
+    Stream_LenType          Window;         /**< max bytes of a window, must be bigger than biggest frame */
+    Stream_LenType          Len;            /**< bytes of current window */
+    uint64_t                Advised;        /**< end of range that asked kernel to read ahead */
+    int                     Fd;
+    uint8_t                 HugeAdvised;    /**< kernel accepted huge pages advice, not that huge pages are in use,
+                                                 file mappings need READ_ONLY_THP_FOR_FS and khugepaged for them */
+} Codec_MmapFile;
+
+int  Codec_MmapFile_open(Codec_MmapFile* file, const char* path, Stream_LenType window);
+void Codec_MmapFile_close(Codec_MmapFile* file);
+void Codec_MmapFile_random(Codec_MmapFile* file);
+
+void Codec_MmapIn_init(Codec_MmapFile* file, StreamIn* stream, uint64_t offset);
+uint8_t Codec_MmapIn_next(Codec_MmapFile* file, StreamIn* stream);
+/**
+ * @brief return file offset of read position of stream
+ */
+#define Codec_MmapIn_offset(FILE, STREAM)   ((FILE)->Offset + (uint64_t) ((FILE)->Len - IStream_available(STREAM)))
+
+int8_t  Codec_indexNext(Codec* codec, Codec_Frame* frame, Codec_MmapFile* file, uint64_t* offset, Codec_IndexEntry* entry);
+int64_t Codec_indexFile(Codec* codec, Codec_Frame* frame, Codec_MmapFile* file, Codec_IndexEntry* index, uint64_t size);
+Codec_Status Codec_decodeIndex(Codec* codec, Codec_Frame* frame, Codec_MmapFile* file, Codec_IndexEntry entry);
+
+#endif // CODEC_MMAP
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* _CODEC_MMAP_H_ */
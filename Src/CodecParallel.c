@@ -0,0 +1,194 @@
+#if !defined(_WIN32) && !defined(_DEFAULT_SOURCE)
+    #define _DEFAULT_SOURCE
+#endif
+
+#include "CodecParallel.h"
+
+#if CODEC_PARALLEL
+
+#include <string.h>
+#include <pthread.h>
+
+#ifndef NULL
+    #define NULL          ((void*) 0)
+#endif
+
+/**
+ * @brief a worker of parallel decode, decode frames that start in its chunk
+ */
+typedef struct {
+    Codec                   Codec;          /**< copy of codec without callbacks */
+    Codec_MmapFile          File;           /**< copy of mapping, so window is private */
+    Codec_Frame*            Frame;
+    Codec_IndexEntry*       Index;          /**< part of index that worker fill */
+    uint64_t                Size;           /**< number of entries of part */
+    uint64_t                Count;          /**< number of decoded frames */
+    uint64_t                Begin;          /**< first offset of chunk */
+    uint64_t                End;            /**< first offset after chunk */
+    uint64_t                Stop;           /**< offset that worker stopped at */
+    pthread_t               Thread;
+    int8_t                  Result;         /**< -1 if a frame doesn't fit in an index entry */
+    uint8_t                 Started;        /**< worker run in its own thread */
+} Codec_Worker;
+
+#define __entryEnd(E)                   (Codec_IndexEntry_offset(E) + (uint64_t) Codec_IndexEntry_len(E))
+
+/**
+ * @brief decode frames that decode position of them is in chunk of worker,
+ * last frame can end after chunk, worker stop early when its part of index is full
+ *
+ * @param args worker
+ * @return void*
+ */
+static void* Codec_Worker_run(void* args) {
+    Codec_Worker* worker = (Codec_Worker*) args;
+    Codec_IndexEntry entry;
+    uint64_t offset = worker->Begin;
+    int8_t result;
+
+    worker->Result = 0;
+    while (offset < worker->End && worker->Count < worker->Size) {
+        if ((result = Codec_indexNext(&worker->Codec, worker->Frame, &worker->File, &offset, &entry)) < 0) {
+            worker->Result = -1;
+            break;
+        }
+        else if (result > 0) {
+            worker->Index[worker->Count++] = entry;
+        }
+    }
+    worker->Stop = offset;
+    return NULL;
+}
+/**
+ * @brief index frames of a mapped file with many threads, result is exactly same as Codec_indexFile,
+ * file split into equal chunks and each worker decode from begin of its chunk with sync of codec,
+ * decode of Codec_indexNext only depend on offset, so when decode of previous chunk reach an offset
+ * that worker passed, rest of worker frames are valid, otherwise frames before that offset
+ * decoded again sequentially, callbacks of codec are not called
+ *
+ * @param codec decoder that workers copy it, codec itself not changed
+ * @param frames one frame per worker, all of them initialized same
+ * @param workers number of threads, up to CODEC_PARALLEL_MAX_WORKERS
+ * @param file mapped file
+ * @param index array of entries, each worker fill an equal part of it, so it need a margin
+ * when frames are not uniform over file, a chunk that has more frames than its part decoded sequentially
+ * @param size number of entries of index
+ * @return int64_t number of frames in file, can be bigger than size and extra entries not stored,
+ * -1 if a frame doesn't fit in an index entry
+ */
+int64_t Codec_decodeParallel(Codec* codec, Codec_Frame* frames[], uint32_t workers,
+                             Codec_MmapFile* file, Codec_IndexEntry* index, uint64_t size) {
+    Codec_Worker pool[CODEC_PARALLEL_MAX_WORKERS];
+    Codec_Worker* worker;
+    Codec_Worker* seq;
+    Codec_IndexEntry entry;
+    uint64_t offset = 0;
+    uint64_t count = 0;
+    uint64_t limit;
+    uint64_t first;
+    uint32_t i;
+    int8_t result;
+
+    if (workers > CODEC_PARALLEL_MAX_WORKERS) {
+        workers = CODEC_PARALLEL_MAX_WORKERS;
+    }
+    if (workers == 0 || index == NULL || size < workers || file->Size < workers) {
+        return Codec_indexFile(codec, frames[0], file, index, size);
+    }
+    for (i = 0; i < workers; i++) {
+        worker = &pool[i];
+        worker->Codec = *codec;
+    #if CODEC_DECODE_CALLBACK
+        worker->Codec.onDecode = NULL;
+    #endif
+    #if CODEC_DECODE_ERROR
+        worker->Codec.onDecodeError = NULL;
+    #endif
+        worker->File = *file;
+        worker->Frame = frames[i];
+        worker->Index = index + size * i / workers;
+        worker->Size = size * (i + 1) / workers - size * i / workers;
+        worker->Count = 0;
+        worker->Begin = file->Size * i / workers;
+        worker->End = file->Size * (i + 1) / workers;
+        worker->Started = i > 0 && pthread_create(&worker->Thread, NULL, Codec_Worker_run, worker) == 0;
+    }
+    // first chunk and workers that have no thread run in caller thread
+    for (i = 0; i < workers; i++) {
+        if (!pool[i].Started) {
+            Codec_Worker_run(&pool[i]);
+        }
+    }
+    for (i = 0; i < workers; i++) {
+        if (pool[i].Started) {
+            pthread_join(pool[i].Thread, NULL);
+        }
+        if (pool[i].Result < 0) {
+            return -1;
+        }
+    }
+
+    // reconcile chunks in order, offset is where sequential decode reached
+    seq = &pool[0];
+    for (i = 0; i < workers && offset < file->Size; i++) {
+        worker = &pool[i];
+        first = 0;
+        while (offset != worker->Begin) {
+            while (first < worker->Count && __entryEnd(worker->Index[first]) < offset) {
+                first++;
+            }
+            if (first < worker->Count && __entryEnd(worker->Index[first]) == offset) {
+                // sequential decode reached end of a worker frame
+                first++;
+                break;
+            }
+            if (offset >= worker->Stop) {
+                // worker frames passed, continue with next chunk
+                first = worker->Count;
+                break;
+            }
+            if ((result = Codec_indexNext(&seq->Codec, seq->Frame, &seq->File, &offset, &entry)) < 0) {
+                return -1;
+            }
+            else if (result > 0) {
+                // part of index before first worker frame that still needed is free
+                limit = (uint64_t) (worker->Index - index) + first;
+                if (count >= limit) {
+                    // next frame overwrite worker frames, decode rest of file sequentially
+                    if (count < size) {
+                        index[count] = entry;
+                    }
+                    count++;
+                    goto sequential;
+                }
+                index[count++] = entry;
+            }
+        }
+        if (first < worker->Count) {
+            memmove(&index[count], &worker->Index[first], (size_t) (worker->Count - first) * sizeof(Codec_IndexEntry));
+            count += worker->Count - first;
+            offset = worker->Stop;
+        }
+        else if (offset == worker->Begin || offset < worker->Stop) {
+            offset = worker->Stop;
+        }
+    }
+
+sequential:
+    // rest of file that workers couldn't index
+    while (offset < file->Size) {
+        if ((result = Codec_indexNext(&seq->Codec, seq->Frame, &seq->File, &offset, &entry)) < 0) {
+            return -1;
+        }
+        else if (result > 0) {
+            if (count < size) {
+                index[count] = entry;
+            }
+            count++;
+        }
+    }
+
+    return (int64_t) count;
+}
+
+#endif // CODEC_PARALLEL
@@ -0,0 +1,33 @@
+/**
+ * @file CodecParallel.h
+ * @author Ali Mirghasemi (ali.mirghasemi1376@gmail.com)
+ * @brief this library decode a mapped capture file with many threads, file split into chunks,
+ * each worker index frames of a chunk from its first sync point and chunk edges reconciled,
+ * so result is exactly same as Codec_indexFile
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _CODEC_PARALLEL_H_
+#define _CODEC_PARALLEL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "CodecMmap.h"
+
+#if CODEC_PARALLEL
+
+int64_t Codec_decodeParallel(Codec* codec, Codec_Frame* frames[], uint32_t workers,
+                             Codec_MmapFile* file, Codec_IndexEntry* index, uint64_t size);
+
+#endif // CODEC_PARALLEL
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* _CODEC_PARALLEL_H_ */
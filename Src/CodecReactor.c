@@ -0,0 +1,359 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+    #define _POSIX_C_SOURCE             200112L
+#endif
+
+#include "CodecReactor.h"
+
+#if CODEC_REACTOR && CODEC_DECODE && CODEC_DECODE_ASYNC && CODEC_ENCODE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+
+static void Codec_Reactor_arm(Codec_Reactor* reactor, Codec_Connection* conn, uint32_t events);
+static void Codec_Reactor_close(Codec_Reactor* reactor, Codec_Connection* conn);
+static void Codec_Reactor_serve(Codec_Reactor* reactor, Codec_Connection* conn);
+static void Codec_Reactor_transmit(Codec_Reactor* reactor, Codec_Connection* conn);
+static void Codec_Reactor_transmitDirty(Codec_Reactor* reactor);
+
+/**
+ * @brief remove connection from a list of reactor
+ *
+ * @param head head of list
+ * @param conn
+ * @param ready 1 for ready lists, 0 for dirty list
+ */
+static void Codec_Reactor_unlink(Codec_Connection** head, Codec_Connection* conn, uint8_t ready) {
+    while (*head != NULL) {
+        if (*head == conn) {
+            *head = ready ? conn->NextReady : conn->NextDirty;
+            return;
+        }
+        head = ready ? &(*head)->NextReady : &(*head)->NextDirty;
+    }
+}
+/**
+ * @brief initialize reactor and create epoll instance
+ *
+ * @param reactor
+ * @return int 0 on success, -1 if epoll can't be created
+ */
+int Codec_Reactor_init(Codec_Reactor* reactor) {
+    reactor->ReadyHead = NULL;
+    reactor->ServeHead = NULL;
+    reactor->DirtyHead = NULL;
+    reactor->onClose = NULL;
+    reactor->Connections = 0;
+    reactor->ByteBudget = CODEC_REACTOR_BYTE_BUDGET;
+    reactor->FrameBudget = CODEC_REACTOR_FRAME_BUDGET;
+    reactor->Running = 0;
+    reactor->Fd = epoll_create1(EPOLL_CLOEXEC);
+    return reactor->Fd < 0 ? -1 : 0;
+}
+/**
+ * @brief close epoll instance, connections are not closed
+ *
+ * @param reactor
+ */
+void Codec_Reactor_deinit(Codec_Reactor* reactor) {
+    if (reactor->Fd >= 0) {
+        close(reactor->Fd);
+        reactor->Fd = -1;
+    }
+}
+/**
+ * @brief set decode budget of each connection in a run iteration, connection that
+ * finish its budget served again in next iteration, so a busy connection can't starve others
+ *
+ * @param reactor
+ * @param bytes max decoded bytes
+ * @param frames max Codec_decode calls
+ */
+void Codec_Reactor_setBudget(Codec_Reactor* reactor, Stream_LenType bytes, uint16_t frames) {
+    reactor->ByteBudget = bytes;
+    reactor->FrameBudget = frames;
+}
+/**
+ * @brief set close callback
+ *
+ * @param reactor
+ * @param fn
+ */
+void Codec_Reactor_onClose(Codec_Reactor* reactor, Codec_Reactor_CloseFn fn) {
+    reactor->onClose = fn;
+}
+/**
+ * @brief initialize connection, streams bound to fd, decoder must begin decode before
+ * connection added into reactor
+ *
+ * @param conn
+ * @param fd
+ * @param decoder codec that decode bytes of connection
+ * @param rxBuff buffer of input stream
+ * @param rxSize
+ * @param txBuff buffer of output stream
+ * @param txSize
+ */
+void Codec_Connection_init(Codec_Connection* conn, int fd, Codec* decoder,
+                           uint8_t* rxBuff, Stream_LenType rxSize, uint8_t* txBuff, Stream_LenType txSize) {
+    Codec_FdIn_init(&conn->In, fd, rxBuff, rxSize);
+    Codec_FdOut_init(&conn->Out, fd, txBuff, txSize);
+    conn->Decoder = decoder;
+    conn->Reactor = NULL;
+    conn->NextReady = NULL;
+    conn->NextDirty = NULL;
+    conn->Args = NULL;
+    conn->Fd = fd;
+    conn->Events = 0;
+    conn->Readable = 0;
+    conn->Ready = 0;
+    conn->Dirty = 0;
+}
+/**
+ * @brief add connection into reactor, fd switched to non-blocking mode
+ *
+ * @param reactor
+ * @param conn
+ * @return int 0 on success, -1 on error
+ */
+int Codec_Reactor_add(Codec_Reactor* reactor, Codec_Connection* conn) {
+    struct epoll_event ev;
+    int flags = fcntl(conn->Fd, F_GETFL, 0);
+
+    if (flags < 0 || fcntl(conn->Fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+        return -1;
+    }
+    ev.events = EPOLLIN;
+    ev.data.ptr = conn;
+    if (epoll_ctl(reactor->Fd, EPOLL_CTL_ADD, conn->Fd, &ev) < 0) {
+        return -1;
+    }
+    conn->Reactor = reactor;
+    conn->Events = EPOLLIN;
+    reactor->Connections++;
+    if (OStream_pendingBytes(&conn->Out) > 0) {
+        // frames encoded before add
+        Codec_Reactor_send(conn);
+    }
+    return 0;
+}
+/**
+ * @brief remove connection from reactor, pending output is dropped and fd is not closed
+ *
+ * @param reactor
+ * @param conn
+ */
+void Codec_Reactor_remove(Codec_Reactor* reactor, Codec_Connection* conn) {
+    if (conn->Reactor != reactor) {
+        return;
+    }
+    epoll_ctl(reactor->Fd, EPOLL_CTL_DEL, conn->Fd, NULL);
+    if (conn->Ready) {
+        Codec_Reactor_unlink(&reactor->ReadyHead, conn, 1);
+        Codec_Reactor_unlink(&reactor->ServeHead, conn, 1);
+        conn->Ready = 0;
+    }
+    if (conn->Dirty) {
+        Codec_Reactor_unlink(&reactor->DirtyHead, conn, 0);
+        conn->Dirty = 0;
+    }
+    conn->Reactor = NULL;
+    reactor->Connections--;
+}
+/**
+ * @brief ask reactor to transmit output of connection at end of iteration,
+ * call it after encode frames into output stream of connection
+ *
+ * @param conn
+ */
+void Codec_Reactor_send(Codec_Connection* conn) {
+    Codec_Reactor* reactor = conn->Reactor;
+    if (reactor != NULL && !conn->Dirty) {
+        conn->Dirty = 1;
+        conn->NextDirty = reactor->DirtyHead;
+        reactor->DirtyHead = conn;
+    }
+}
+/**
+ * @brief wait for events and serve connections once, connections that have bytes
+ * left from previous iteration don't wait
+ *
+ * @param reactor
+ * @param timeout in milliseconds, -1 wait forever
+ * @return int number of events, -1 on error
+ */
+int Codec_Reactor_runOnce(Codec_Reactor* reactor, int timeout) {
+    struct epoll_event events[CODEC_REACTOR_EVENTS];
+    Codec_Connection* conn;
+    int n;
+    int i;
+
+    // transmit bytes that written before run
+    Codec_Reactor_transmitDirty(reactor);
+    if (reactor->ReadyHead != NULL) {
+        timeout = 0;
+    }
+    n = epoll_wait(reactor->Fd, events, CODEC_REACTOR_EVENTS, timeout);
+    if (n < 0) {
+        return errno == EINTR ? 0 : -1;
+    }
+    for (i = 0; i < n; i++) {
+        conn = (Codec_Connection*) events[i].data.ptr;
+        if (conn->Reactor != reactor) {
+            // removed in this iteration
+            continue;
+        }
+        if ((events[i].events & EPOLLOUT) != 0) {
+            Codec_Reactor_transmit(reactor, conn);
+        }
+        if ((events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0 && conn->Reactor == reactor) {
+            conn->Readable = 1;
+            if (!conn->Ready) {
+                conn->Ready = 1;
+                conn->NextReady = reactor->ReadyHead;
+                reactor->ReadyHead = conn;
+            }
+        }
+    }
+    // serve ready connections, connections that finish their budget added into new list
+    reactor->ServeHead = reactor->ReadyHead;
+    reactor->ReadyHead = NULL;
+    while ((conn = reactor->ServeHead) != NULL) {
+        reactor->ServeHead = conn->NextReady;
+        conn->Ready = 0;
+        Codec_Reactor_serve(reactor, conn);
+    }
+    Codec_Reactor_transmitDirty(reactor);
+
+    return n;
+}
+/**
+ * @brief run until stop called or all connections removed
+ *
+ * @param reactor
+ */
+void Codec_Reactor_run(Codec_Reactor* reactor) {
+    reactor->Running = 1;
+    while (reactor->Running && reactor->Connections > 0) {
+        if (Codec_Reactor_runOnce(reactor, -1) < 0) {
+            break;
+        }
+    }
+    reactor->Running = 0;
+}
+/**
+ * @brief stop run loop after current iteration
+ *
+ * @param reactor
+ */
+void Codec_Reactor_stop(Codec_Reactor* reactor) {
+    reactor->Running = 0;
+}
+
+static void Codec_Reactor_arm(Codec_Reactor* reactor, Codec_Connection* conn, uint32_t events) {
+    struct epoll_event ev;
+    if (conn->Events != events) {
+        ev.events = events;
+        ev.data.ptr = conn;
+        epoll_ctl(reactor->Fd, EPOLL_CTL_MOD, conn->Fd, &ev);
+        conn->Events = events;
+    }
+}
+static void Codec_Reactor_close(Codec_Reactor* reactor, Codec_Connection* conn) {
+    Codec_Reactor_remove(reactor, conn);
+    if (reactor->onClose) {
+        reactor->onClose(reactor, conn);
+    }
+}
+/**
+ * @brief read fd of connection and decode until budget finished or fd has no more bytes,
+ * close connection when rx buffer is full and decoder can not consume it
+ */
+static void Codec_Reactor_serve(Codec_Reactor* reactor, Codec_Connection* conn) {
+    StreamIn* stream = &conn->In;
+    Stream_LenType bytes = 0;
+    Stream_LenType available;
+    Stream_LenType consumed;
+    uint16_t frames = 0;
+    ssize_t len = 0;
+    uint8_t closed = 0;
+    uint8_t stalled;
+
+    do {
+        if (conn->Readable) {
+            len = Codec_FdIn_read(stream);
+            if (len < 0) {
+                // decode rest of bytes then close
+                conn->Readable = 0;
+                closed = 1;
+            }
+            else if (len == 0 && IStream_space(stream) > 0) {
+                conn->Readable = 0;
+            }
+        }
+        consumed = 0;
+        stalled = 0;
+        while (frames < reactor->FrameBudget && bytes < reactor->ByteBudget &&
+               (available = IStream_available(stream)) > 0) {
+            Codec_decode(conn->Decoder, stream);
+            frames++;
+            if (IStream_available(stream) == available) {
+                // wait for rest of frame
+                stalled = 1;
+                break;
+            }
+            consumed += available - IStream_available(stream);
+            bytes += available - IStream_available(stream);
+            if (conn->Reactor != reactor) {
+                // removed by a callback of decoder
+                return;
+            }
+        }
+        if (stalled && IStream_space(stream) == 0) {
+            // decoder need more bytes than rx buffer fit, fd stay readable forever, so close it
+            conn->Readable = 0;
+            closed = 1;
+        }
+    } while (conn->Readable && (len > 0 || consumed > 0) &&
+             frames < reactor->FrameBudget && bytes < reactor->ByteBudget);
+
+    if (closed) {
+        Codec_Reactor_close(reactor, conn);
+        return;
+    }
+    if ((frames >= reactor->FrameBudget || bytes >= reactor->ByteBudget) && !conn->Ready &&
+        (conn->Readable || IStream_available(stream) > 0)) {
+        // budget finished, continue in next iteration
+        conn->Ready = 1;
+        conn->NextReady = reactor->ReadyHead;
+        reactor->ReadyHead = conn;
+    }
+    if (OStream_pendingBytes(&conn->Out) > 0) {
+        Codec_Reactor_send(conn);
+    }
+}
+/**
+ * @brief write output of connection and arm EPOLLOUT while bytes are pending
+ */
+static void Codec_Reactor_transmit(Codec_Reactor* reactor, Codec_Connection* conn) {
+    if (Codec_FdOut_flush(&conn->Out) < 0) {
+        Codec_Reactor_close(reactor, conn);
+        return;
+    }
+    Codec_Reactor_arm(reactor, conn, OStream_pendingBytes(&conn->Out) > 0 ?
+                      (conn->Events | EPOLLOUT) : (conn->Events & ~EPOLLOUT));
+}
+static void Codec_Reactor_transmitDirty(Codec_Reactor* reactor) {
+    Codec_Connection* conn;
+    while ((conn = reactor->DirtyHead) != NULL) {
+        reactor->DirtyHead = conn->NextDirty;
+        conn->Dirty = 0;
+        if ((conn->Events & EPOLLOUT) == 0) {
+            // EPOLLOUT armed connections wait for fd
+            Codec_Reactor_transmit(reactor, conn);
+        }
+    }
+}
+
+#endif // CODEC_REACTOR
@@ -0,0 +1,116 @@
+/**
+ * @file CodecReactor.h
+ * @author Ali Mirghasemi (ali.mirghasemi1376@gmail.com)
+ * @brief reference epoll reactor on Linux, drive many connections from a single thread,
+ * each connection has fd streams and a codec that decode with a per-iteration budget
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _CODEC_REACTOR_H_
+#define _CODEC_REACTOR_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "Codec.h"
+
+#if CODEC_REACTOR && CODEC_DECODE && CODEC_DECODE_ASYNC && CODEC_ENCODE
+
+#include "CodecFd.h"
+
+/**
+ * @brief max number of epoll events that handled in a run iteration
+ */
+#ifndef CODEC_REACTOR_EVENTS
+    #define CODEC_REACTOR_EVENTS            256
+#endif
+/**
+ * @brief default max bytes that a connection decode in a run iteration
+ */
+#ifndef CODEC_REACTOR_BYTE_BUDGET
+    #define CODEC_REACTOR_BYTE_BUDGET       16384
+#endif
+/**
+ * @brief default max Codec_decode calls of a connection in a run iteration,
+ * each call decode at most one frame when decode all is disabled
+ */
+#ifndef CODEC_REACTOR_FRAME_BUDGET
+    #define CODEC_REACTOR_FRAME_BUDGET      64
+#endif
+
+struct __Codec_Reactor;
+typedef struct __Codec_Reactor Codec_Reactor;
+struct __Codec_Connection;
+typedef struct __Codec_Connection Codec_Connection;
+
+/**
+ * @brief called when peer closed connection or fd failed, connection is removed from reactor
+ * before callback, fd is not closed by reactor
+ */
+typedef void (*Codec_Reactor_CloseFn)(Codec_Reactor* reactor, Codec_Connection* conn);
+
+/**
+ * @brief connection of reactor, bytes of In decoded by Decoder, frames that written into Out
+ * transmitted by reactor, memory of connection must stay valid until it removed and
+ * current run iteration returned
+ */
+struct __Codec_Connection {
+    StreamIn                In;
+    StreamOut               Out;
+    Codec*                  Decoder;
+    Codec_Reactor*          Reactor;        /**< NULL if connection is not in a reactor */
+    Codec_Connection*       NextReady;
+    Codec_Connection*       NextDirty;
+    void*                   Args;
+    int                     Fd;
+    uint32_t                Events;         /**< armed epoll events */
+    uint8_t                 Readable;       /**< fd may have bytes */
+    uint8_t                 Ready;          /**< in ready list, serve without wait for event */
+    uint8_t                 Dirty;          /**< in dirty list, output flushed at end of iteration */
+};
+
+/**
+ * @brief epoll reactor
+ */
+struct __Codec_Reactor {
+    Codec_Connection*       ReadyHead;      /**< connections that have bytes to decode */
+    Codec_Connection*       ServeHead;      /**< ready connections of current iteration */
+    Codec_Connection*       DirtyHead;      /**< connections that have bytes to transmit */
+    Codec_Reactor_CloseFn   onClose;
+    uint32_t                Connections;
+    Stream_LenType          ByteBudget;
+    uint16_t                FrameBudget;
+    uint8_t                 Running;
+    int                     Fd;
+};
+
+int  Codec_Reactor_init(Codec_Reactor* reactor);
+void Codec_Reactor_deinit(Codec_Reactor* reactor);
+void Codec_Reactor_setBudget(Codec_Reactor* reactor, Stream_LenType bytes, uint16_t frames);
+void Codec_Reactor_onClose(Codec_Reactor* reactor, Codec_Reactor_CloseFn fn);
+
+void Codec_Connection_init(Codec_Connection* conn, int fd, Codec* decoder,
+                           uint8_t* rxBuff, Stream_LenType rxSize, uint8_t* txBuff, Stream_LenType txSize);
+#define Codec_Connection_setArgs(CONN, ARGS)        ((CONN)->Args = (ARGS))
+#define Codec_Connection_getArgs(CONN)              ((CONN)->Args)
+
+int  Codec_Reactor_add(Codec_Reactor* reactor, Codec_Connection* conn);
+void Codec_Reactor_remove(Codec_Reactor* reactor, Codec_Connection* conn);
+void Codec_Reactor_send(Codec_Connection* conn);
+int  Codec_Reactor_runOnce(Codec_Reactor* reactor, int timeout);
+void Codec_Reactor_run(Codec_Reactor* reactor);
+void Codec_Reactor_stop(Codec_Reactor* reactor);
+
+#define Codec_Reactor_connections(REACTOR)          ((REACTOR)->Connections)
+
+#endif // CODEC_REACTOR
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* _CODEC_REACTOR_H_ */
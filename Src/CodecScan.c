@@ -0,0 +1,278 @@
+#include "CodecScan.h"
+#include <string.h>
+
+#if CODEC_DECODE
+
+#if CODEC_SCAN_SIMD
+    #if (defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))) || defined(_M_X64)
+        #include <immintrin.h>
+        #define CODEC_SCAN_AVX2         1
+    #endif
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #include <emmintrin.h>
+        #define CODEC_SCAN_SSE2         1
+    #endif
+    #if defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #include <arm_neon.h>
+        #define CODEC_SCAN_NEON         1
+    #endif
+#endif // CODEC_SCAN_SIMD
+
+#ifndef CODEC_SCAN_AVX2
+    #define CODEC_SCAN_AVX2             0
+#endif
+#ifndef CODEC_SCAN_SSE2
+    #define CODEC_SCAN_SSE2             0
+#endif
+#ifndef CODEC_SCAN_NEON
+    #define CODEC_SCAN_NEON             0
+#endif
+
+#if CODEC_SCAN_AVX2
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+        #define __scanTarget
+    #else
+        #define __scanTarget            __attribute__((target("avx2")))
+    #endif
+
+static uint8_t          __scanAvx2;
+static volatile uint8_t __scanReady;
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define __ctz(X)                    __builtin_ctz(X)
+    #define __ctz64(X)                  __builtin_ctzll(X)
+#elif defined(_MSC_VER)
+    #include <intrin.h>
+    static unsigned __ctz(uint32_t x) { unsigned long index; _BitScanForward(&index, x); return index; }
+    static unsigned __ctz64(uint64_t x) { unsigned long index; _BitScanForward64(&index, x); return index; }
+#else
+    static unsigned __ctz(uint32_t x) { unsigned n = 0; while (!(x & 1)) { x >>= 1; n++; } return n; }
+    static unsigned __ctz64(uint64_t x) { unsigned n = 0; while (!(x & 1)) { x >>= 1; n++; } return n; }
+#endif
+
+/**
+ * @brief check middle bytes of candidate, first and last bytes already matched
+ */
+#define __matchMiddle(P, PAT, LEN)      ((LEN) <= 2 || memcmp((P) + 1, (PAT) + 1, (LEN) - 2) == 0)
+
+#if CODEC_SCAN_AVX2
+/**
+ * @brief scan 32 bytes blocks of buffer with avx2, it compiled for avx2 only,
+ * so it must be called when cpu support it
+ *
+ * @param buff
+ * @param index offset to begin scan, return offset of first byte that not scanned
+ * @param last last offset that pattern can begin
+ * @param pattern
+ * @param patternLen
+ * @return Stream_LenType offset of pattern in buffer, -1 if not found
+ */
+__scanTarget
+static Stream_LenType Codec_scanAvx2(const uint8_t* buff, Stream_LenType* index, Stream_LenType last,
+                                     const uint8_t* pattern, Stream_LenType patternLen) {
+    const __m256i vFirst = _mm256_set1_epi8((char) pattern[0]);
+    const __m256i vEnd = _mm256_set1_epi8((char) pattern[patternLen - 1]);
+    Stream_LenType i = *index;
+
+    for (; i + 32 <= last + 1; i += 32) {
+        __m256i a = _mm256_loadu_si256((const __m256i*) (buff + i));
+        __m256i b = _mm256_loadu_si256((const __m256i*) (buff + i + patternLen - 1));
+        uint32_t mask = (uint32_t) _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, vFirst), _mm256_cmpeq_epi8(b, vEnd)));
+        while (mask) {
+            Stream_LenType pos = i + (Stream_LenType) __ctz(mask);
+            if (__matchMiddle(buff + pos, pattern, patternLen)) {
+                return pos;
+            }
+            mask &= mask - 1;
+        }
+    }
+    *index = i;
+    return -1;
+}
+#endif // CODEC_SCAN_AVX2
+/**
+ * @brief detect vector instructions of cpu, it called on first scan automatically,
+ * call it once before threads use scanner
+ */
+void Codec_scanInit(void) {
+#if CODEC_SCAN_AVX2
+    #if defined(_MSC_VER) && !defined(__clang__)
+    {
+        int info[4];
+        __cpuid(info, 0);
+        __scanAvx2 = 0;
+        if (info[0] >= 7) {
+            __cpuid(info, 1);
+            // cpu support avx and os save ymm registers
+            if ((info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 0x6) == 0x6) {
+                __cpuidex(info, 7, 0);
+                __scanAvx2 = (info[1] & (1 << 5)) != 0;
+            }
+        }
+    }
+    #else
+    __builtin_cpu_init();
+    __scanAvx2 = __builtin_cpu_supports("avx2") != 0;
+    #endif
+    __scanReady = 1;
+#endif
+}
+/**
+ * @brief find first occurrence of pattern in buffer,
+ * candidates are filtered by first and last bytes of pattern then middle bytes compared
+ *
+ * @param buff buffer to scan
+ * @param len length of buffer
+ * @param pattern pattern bytes
+ * @param patternLen length of pattern, 1 to CODEC_SCAN_PATTERN_MAX
+ * @return Stream_LenType offset of pattern in buffer, -1 if not found
+ */
+Stream_LenType Codec_scanBuffer(const uint8_t* buff, Stream_LenType len, const uint8_t* pattern, Stream_LenType patternLen) {
+    Stream_LenType index = 0;
+    Stream_LenType last;
+    uint8_t first;
+    uint8_t end;
+
+    if (patternLen <= 0 || len < patternLen) {
+        return -1;
+    }
+    last = len - patternLen;
+    first = pattern[0];
+    end = pattern[patternLen - 1];
+
+#if CODEC_SCAN_AVX2
+    if (!__scanReady) {
+        Codec_scanInit();
+    }
+    if (__scanAvx2) {
+        Stream_LenType pos = Codec_scanAvx2(buff, &index, last, pattern, patternLen);
+        if (pos >= 0) {
+            return pos;
+        }
+    }
+#endif // CODEC_SCAN_AVX2
+#if CODEC_SCAN_SSE2
+    {
+        const __m128i vFirst = _mm_set1_epi8((char) first);
+        const __m128i vEnd = _mm_set1_epi8((char) end);
+        for (; index + 16 <= last + 1; index += 16) {
+            __m128i a = _mm_loadu_si128((const __m128i*) (buff + index));
+            __m128i b = _mm_loadu_si128((const __m128i*) (buff + index + patternLen - 1));
+            uint32_t mask = (uint32_t) _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, vFirst), _mm_cmpeq_epi8(b, vEnd)));
+            while (mask) {
+                Stream_LenType pos = index + (Stream_LenType) __ctz(mask);
+                if (__matchMiddle(buff + pos, pattern, patternLen)) {
+                    return pos;
+                }
+                mask &= mask - 1;
+            }
+        }
+    }
+#endif // CODEC_SCAN_SSE2
+#if CODEC_SCAN_NEON
+    {
+        const uint8x16_t vFirst = vdupq_n_u8(first);
+        const uint8x16_t vEnd = vdupq_n_u8(end);
+        for (; index + 16 <= last + 1; index += 16) {
+            uint8x16_t a = vld1q_u8(buff + index);
+            uint8x16_t b = vld1q_u8(buff + index + patternLen - 1);
+            uint8x16_t eq = vandq_u8(vceqq_u8(a, vFirst), vceqq_u8(b, vEnd));
+            // narrow each byte to a nibble, so bit position / 4 is byte index
+            uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+            while (mask) {
+                unsigned bit = __ctz64(mask);
+                Stream_LenType pos = index + (Stream_LenType) (bit >> 2);
+                if (__matchMiddle(buff + pos, pattern, patternLen)) {
+                    return pos;
+                }
+                mask &= ~((uint64_t) 0xF << (bit & ~3U));
+            }
+        }
+    }
+#endif // CODEC_SCAN_NEON
+    // scalar fallback and tail
+    while (index <= last) {
+        const uint8_t* p = (const uint8_t*) memchr(buff + index, first, (size_t) (last - index + 1));
+        if (p == NULL) {
+            break;
+        }
+        index = (Stream_LenType) (p - buff);
+        if (p[patternLen - 1] == end && __matchMiddle(p, pattern, patternLen)) {
+            return index;
+        }
+        index++;
+    }
+
+    return -1;
+}
+/**
+ * @brief find first occurrence of pattern in available bytes of stream,
+ * it handle ring-buffer wrap, can be used directly in Codec_SyncFn
+ *
+ * @param stream input stream, read position not changed
+ * @param pattern pattern bytes
+ * @param patternLen length of pattern, 1 to CODEC_SCAN_PATTERN_MAX
+ * @return Stream_LenType offset of pattern from read position, -1 if not found
+ */
+Stream_LenType Codec_scanStream(StreamIn* stream, const uint8_t* pattern, Stream_LenType patternLen) {
+    uint8_t temp[(CODEC_SCAN_PATTERN_MAX - 1) * 2];
+    Stream_LenType available = IStream_available(stream);
+    Stream_LenType headLen = Stream_directAvailable(&stream->Buffer);
+    Stream_LenType tailLen = available - headLen;
+    Stream_LenType cross;
+    Stream_LenType index;
+
+    if (patternLen <= 0 || patternLen > CODEC_SCAN_PATTERN_MAX) {
+        return -1;
+    }
+    // first segment, from read position to end of buffer or write position
+    if ((index = Codec_scanBuffer(Stream_getReadPtr(&stream->Buffer), headLen, pattern, patternLen)) >= 0) {
+        return index;
+    }
+    if (tailLen <= 0) {
+        return -1;
+    }
+    // pattern may cross the end of ring buffer
+    cross = patternLen - 1;
+    if (cross > 0) {
+        Stream_LenType headPart = headLen < cross ? headLen : cross;
+        Stream_LenType tailPart = tailLen < cross ? tailLen : cross;
+        memcpy(temp, Stream_getReadPtr(&stream->Buffer) + headLen - headPart, (size_t) headPart);
+        memcpy(temp + headPart, Stream_getDataPtr(&stream->Buffer), (size_t) tailPart);
+        if ((index = Codec_scanBuffer(temp, headPart + tailPart, pattern, patternLen)) >= 0) {
+            return headLen - headPart + index;
+        }
+    }
+    // second segment, from start of buffer to write position
+    if ((index = Codec_scanBuffer(Stream_getDataPtr(&stream->Buffer), tailLen, pattern, patternLen)) >= 0) {
+        return headLen + index;
+    }
+
+    return -1;
+}
+/**
+ * @brief return name of scanner implementation that used on this cpu
+ *
+ * @return const char*
+ */
+const char* Codec_scanImpl(void) {
+#if CODEC_SCAN_AVX2
+    if (!__scanReady) {
+        Codec_scanInit();
+    }
+    if (__scanAvx2) {
+        return "avx2";
+    }
+#endif
+#if CODEC_SCAN_SSE2
+    return "sse2";
+#elif CODEC_SCAN_NEON
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+#endif // CODEC_DECODE
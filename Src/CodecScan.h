@@ -0,0 +1,40 @@
+/**
+ * @file CodecScan.h
+ * @author Ali Mirghasemi (ali.mirghasemi1376@gmail.com)
+ * @brief this library implement fast multi-byte pattern scanner for sync functions,
+ * it use SSE2 on x86-64, AVX2 when cpu support it at runtime and NEON on ARM, otherwise scalar
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _CODEC_SCAN_H_
+#define _CODEC_SCAN_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "Codec.h"
+
+#if CODEC_DECODE
+
+/**
+ * @brief maximum pattern length that scanner support
+ */
+#define CODEC_SCAN_PATTERN_MAX          8
+
+void Codec_scanInit(void);
+Stream_LenType Codec_scanBuffer(const uint8_t* buff, Stream_LenType len, const uint8_t* pattern, Stream_LenType patternLen);
+Stream_LenType Codec_scanStream(StreamIn* stream, const uint8_t* pattern, Stream_LenType patternLen);
+
+const char* Codec_scanImpl(void);
+
+#endif // CODEC_DECODE
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* _CODEC_SCAN_H_ */
@@ -0,0 +1,93 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+    #define _POSIX_C_SOURCE             200112L
+#endif
+
+#include "CodecSink.h"
+
+#if CODEC_ENCODE && CODEC_ENCODE_GATHER && CODEC_ENCODE_GATHER_POSIX
+
+#include <errno.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <sys/socket.h>
+
+/**
+ * @brief send vectors of gather to file descriptor, sent bytes consumed from gather
+ * so on partial write caller can call it again to send rest of bytes
+ *
+ * @param gather
+ * @param fd
+ * @param flags flags of sendmsg
+ * @param msg use sendmsg instead of writev
+ * @return ssize_t number of sent bytes, -1 on error
+ */
+static ssize_t Codec_Gather_send(Codec_Gather* gather, int fd, int flags, uint8_t msg) {
+    struct iovec iov[CODEC_SINK_IOV_MAX];
+    struct msghdr hdr;
+    Codec_IoVec* vec;
+    ssize_t total = 0;
+    ssize_t len;
+    int count;
+    int i;
+
+    while (Codec_Gather_count(gather) > 0) {
+        vec = Codec_Gather_vec(gather);
+        count = Codec_Gather_count(gather);
+        if (count > CODEC_SINK_IOV_MAX) {
+            count = CODEC_SINK_IOV_MAX;
+        }
+        for (i = 0; i < count; i++) {
+            iov[i].iov_base = (void*) vec[i].Data;
+            iov[i].iov_len = (size_t) vec[i].Len;
+        }
+        if (msg) {
+            memset(&hdr, 0, sizeof(hdr));
+            hdr.msg_iov = iov;
+            hdr.msg_iovlen = count;
+            len = sendmsg(fd, &hdr, flags);
+        }
+        else {
+            len = writev(fd, iov, count);
+        }
+        if (len < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                // try again when fd is writable
+                break;
+            }
+            return -1;
+        }
+        Codec_Gather_consume(gather, (Stream_LenType) len);
+        total += len;
+        if (len == 0) {
+            break;
+        }
+    }
+
+    return total;
+}
+/**
+ * @brief write vectors of gather into file descriptor with writev
+ *
+ * @param gather
+ * @param fd
+ * @return ssize_t number of written bytes, -1 on error
+ */
+ssize_t Codec_Gather_writev(Codec_Gather* gather, int fd) {
+    return Codec_Gather_send(gather, fd, 0, 0);
+}
+/**
+ * @brief send vectors of gather into socket with sendmsg
+ *
+ * @param gather
+ * @param fd socket
+ * @param flags flags of sendmsg, ex: MSG_NOSIGNAL
+ * @return ssize_t number of sent bytes, -1 on error
+ */
+ssize_t Codec_Gather_sendmsg(Codec_Gather* gather, int fd, int flags) {
+    return Codec_Gather_send(gather, fd, flags, 1);
+}
+
+#endif // CODEC_ENCODE_GATHER_POSIX
@@ -0,0 +1,41 @@
+/**
+ * @file CodecSink.h
+ * @author Ali Mirghasemi (ali.mirghasemi1376@gmail.com)
+ * @brief this library implement posix sinks for scatter-gather encode,
+ * vectors of gather sent with a single writev/sendmsg system call
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _CODEC_SINK_H_
+#define _CODEC_SINK_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "Codec.h"
+
+#if CODEC_ENCODE && CODEC_ENCODE_GATHER && CODEC_ENCODE_GATHER_POSIX
+
+#include <sys/types.h>
+
+/**
+ * @brief maximum number of vectors that pass to a single system call
+ */
+#ifndef CODEC_SINK_IOV_MAX
+    #define CODEC_SINK_IOV_MAX          64
+#endif
+
+ssize_t Codec_Gather_writev(Codec_Gather* gather, int fd);
+ssize_t Codec_Gather_sendmsg(Codec_Gather* gather, int fd, int flags);
+
+#endif // CODEC_ENCODE_GATHER_POSIX
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* _CODEC_SINK_H_ */
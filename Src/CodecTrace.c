@@ -0,0 +1,189 @@
+#include "CodecTrace.h"
+
+#if CODEC_TRACE
+
+#include <stdio.h>
+
+#ifndef NULL
+    #define NULL          ((void*) 0)
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define __traceLoad(P)                      __atomic_load_n((P), __ATOMIC_ACQUIRE)
+    #define __traceStore(P, V)                  __atomic_store_n((P), (V), __ATOMIC_RELEASE)
+#else
+    #define __traceLoad(P)                      (*(P))
+    #define __traceStore(P, V)                  (*(P) = (V))
+#endif
+
+#define __traceIndex(I)                     ((I) & (CODEC_TRACE_SIZE - 1))
+
+#if (CODEC_TRACE_SIZE & (CODEC_TRACE_SIZE - 1)) != 0
+    #error "CODEC_TRACE_SIZE must be power of two"
+#endif
+
+static CODEC_TRACE_THREAD_LOCAL Codec_TraceRing* traceRing = NULL;
+static Codec_TraceClockFn traceClock = NULL;
+
+static const char* const TRACE_PHASES[] = {
+    "encode",
+    "decode",
+};
+
+/**
+ * @brief initialize trace ring
+ *
+ * @param ring
+ * @param id thread id that shown in trace
+ */
+void Codec_Trace_initRing(Codec_TraceRing* ring, uint32_t id) {
+    ring->Head = 0;
+    ring->Id = id;
+}
+/**
+ * @brief set trace ring of current thread, pass NULL to stop tracing in current thread
+ *
+ * @param ring
+ */
+void Codec_Trace_setRing(Codec_TraceRing* ring) {
+    traceRing = ring;
+}
+/**
+ * @brief return trace ring of current thread
+ *
+ * @return Codec_TraceRing*
+ */
+Codec_TraceRing* Codec_Trace_ring(void) {
+    return traceRing;
+}
+/**
+ * @brief set clock of trace, without clock records numbered in order
+ *
+ * @param fn
+ */
+void Codec_Trace_setClock(Codec_TraceClockFn fn) {
+    traceClock = fn;
+}
+/**
+ * @brief add a record into ring of current thread, called by codec hooks
+ *
+ * @param codec
+ * @param event
+ * @param layer
+ * @param phase
+ * @param value
+ */
+void Codec_Trace_record(const Codec* codec, Codec_TraceEvent event, const Codec_LayerImpl* layer, Codec_Phase phase, uint32_t value) {
+    Codec_TraceRing* ring = traceRing;
+    Codec_TraceRecord* record;
+    uint32_t head;
+
+    if (ring == NULL) {
+        return;
+    }
+    head = ring->Head;
+    record = &ring->Records[__traceIndex(head)];
+    record->Time = traceClock != NULL ? traceClock() : (Codec_Tick) head;
+    record->Codec = codec;
+    record->Layer = layer;
+    record->Value = value;
+    record->Event = (uint8_t) event;
+    record->Phase = (uint8_t) phase;
+    // publish record to reader
+    __traceStore(&ring->Head, head + 1);
+}
+/**
+ * @brief return number of records that exists in ring
+ *
+ * @param ring
+ * @return uint32_t
+ */
+uint32_t Codec_Trace_len(const Codec_TraceRing* ring) {
+    uint32_t head = __traceLoad(&ring->Head);
+    return head < CODEC_TRACE_SIZE ? head : CODEC_TRACE_SIZE;
+}
+/**
+ * @brief return a record of ring, index 0 is oldest record
+ *
+ * @param ring
+ * @param index
+ * @return const Codec_TraceRecord* NULL if index is out of range
+ */
+const Codec_TraceRecord* Codec_Trace_get(const Codec_TraceRing* ring, uint32_t index) {
+    uint32_t head = __traceLoad(&ring->Head);
+    uint32_t len = head < CODEC_TRACE_SIZE ? head : CODEC_TRACE_SIZE;
+
+    if (index >= len) {
+        return NULL;
+    }
+    return &ring->Records[__traceIndex(head - len + index)];
+}
+/**
+ * @brief format a record in trace-event format
+ *
+ * @param buff
+ * @param size
+ * @param ring
+ * @param record
+ * @param ticksPerUs
+ * @return int length of formatted record
+ */
+static int Codec_Trace_format(char* buff, int size, const Codec_TraceRing* ring, const Codec_TraceRecord* record, uint32_t ticksPerUs) {
+    static const char* const PH[] = { "B", "E", "i", "i" };
+    static const char* const ARG[] = { "lock", "len", "skip", "error" };
+    unsigned long long ts = (unsigned long long) record->Time;
+    const char* name = record->Event == Codec_TraceEvent_Sync ? "sync" :
+                       record->Event == Codec_TraceEvent_Error ? "error" : "layer";
+
+    return snprintf(buff, (size_t) size,
+        "{\"name\":\"%s %p\",\"cat\":\"%s\",\"ph\":\"%s\",%s\"ts\":%llu.%03llu,\"pid\":1,\"tid\":%lu,"
+        "\"args\":{\"codec\":\"%p\",\"%s\":%lu}}",
+        name, (const void*) record->Layer, TRACE_PHASES[record->Phase & 1], PH[record->Event & 3],
+        record->Event >= Codec_TraceEvent_Sync ? "\"s\":\"t\"," : "",
+        ts / ticksPerUs, (ts % ticksPerUs) * 1000 / ticksPerUs, (unsigned long) ring->Id,
+        (const void*) record->Codec, ARG[record->Event & 3], (unsigned long) record->Value);
+}
+/**
+ * @brief dump records of rings in Chrome trace-event JSON format,
+ * output can open in chrome://tracing or Perfetto, dump rings when their threads are paused
+ * otherwise oldest records may be overwritten while dumped
+ *
+ * @param rings
+ * @param count number of rings
+ * @param ticksPerUs number of clock ticks in a microsecond
+ * @param fn write function
+ * @param args arguments of write function
+ */
+void Codec_Trace_dump(Codec_TraceRing* const rings[], uint16_t count, uint32_t ticksPerUs, Codec_TraceWriteFn fn, void* args) {
+    const Codec_TraceRecord* record;
+    char buff[256];
+    uint32_t len;
+    uint32_t i;
+    uint16_t r;
+    uint8_t first = 1;
+    int n;
+
+    if (ticksPerUs == 0) {
+        ticksPerUs = 1;
+    }
+    fn(args, "{\"traceEvents\":[", 16);
+    for (r = 0; r < count; r++) {
+        len = Codec_Trace_len(rings[r]);
+        for (i = 0; i < len; i++) {
+            if ((record = Codec_Trace_get(rings[r], i)) == NULL) {
+                break;
+            }
+            if (!first) {
+                fn(args, ",\n", 2);
+            }
+            first = 0;
+            n = Codec_Trace_format(buff, sizeof(buff), rings[r], record, ticksPerUs);
+            if (n > 0) {
+                fn(args, buff, n < (int) sizeof(buff) ? (uint32_t) n : (uint32_t) sizeof(buff) - 1);
+            }
+        }
+    }
+    fn(args, "]}\n", 3);
+}
+
+#endif // CODEC_TRACE
@@ -0,0 +1,91 @@
+/**
+ * @file CodecTrace.h
+ * @author Ali Mirghasemi (ali.mirghasemi1376@gmail.com)
+ * @brief this library record layer events of codec (enter/exit, lock length, sync skip, error)
+ * into per-thread trace rings and dump them in Chrome trace-event JSON format
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _CODEC_TRACE_H_
+#define _CODEC_TRACE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "Codec.h"
+
+#if CODEC_TRACE
+
+/**
+ * @brief thread local storage class, rings are per-thread so writers never share a ring
+ */
+#ifndef CODEC_TRACE_THREAD_LOCAL
+    #if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_THREADS__)
+        #define CODEC_TRACE_THREAD_LOCAL    _Thread_local
+    #elif defined(__GNUC__) || defined(__clang__)
+        #define CODEC_TRACE_THREAD_LOCAL    __thread
+    #elif defined(_MSC_VER)
+        #define CODEC_TRACE_THREAD_LOCAL    __declspec(thread)
+    #else
+        // single thread targets
+        #define CODEC_TRACE_THREAD_LOCAL
+    #endif
+#endif
+
+/**
+ * @brief trace events
+ */
+typedef enum {
+    Codec_TraceEvent_Enter          = 0,    /**< layer begin, value is lock length */
+    Codec_TraceEvent_Exit           = 1,    /**< layer end, value is bytes of layer, 0 on error */
+    Codec_TraceEvent_Sync           = 2,    /**< sync or resync skip, value is skipped bytes */
+    Codec_TraceEvent_Error          = 3,    /**< layer failed, value is error code */
+} Codec_TraceEvent;
+/**
+ * @brief hold a trace record
+ */
+typedef struct {
+    Codec_Tick              Time;
+    const Codec*            Codec;
+    const Codec_LayerImpl*  Layer;
+    uint32_t                Value;
+    uint8_t                 Event;
+    uint8_t                 Phase;
+} Codec_TraceRecord;
+/**
+ * @brief ring of trace records of a thread, old records overwritten when ring is full
+ */
+typedef struct {
+    Codec_TraceRecord       Records[CODEC_TRACE_SIZE];
+    volatile uint32_t       Head;           /**< number of records written, written only by owner thread */
+    uint32_t                Id;             /**< thread id in trace */
+} Codec_TraceRing;
+/**
+ * @brief this function return current time of trace in ticks
+ */
+typedef Codec_Tick (*Codec_TraceClockFn)(void);
+/**
+ * @brief this function write a part of dumped trace
+ */
+typedef void (*Codec_TraceWriteFn)(void* args, const char* str, uint32_t len);
+
+void Codec_Trace_initRing(Codec_TraceRing* ring, uint32_t id);
+void Codec_Trace_setRing(Codec_TraceRing* ring);
+Codec_TraceRing* Codec_Trace_ring(void);
+void Codec_Trace_setClock(Codec_TraceClockFn fn);
+void Codec_Trace_record(const Codec* codec, Codec_TraceEvent event, const Codec_LayerImpl* layer, Codec_Phase phase, uint32_t value);
+uint32_t Codec_Trace_len(const Codec_TraceRing* ring);
+const Codec_TraceRecord* Codec_Trace_get(const Codec_TraceRing* ring, uint32_t index);
+void Codec_Trace_dump(Codec_TraceRing* const rings[], uint16_t count, uint32_t ticksPerUs, Codec_TraceWriteFn fn, void* args);
+
+#endif // CODEC_TRACE
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* _CODEC_TRACE_H_ */
@@ -31,6 +31,117 @@
  * @brief This feature enable helper macros for codec library and need `Macro` library
  */
 //#define CODEC_SUPPORT_MACRO                     1
+/**
+ * @brief enable fixed length and fixed next layer fields of layers,
+ * decode/encode loops read them instead of call getLen/nextLayer of layer
+ */
+//#define CODEC_LAYER_FIXED                       1
+/**
+ * @brief enable compile of layer chain, fixed lengths and next layers of chain
+ * are flattened into a table once, require CODEC_LAYER_FIXED,
+ * table hold same values as FixedLen/FixedNext of layers, it only help when layer descriptors
+ * are slow to reach, ex: spread over flash with wait states, or long chains that walk
+ * many descriptors, when descriptors are in cache it walk as fast as fixed fields and add
+ * a chain check to codecs that not compiled, compare "frameSize" rows of Codec-Bench
+ */
+//#define CODEC_COMPILE                           0
+/**
+ * @brief enable shared protocol and per-connection state, one read-only Codec_Protocol
+ * serve many connections and each connection keep only indexes of its current layers,
+ * connections can't count into stats of shared codec, so it's disabled with CODEC_STATS
+ */
+//#define CODEC_PROTOCOL                          1
+/**
+ * @brief enable full-duplex layout of codec, decode and encode fields are placed in separate
+ * cache lines and each side has its own flags and statistics, so a thread can decode
+ * while another thread encode on same codec without false sharing
+ */
+//#define CODEC_FULL_DUPLEX                       0
+
+/* Codec Full-Duplex Options */
+/**
+ * @brief cache line size of target in bytes
+ */
+//#define CODEC_CACHE_LINE                    64
+/**
+ * @brief alignment specifier that start a new cache line, placed before a struct member
+ */
+//#define CODEC_CACHE_ALIGN                   __attribute__((aligned(CODEC_CACHE_LINE)))
+
+/**
+ * @brief enable file descriptor streams, streams filled with readv and drained with writev,
+ * only on posix platforms
+ */
+//#define CODEC_FD_STREAM                         1
+/**
+ * @brief enable epoll reactor that drive many connections with fd streams, only on Linux,
+ * require CODEC_DECODE_ASYNC
+ */
+//#define CODEC_REACTOR                           1
+/**
+ * @brief enable memory-mapped file input streams and frame index of capture files,
+ * only on posix platforms
+ */
+//#define CODEC_MMAP                              1
+/**
+ * @brief enable parallel decode of mapped files with posix threads
+ */
+//#define CODEC_PARALLEL                          1
+
+/* Codec Mmap Options */
+/**
+ * @brief bytes of mapping that kernel asked to read ahead of stream window
+ */
+//#define CODEC_MMAP_READAHEAD                (4UL * 1024UL * 1024UL)
+/**
+ * @brief max number of worker threads of a parallel decode
+ */
+//#define CODEC_PARALLEL_MAX_WORKERS          64
+
+/**
+ * @brief enable CRC32C checksum functions and PacketCrc frame
+ */
+//#define CODEC_CRC                               1
+
+/* Codec CRC Options */
+/**
+ * @brief use checksum instructions of cpu, SSE4.2 crc32 and PCLMUL on x86-64 detected at runtime,
+ * CRC extension on ARM when compiler target it, otherwise slice-by-8 tables
+ */
+//#define CODEC_CRC_HW                        1
+
+/**
+ * @brief enable running checksum of codec, bytes of each layer added into checksum when layer
+ * committed, so footer layers can verify or write it without read frame again
+ */
+//#define CODEC_CHECKSUM                          0
+/**
+ * @brief enable statistics counters of codec, frames, bytes, skipped bytes, pending returns
+ * and errors per layer and per error code, disabled by default because it cost on each layer
+ */
+//#define CODEC_STATS                             0
+
+/* Codec Stats Options */
+/**
+ * @brief max number of layers that have separate error counters
+ */
+//#define CODEC_STATS_LAYERS                  8
+/**
+ * @brief max number of error codes that have separate counters
+ */
+//#define CODEC_STATS_ERRORS                  8
+
+/**
+ * @brief enable trace hooks of codec, layer enter/exit, lock length, sync skip and errors
+ * recorded into per-thread trace rings, hooks compile to nothing when disabled
+ */
+//#define CODEC_TRACE                             0
+
+/* Codec Trace Options */
+/**
+ * @brief number of records of each trace ring, must be power of two
+ */
+//#define CODEC_TRACE_SIZE                    1024
 
 /* Codec Encode Options */
 /**
@@ -43,9 +154,19 @@
  */
 //#define CODEC_ENCODE_ASYNC                  1
 /**
- * @brief enable queue for encode async feature, !*this feature is not working yet*!
+ * @brief enable queue for encode async feature, lock-free single-producer/single-consumer
+ * queue of frames that Codec_encode drain into output stream, require CODEC_ENCODE_ASYNC
  */
 //#define CODEC_ENCODE_QUEUE                  1
+/**
+ * @brief enable scatter-gather encode, frame encoded into list of vectors,
+ * layers can reference their payload instead of copy it
+ */
+//#define CODEC_ENCODE_GATHER                 1
+/**
+ * @brief enable writev/sendmsg sink for scatter-gather encode, only on posix platforms
+ */
+//#define CODEC_ENCODE_GATHER_POSIX           1
 /**
  * @brief enable callback feature for when encode completed
  */
@@ -74,13 +195,47 @@
  */
 //#define CODEC_DECODE_ASYNC                  1
 /**
- * @brief enable queue for decode async feature, !*this feature is not working yet*!
+ * @brief enable chunk parse for layers that implement parseChunk,
+ * in async decode layer parsed as bytes received, so layer can be bigger than stream buffer
+ */
+//#define CODEC_DECODE_CHUNK                  1
+/**
+ * @brief enable view mode for decode, layers can keep view of bytes in stream buffer
+ * instead of copy them, frame bytes released after onDecode returned
+ */
+//#define CODEC_DECODE_VIEW                   1
+/**
+ * @brief enable batch decode, decode multiple complete frames into caller frame slots in single call
+ */
+//#define CODEC_DECODE_BATCH                  1
+/**
+ * @brief enable queue for decode async feature, decoded frames published through
+ * lock-free single-producer/single-consumer ring of frame slots, require CODEC_DECODE_ASYNC
  */
 //#define CODEC_DECODE_QUEUE                  1
 /**
  * @brief enable sync options for decode
  */
 //#define CODEC_DECODE_SYNC                   1
+/**
+ * @brief enable decode latency histogram, time from first byte of frame (after sync)
+ * until onDecode measured with user clock, disabled by default
+ */
+//#define CODEC_DECODE_LATENCY                0
+/**
+ * @brief number of latency histogram buckets, each power of two split into 4 buckets,
+ * bigger values counted in last bucket, 120 buckets cover 32-bit ticks
+ */
+//#define CODEC_DECODE_LATENCY_BUCKETS        120
+/**
+ * @brief enable SIMD instructions (SSE2/AVX2/NEON) in pattern scanner when target support them
+ */
+//#define CODEC_SCAN_SIMD                     1
+/**
+ * @brief enable resync options for decode,
+ * when a layer parse failed codec jump to next frame candidate instead of ignore one byte
+ */
+//#define CODEC_DECODE_RESYNC                 1
 /**
  * @brief enable callback feature for when decode completed
  */
@@ -89,6 +244,11 @@
  * @brief enable decode error callback
  */
 //#define CODEC_DECODE_ERROR                  1
+/**
+ * @brief enable decode filter callback, it's called after parse of each layer
+ * and can skip rest of frame without parse it or abort frame
+ */
+//#define CODEC_DECODE_FILTER                 1
 /**
  * @brief enable decode padding for keep layer size fixed
  */
@@ -109,5 +269,15 @@
  */
 //#define CODEC_LAYER_INDEX
 //typedef uint16_t Codec_LayerIndex;
+/**
+ * @brief choose what type use for codec statistics counters
+ */
+//#define CODEC_STATS_COUNTER
+//typedef uint32_t Codec_StatsCounter;
+/**
+ * @brief choose what type use for clock ticks of decode latency
+ */
+//#define CODEC_TICK
+//typedef uint32_t Codec_Tick;
 
 #endif // _CODEC_USER_CONFIG_H_
@@ -3,6 +3,9 @@
 #if CODEC_DECODE
 static Codec_Error      BasicFrame_Header_parse(Codec* codec, Codec_Frame* frame, StreamIn* stream);
 static Codec_Error      BasicFrame_Data_parse(Codec* codec, Codec_Frame* frame, StreamIn* stream);
+#if CODEC_DECODE_CHUNK
+static Codec_Error      BasicFrame_Data_parseChunk(Codec* codec, Codec_Frame* frame, StreamIn* stream, Stream_LenType offset, Stream_LenType remaining);
+#endif
 #endif // CODEC_DECODE
 
 #if CODEC_ENCODE
@@ -15,26 +18,39 @@ static Codec_LayerImpl* BasicFrame_Header_nextLayer(Codec* codec, Codec_Frame* f
 
 static Stream_LenType   BasicFrame_Data_getLen(Codec* codec, Codec_Frame* frame, Codec_Phase phase);
 
-static const Codec_LayerImpl BASIC_FRAME_HEADER_IMPL = {
+// data layer defined first, so header can refer to it as fixed next layer
+static const Codec_LayerImpl BASIC_FRAME_DATA_IMPL = {
 #if CODEC_DECODE
-    .parse = BasicFrame_Header_parse,
+    .parse = BasicFrame_Data_parse,
 #endif
 #if CODEC_ENCODE
-    .write = BasicFrame_Header_write,
+    .write = BasicFrame_Data_write,
+#endif
+    .getLen = BasicFrame_Data_getLen,
+    .nextLayer = Codec_endLayer,
+#if CODEC_DECODE && CODEC_DECODE_CHUNK
+    .parseChunk = BasicFrame_Data_parseChunk,
+#endif
+#if CODEC_LAYER_FIXED
+    .Flags = CODEC_LAYER_FIXED_NEXT,
+    .FixedNext = CODEC_LAYER_NULL,
 #endif
-    .getLen = BasicFrame_Header_getLen,
-    .nextLayer = BasicFrame_Header_nextLayer,
 };
 
-static const Codec_LayerImpl BASIC_FRAME_DATA_IMPL = {
+static const Codec_LayerImpl BASIC_FRAME_HEADER_IMPL = {
 #if CODEC_DECODE
-    .parse = BasicFrame_Data_parse,
+    .parse = BasicFrame_Header_parse,
 #endif
 #if CODEC_ENCODE
-    .write = BasicFrame_Data_write,
+    .write = BasicFrame_Header_write,
+#endif
+    .getLen = BasicFrame_Header_getLen,
+    .nextLayer = BasicFrame_Header_nextLayer,
+#if CODEC_LAYER_FIXED
+    .Flags = CODEC_LAYER_STATIC,
+    .FixedLen = sizeof(BasicFrame_Header),
+    .FixedNext = (Codec_LayerImpl*) &BASIC_FRAME_DATA_IMPL,
 #endif
-    .getLen = BasicFrame_Data_getLen,
-    .nextLayer = Codec_endLayer,
 };
 
 /**
@@ -88,9 +104,33 @@ Codec_Error BasicFrame_Header_parse(Codec* codec, Codec_Frame* frame, StreamIn*
  */
 Codec_Error BasicFrame_Data_parse(Codec* codec, Codec_Frame* frame, StreamIn* stream) {
     BasicFrame* bFrame = (BasicFrame*) frame;
+#if CODEC_DECODE_VIEW
+    if (Codec_isDecodeView(codec)) {
+        Codec_view(&bFrame->Data.View, stream, bFrame->Header.PacketSize);
+        IStream_ignore(stream, bFrame->Header.PacketSize);
+        return CODEC_OK;
+    }
+#endif
     IStream_readBytes(stream, bFrame->Data.Data, bFrame->Header.PacketSize);
     return CODEC_OK;
 }
+#if CODEC_DECODE_CHUNK
+/**
+ * @brief data parse chunk function
+ *
+ * @param codec
+ * @param frame
+ * @param stream
+ * @param offset
+ * @param remaining
+ * @return Codec_Error
+ */
+Codec_Error BasicFrame_Data_parseChunk(Codec* codec, Codec_Frame* frame, StreamIn* stream, Stream_LenType offset, Stream_LenType remaining) {
+    BasicFrame* bFrame = (BasicFrame*) frame;
+    IStream_readBytes(stream, bFrame->Data.Data + offset, IStream_available(stream));
+    return CODEC_OK;
+}
+#endif // CODEC_DECODE_CHUNK
 #endif // CODEC_DECODE
 #if CODEC_ENCODE
 /**
@@ -115,8 +155,12 @@ Codec_Error BasicFrame_Header_write(Codec* codec, Codec_Frame* frame, StreamOut*
  */
 Codec_Error BasicFrame_Data_write(Codec* codec, Codec_Frame* frame, StreamOut* stream) {
     BasicFrame* bFrame = (BasicFrame*) frame;
+#if CODEC_ENCODE_GATHER
+    return Codec_writeRef(codec, stream, bFrame->Data.Data, bFrame->Header.PacketSize);
+#else
     OStream_writeBytes(stream, bFrame->Data.Data, bFrame->Header.PacketSize);
     return CODEC_OK;
+#endif
 }
 #endif // CODEC_ENCODE
 /**
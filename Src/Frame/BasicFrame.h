@@ -26,6 +26,9 @@ typedef struct {
 
 typedef struct {
     uint8_t*            Data;
+#if CODEC_DECODE && CODEC_DECODE_VIEW
+    Codec_View          View;       /**< data view in stream buffer, used in decode view mode */
+#endif
 } BasicFame_Data;
 
 typedef struct {
@@ -1,4 +1,6 @@
 #include "Packet.h"
+#include "../CodecScan.h"
+#include <string.h>
 
 #ifndef NULL
     #define NULL          ((void*) 0)
@@ -18,6 +20,9 @@ static const uint32_t   __PACKET_FOOTER_SIGN    = PACKET_FOOTER_SIGN;
 static Codec_Error      Packet_Header_parse(Codec* codec, Codec_Frame* frame, StreamIn* stream);
 static Codec_Error      Packet_Data_parse(Codec* codec, Codec_Frame* frame, StreamIn* stream);
 static Codec_Error      Packet_Footer_parse(Codec* codec, Codec_Frame* frame, StreamIn* stream);
+#if CODEC_DECODE_CHUNK
+static Codec_Error      Packet_Data_parseChunk(Codec* codec, Codec_Frame* frame, StreamIn* stream, Stream_LenType offset, Stream_LenType remaining);
+#endif
 #endif // CODEC_DECODE
 
 #if CODEC_ENCODE
@@ -35,15 +40,24 @@ static Codec_LayerImpl* Packet_Data_getUpperLayer(Codec* codec, Codec_Frame* fra
 static Stream_LenType   Packet_Footer_getLen(Codec* codec, Codec_Frame* frame, Codec_Phase phase);
 static Codec_LayerImpl* Packet_Footer_getUpperLayer(Codec* codec, Codec_Frame* frame, Codec_Phase phase);
 
-static const Codec_LayerImpl PACKET_HEADER_IMPL = {
+// layers defined in reverse order, so each layer can refer to its fixed next layer
+static const Codec_LayerImpl PACKET_FOOTER_IMPL = {
 #if CODEC_DECODE
-    Packet_Header_parse,
-#endif 
+    Packet_Footer_parse,
+#endif
 #if CODEC_ENCODE
-    Packet_Header_write,
+    Packet_Footer_write,
+#endif
+    Packet_Footer_getLen,
+    Packet_Footer_getUpperLayer,
+#if CODEC_DECODE && CODEC_DECODE_CHUNK
+    NULL,
+#endif
+#if CODEC_LAYER_FIXED
+    CODEC_LAYER_STATIC,
+    PACKET_FOOTER_SIZE,
+    CODEC_LAYER_NULL,
 #endif
-    Packet_Header_getLen,
-    Packet_Header_getUpperLayer,
 };
 
 static const Codec_LayerImpl PACKET_DATA_IMPL = {
@@ -55,17 +69,33 @@ static const Codec_LayerImpl PACKET_DATA_IMPL = {
 #endif
     Packet_Data_getLen,
     Packet_Data_getUpperLayer,
+#if CODEC_DECODE && CODEC_DECODE_CHUNK
+    Packet_Data_parseChunk,
+#endif
+#if CODEC_LAYER_FIXED
+    CODEC_LAYER_FIXED_NEXT,
+    0,
+    (Codec_LayerImpl*) &PACKET_FOOTER_IMPL,
+#endif
 };
 
-static const Codec_LayerImpl PACKET_FOOTER_IMPL = {
+static const Codec_LayerImpl PACKET_HEADER_IMPL = {
 #if CODEC_DECODE
-    Packet_Footer_parse,
-#endif
+    Packet_Header_parse,
+#endif 
 #if CODEC_ENCODE
-    Packet_Footer_write,
+    Packet_Header_write,
+#endif
+    Packet_Header_getLen,
+    Packet_Header_getUpperLayer,
+#if CODEC_DECODE && CODEC_DECODE_CHUNK
+    NULL,
+#endif
+#if CODEC_LAYER_FIXED
+    CODEC_LAYER_STATIC,
+    PACKET_HEADER_SIZE,
+    (Codec_LayerImpl*) &PACKET_DATA_IMPL,
 #endif
-    Packet_Footer_getLen,
-    Packet_Footer_getUpperLayer,
 };
 
 void Packet_init(Packet* frame, uint8_t* data, uint32_t size) {
@@ -81,8 +111,20 @@ Codec_LayerImpl* Packet_baseLayer(void) {
 }
 
 Stream_LenType Packet_sync(Codec* codec, StreamIn* stream) {
-    __setByteOrder(stream);
-    return IStream_findUInt16(stream, __PACKET_FIRST_SIGN);
+    uint8_t sign[sizeof(__PACKET_FIRST_SIGN)];
+#if STREAM_BYTE_ORDER
+    if (PACKET_BYTE_ORDER == ByteOrder_BigEndian) {
+        sign[0] = (uint8_t) (__PACKET_FIRST_SIGN >> 8);
+        sign[1] = (uint8_t) __PACKET_FIRST_SIGN;
+    }
+    else {
+        sign[0] = (uint8_t) __PACKET_FIRST_SIGN;
+        sign[1] = (uint8_t) (__PACKET_FIRST_SIGN >> 8);
+    }
+#else
+    memcpy(sign, &__PACKET_FIRST_SIGN, sizeof(sign));
+#endif
+    return Codec_scanStream(stream, sign, sizeof(sign));
 }
 
 #if CODEC_DECODE
@@ -107,12 +149,29 @@ static Codec_Error Packet_Data_parse(Codec* codec, Codec_Frame* frame, StreamIn*
     if (IStream_available(stream) < (Stream_LenType) p->Len) {
         return (Codec_Error) Packet_Error_Data;
     }
+#if CODEC_DECODE_VIEW
+    if (Codec_isDecodeView(codec)) {
+        Codec_view(&p->View, stream, p->Len);
+        IStream_ignore(stream, p->Len);
+        return CODEC_OK;
+    }
+#endif
     if (p->Data == NULL) {
         return (Codec_Error) Packet_Error_DataPtr;
     }
     IStream_readBytes(stream, p->Data, p->Len);
     return CODEC_OK;
 }
+#if CODEC_DECODE_CHUNK
+static Codec_Error Packet_Data_parseChunk(Codec* codec, Codec_Frame* frame, StreamIn* stream, Stream_LenType offset, Stream_LenType remaining) {
+    Packet* p = (Packet*) frame;
+    if (p->Data == NULL) {
+        return (Codec_Error) Packet_Error_DataPtr;
+    }
+    IStream_readBytes(stream, p->Data + offset, IStream_available(stream));
+    return CODEC_OK;
+}
+#endif // CODEC_DECODE_CHUNK
 static Codec_Error Packet_Footer_parse(Codec* codec, Codec_Frame* frame, StreamIn* stream) {
     __setByteOrder(stream);
     if (IStream_readUInt32(stream) != __PACKET_FOOTER_SIGN) {
@@ -137,8 +196,12 @@ static Codec_Error Packet_Data_write(Codec* codec, Codec_Frame* frame, StreamOut
     if (p->Data == NULL) {
         return (Codec_Error) Packet_Error_DataPtr;
     }
+#if CODEC_ENCODE_GATHER
+    return Codec_writeRef(codec, stream, p->Data, p->Len);
+#else
     OStream_writeBytes(stream, p->Data, p->Len);
     return CODEC_OK;
+#endif
 }
 static Codec_Error Packet_Footer_write(Codec* codec, Codec_Frame* frame, StreamOut* stream) {
     __setByteOrder(stream);
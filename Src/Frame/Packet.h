@@ -70,7 +70,10 @@ typedef enum {
 typedef struct {
     uint8_t*        Data;
     uint32_t        Len;
-    uint32_t        Size;
+    uint32_t        Size;           /**< size of data buffer, in decode view mode max accepted payload length */
+#if CODEC_DECODE && CODEC_DECODE_VIEW
+    Codec_View      View;           /**< payload view in stream buffer, used in decode view mode */
+#endif
 } Packet;
 
 void Packet_init(Packet* frame, uint8_t* data, uint32_t size);
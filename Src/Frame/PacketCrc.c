@@ -0,0 +1,240 @@
+#include "PacketCrc.h"
+#include "../CodecScan.h"
+
+#if CODEC_CRC
+
+#ifndef NULL
+    #define NULL          ((void*) 0)
+#endif
+
+#if CODEC_DECODE
+static Codec_Error      PacketCrc_Header_parse(Codec* codec, Codec_Frame* frame, StreamIn* stream);
+static Codec_Error      PacketCrc_Data_parse(Codec* codec, Codec_Frame* frame, StreamIn* stream);
+static Codec_Error      PacketCrc_Footer_parse(Codec* codec, Codec_Frame* frame, StreamIn* stream);
+#if CODEC_DECODE_CHUNK
+static Codec_Error      PacketCrc_Data_parseChunk(Codec* codec, Codec_Frame* frame, StreamIn* stream, Stream_LenType offset, Stream_LenType remaining);
+#endif
+#endif // CODEC_DECODE
+
+#if CODEC_ENCODE
+static Codec_Error      PacketCrc_Header_write(Codec* codec, Codec_Frame* frame, StreamOut* stream);
+static Codec_Error      PacketCrc_Data_write(Codec* codec, Codec_Frame* frame, StreamOut* stream);
+static Codec_Error      PacketCrc_Footer_write(Codec* codec, Codec_Frame* frame, StreamOut* stream);
+#endif // CODEC_ENCODE
+
+static Stream_LenType   PacketCrc_Header_getLen(Codec* codec, Codec_Frame* frame, Codec_Phase phase);
+static Codec_LayerImpl* PacketCrc_Header_getUpperLayer(Codec* codec, Codec_Frame* frame, Codec_Phase phase);
+
+static Stream_LenType   PacketCrc_Data_getLen(Codec* codec, Codec_Frame* frame, Codec_Phase phase);
+static Codec_LayerImpl* PacketCrc_Data_getUpperLayer(Codec* codec, Codec_Frame* frame, Codec_Phase phase);
+
+static Stream_LenType   PacketCrc_Footer_getLen(Codec* codec, Codec_Frame* frame, Codec_Phase phase);
+static Codec_LayerImpl* PacketCrc_Footer_getUpperLayer(Codec* codec, Codec_Frame* frame, Codec_Phase phase);
+
+// layers defined in reverse order, so each layer can refer to its fixed next layer
+static const Codec_LayerImpl PACKET_CRC_FOOTER_IMPL = {
+#if CODEC_DECODE
+    PacketCrc_Footer_parse,
+#endif
+#if CODEC_ENCODE
+    PacketCrc_Footer_write,
+#endif
+    PacketCrc_Footer_getLen,
+    PacketCrc_Footer_getUpperLayer,
+#if CODEC_DECODE && CODEC_DECODE_CHUNK
+    NULL,
+#endif
+#if CODEC_LAYER_FIXED
+    CODEC_LAYER_STATIC,
+    PACKET_FOOTER_SIZE,
+    CODEC_LAYER_NULL,
+#endif
+};
+
+static const Codec_LayerImpl PACKET_CRC_DATA_IMPL = {
+#if CODEC_DECODE
+    PacketCrc_Data_parse,
+#endif
+#if CODEC_ENCODE
+    PacketCrc_Data_write,
+#endif
+    PacketCrc_Data_getLen,
+    PacketCrc_Data_getUpperLayer,
+#if CODEC_DECODE && CODEC_DECODE_CHUNK
+    PacketCrc_Data_parseChunk,
+#endif
+#if CODEC_LAYER_FIXED
+    CODEC_LAYER_FIXED_NEXT,
+    0,
+    (Codec_LayerImpl*) &PACKET_CRC_FOOTER_IMPL,
+#endif
+};
+
+static const Codec_LayerImpl PACKET_CRC_HEADER_IMPL = {
+#if CODEC_DECODE
+    PacketCrc_Header_parse,
+#endif
+#if CODEC_ENCODE
+    PacketCrc_Header_write,
+#endif
+    PacketCrc_Header_getLen,
+    PacketCrc_Header_getUpperLayer,
+#if CODEC_DECODE && CODEC_DECODE_CHUNK
+    NULL,
+#endif
+#if CODEC_LAYER_FIXED
+    CODEC_LAYER_STATIC,
+    PACKET_HEADER_SIZE,
+    (Codec_LayerImpl*) &PACKET_CRC_DATA_IMPL,
+#endif
+};
+
+/**
+ * @brief big endian helpers, header bytes are checksummed as they are on wire
+ */
+#define __getUInt16(P)          (((uint16_t) (P)[0] << 8) | (uint16_t) (P)[1])
+#define __getUInt32(P)          (((uint32_t) (P)[0] << 24) | ((uint32_t) (P)[1] << 16) | ((uint32_t) (P)[2] << 8) | (uint32_t) (P)[3])
+#define __setUInt16(P, V)       (P)[0] = (uint8_t) ((V) >> 8); (P)[1] = (uint8_t) (V)
+#define __setUInt32(P, V)       (P)[0] = (uint8_t) ((V) >> 24); (P)[1] = (uint8_t) ((V) >> 16); (P)[2] = (uint8_t) ((V) >> 8); (P)[3] = (uint8_t) (V)
+
+void PacketCrc_init(PacketCrc* frame, uint8_t* data, uint32_t size) {
+    frame->Data = data;
+    frame->Len = size;
+    frame->Size = size;
+    frame->Crc = CODEC_CRC32C_INIT;
+}
+uint32_t PacketCrc_len(PacketCrc* frame) {
+    return frame->Len + PACKET_HEADER_SIZE + PACKET_FOOTER_SIZE;
+}
+Codec_LayerImpl* PacketCrc_baseLayer(void) {
+    return (Codec_LayerImpl*) &PACKET_CRC_HEADER_IMPL;
+}
+
+Stream_LenType PacketCrc_sync(Codec* codec, StreamIn* stream) {
+    uint8_t sign[2];
+    __setUInt16(sign, PACKET_FIRST_SIGN);
+    return Codec_scanStream(stream, sign, sizeof(sign));
+}
+
+#if CODEC_DECODE
+
+static Codec_Error PacketCrc_Header_parse(Codec* codec, Codec_Frame* frame, StreamIn* stream) {
+    PacketCrc* p = (PacketCrc*) frame;
+    uint8_t header[PACKET_HEADER_SIZE];
+
+    p->Crc = CODEC_CRC32C_INIT;
+    Codec_crc32cRead(stream, header, sizeof(header), &p->Crc);
+    if (__getUInt16(&header[0]) != PACKET_FIRST_SIGN) {
+        return (Codec_Error) PacketCrc_Error_FirstSign;
+    }
+    p->Len = __getUInt32(&header[2]);
+    if (p->Len >= PACKET_MAX_SIZE || p->Len > p->Size) {
+        return (Codec_Error) PacketCrc_Error_PacketSize;
+    }
+    if (__getUInt16(&header[6]) != PACKET_SECOND_SIGN) {
+        return (Codec_Error) PacketCrc_Error_SecondSign;
+    }
+    return CODEC_OK;
+}
+static Codec_Error PacketCrc_Data_parse(Codec* codec, Codec_Frame* frame, StreamIn* stream) {
+    PacketCrc* p = (PacketCrc*) frame;
+    if (IStream_available(stream) < (Stream_LenType) p->Len) {
+        return (Codec_Error) PacketCrc_Error_Data;
+    }
+#if CODEC_DECODE_VIEW
+    if (Codec_isDecodeView(codec)) {
+        Codec_view(&p->View, stream, p->Len);
+        p->Crc = Codec_crc32cView(p->Crc, &p->View);
+        IStream_ignore(stream, p->Len);
+        return CODEC_OK;
+    }
+#endif
+    if (p->Data == NULL) {
+        return (Codec_Error) PacketCrc_Error_DataPtr;
+    }
+    return Codec_crc32cRead(stream, p->Data, p->Len, &p->Crc);
+}
+#if CODEC_DECODE_CHUNK
+static Codec_Error PacketCrc_Data_parseChunk(Codec* codec, Codec_Frame* frame, StreamIn* stream, Stream_LenType offset, Stream_LenType remaining) {
+    PacketCrc* p = (PacketCrc*) frame;
+    if (p->Data == NULL) {
+        return (Codec_Error) PacketCrc_Error_DataPtr;
+    }
+    // chunks come in order, so checksum continue from previous chunk
+    return Codec_crc32cRead(stream, p->Data + offset, IStream_available(stream), &p->Crc);
+}
+#endif // CODEC_DECODE_CHUNK
+static Codec_Error PacketCrc_Footer_parse(Codec* codec, Codec_Frame* frame, StreamIn* stream) {
+    PacketCrc* p = (PacketCrc*) frame;
+    uint8_t footer[PACKET_FOOTER_SIZE];
+
+    IStream_readBytes(stream, footer, sizeof(footer));
+    if (__getUInt32(footer) != p->Crc) {
+        return (Codec_Error) PacketCrc_Error_Crc;
+    }
+    return CODEC_OK;
+}
+#endif // CODEC_DECODE
+
+#if CODEC_ENCODE
+
+static Codec_Error PacketCrc_Header_write(Codec* codec, Codec_Frame* frame, StreamOut* stream) {
+    PacketCrc* p = (PacketCrc*) frame;
+    uint8_t header[PACKET_HEADER_SIZE];
+
+    __setUInt16(&header[0], PACKET_FIRST_SIGN);
+    __setUInt32(&header[2], p->Len);
+    __setUInt16(&header[6], PACKET_SECOND_SIGN);
+    p->Crc = CODEC_CRC32C_INIT;
+    return Codec_crc32cWrite(stream, header, sizeof(header), &p->Crc);
+}
+static Codec_Error PacketCrc_Data_write(Codec* codec, Codec_Frame* frame, StreamOut* stream) {
+    PacketCrc* p = (PacketCrc*) frame;
+    if (p->Data == NULL) {
+        return (Codec_Error) PacketCrc_Error_DataPtr;
+    }
+#if CODEC_ENCODE_GATHER
+    if (codec->TxGather != NULL) {
+        // payload referenced, so it's only read for checksum
+        p->Crc = Codec_crc32c(p->Crc, p->Data, p->Len);
+        return Codec_writeRef(codec, stream, p->Data, p->Len);
+    }
+#endif
+    // checksum computed while payload copied
+    return Codec_crc32cWrite(stream, p->Data, p->Len, &p->Crc);
+}
+static Codec_Error PacketCrc_Footer_write(Codec* codec, Codec_Frame* frame, StreamOut* stream) {
+    PacketCrc* p = (PacketCrc*) frame;
+    uint8_t footer[PACKET_FOOTER_SIZE];
+
+    __setUInt32(footer, p->Crc);
+    OStream_writeBytes(stream, footer, sizeof(footer));
+    return CODEC_OK;
+}
+
+#endif // CODEC_ENCODE
+
+
+static Stream_LenType PacketCrc_Header_getLen(Codec* codec, Codec_Frame* frame, Codec_Phase phase) {
+    return PACKET_HEADER_SIZE;
+}
+static Codec_LayerImpl* PacketCrc_Header_getUpperLayer(Codec* codec, Codec_Frame* frame, Codec_Phase phase) {
+    return (Codec_LayerImpl*) &PACKET_CRC_DATA_IMPL;
+}
+
+static Stream_LenType PacketCrc_Data_getLen(Codec* codec, Codec_Frame* frame, Codec_Phase phase) {
+    PacketCrc* p = (PacketCrc*) frame;
+    return p->Len;
+}
+static Codec_LayerImpl* PacketCrc_Data_getUpperLayer(Codec* codec, Codec_Frame* frame, Codec_Phase phase) {
+    return (Codec_LayerImpl*) &PACKET_CRC_FOOTER_IMPL;
+}
+
+static Stream_LenType PacketCrc_Footer_getLen(Codec* codec, Codec_Frame* frame, Codec_Phase phase) {
+    return PACKET_FOOTER_SIZE;
+}
+static Codec_LayerImpl* PacketCrc_Footer_getUpperLayer(Codec* codec, Codec_Frame* frame, Codec_Phase phase) {
+    return CODEC_LAYER_NULL;
+}
+
+#endif // CODEC_CRC
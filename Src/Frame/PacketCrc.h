@@ -0,0 +1,66 @@
+/**
+ * @file PacketCrc.h
+ * @author Ali Mirghasemi (ali.mirghasemi1376@gmail.com)
+ * @brief this library implement packet frame protected by CRC32C, header is same as Packet
+ * and footer carry CRC32C of header and data instead of constant sign
+ *            +------------------+---------------+------------------+
+ * PacketCrc: | HEADER (8x Byte) | DATA (N Byte) | FOOTER (4x Byte) |
+ *            +------------------+---------------+------------------+
+ *            +----------------------+-----------------------+-----------------------+
+ * Header:    | First Sign (2x Byte) | Packet Size (4x Byte) | Second Sign (2x Byte) |
+ *            +----------------------+-----------------------+-----------------------+
+ *            +-----------------------------------+
+ * Footer:    | CRC32C of HEADER + DATA (4x Byte) |
+ *            +-----------------------------------+
+ * all fields are big endian
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _PACKET_CRC_H_
+#define _PACKET_CRC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "Packet.h"
+#include "../CodecCrc.h"
+
+#if CODEC_CRC
+
+typedef enum {
+    PacketCrc_Error_FirstSign       = 1,
+    PacketCrc_Error_SecondSign      = 2,
+    PacketCrc_Error_PacketSize      = 3,
+    PacketCrc_Error_Crc             = 4,
+    PacketCrc_Error_Data            = 5,
+    PacketCrc_Error_DataPtr         = 6,
+} PacketCrc_Error;
+
+typedef struct {
+    uint8_t*        Data;
+    uint32_t        Len;
+    uint32_t        Size;           /**< size of data buffer, in decode view mode max accepted payload length */
+#if CODEC_DECODE && CODEC_DECODE_VIEW
+    Codec_View      View;           /**< payload view in stream buffer, used in decode view mode */
+#endif
+    uint32_t        Crc;            /**< running checksum while frame is decoding or encoding */
+} PacketCrc;
+
+void PacketCrc_init(PacketCrc* frame, uint8_t* data, uint32_t size);
+uint32_t PacketCrc_len(PacketCrc* frame);
+Codec_LayerImpl* PacketCrc_baseLayer(void);
+
+Stream_LenType PacketCrc_sync(Codec* codec, StreamIn* stream);
+
+#endif // CODEC_CRC
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* _PACKET_CRC_H_ */